@@ -6,7 +6,7 @@ add_external_lib(
         sdl/2.0.20
         REQUIRED
         INTERFACE_NAME SDL::SDL
-        PKG_CONFIG "sdl2 >= 2.0"
+        PKG_CONFIG "sdl2 >= 2.0.18"
 )
 add_external_lib(
         SDL2_image
@@ -1,6 +1,7 @@
 #include "Game.hxx"
 #include "engine/Engine.hxx"
 #include "engine/EventManager.hxx"
+#include "engine/ResourcesManager.hxx"
 #include "engine/UIManager.hxx"
 #include "engine/WindowManager.hxx"
 #include "engine/basics/Camera.hxx"
@@ -8,11 +9,20 @@
 #include "engine/ui/widgets/Image.hxx"
 #include "engine/basics/Settings.hxx"
 #include "engine/basics/GameStates.hxx"
+#include "engine/map/MapLayers.hxx"
+#include "engine/render/FramePipeline.hxx"
+#include "engine/render/FrameScheduler.hxx"
+#include "engine/render/SoftwareRasterizer.hxx"
+#include "engine/render/SpriteBatcher.hxx"
 #include "Filesystem.hxx"
 
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
 #ifdef USE_ANGELSCRIPT
 #include "Scripting/ScriptEngine.hxx"
 #endif
@@ -46,6 +56,12 @@ void Game::quit()
 
 bool Game::initialize()
 {
+  if (Settings::instance().headless)
+  {
+    // there might be no display, nothing is shown anyway
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+  }
+
   if (SDL_Init(SDL_INIT_VIDEO) != 0)
   {
     LOG(LOG_ERROR) << "Failed to Init SDL";
@@ -315,10 +331,47 @@ void Game::run(bool SkipMenu)
   }
 #endif // USE_AUDIO
 
+  if (Settings::instance().autosaveInterval > 0)
+  {
+    // clock tasks run in the simulation step, the map doesn't change while it's autosaved
+    const std::chrono::seconds autosaveInterval{Settings::instance().autosaveInterval};
+    gameClock.addRealTimeClockTask(
+        [&engine]()
+        {
+          engine.autoSaveGame("resources/autosave.cts");
+          return false;
+        },
+        autosaveInterval, autosaveInterval);
+  }
+
+  // size and distance to the screen border of the minimap in pixels
+  const int minimapSize = 192;
+  const int minimapMargin = 8;
+
   // FPS Counter variables
   const float fpsIntervall = 1.0; // interval the fps counter is refreshed in seconds.
   Uint32 fpsLastTime = SDL_GetTicks();
-  Uint32 fpsFrames = 0;
+
+  SDL_Renderer *renderer = WindowManager::instance().getRenderer();
+  FramePipeline framePipeline;
+  FrameScheduler frameScheduler;
+  SpriteBatcher frameBatcher;
+  SoftwareRasterizer softwareRasterizer;
+  bool drawUIDirectly = false;
+  // the first frame always has to be drawn
+  bool isRedrawNeeded = true;
+
+  frameScheduler.setTargetFPS(Settings::instance().targetFPS);
+  softwareRasterizer.addTextureAtlas(ResourcesManager::instance().getTileAtlas());
+
+  framePipeline.startSimulation(
+      [&gameClock, &m_GamePlay]()
+      {
+        // clock tasks change the map and the UI, e.g. by spawning buildings or showing tooltips
+        const bool hasCalledTask = gameClock.tick();
+        m_GamePlay.update();
+        return hasCalledTask;
+      });
 
   // GameLoop
   while (engine.isGameRunning())
@@ -326,42 +379,139 @@ void Game::run(bool SkipMenu)
 #ifdef MICROPROFILE_ENABLED
     MICROPROFILE_SCOPEI("Map", "Gameloop", MP_GREEN);
 #endif
-    SDL_RenderClear(WindowManager::instance().getRenderer());
+    frameScheduler.beginFrame();
+
+    // without a UI layer the UI can only be drawn while the world is locked, so the simulation has to be waited for
+    const bool isWorldLocked = framePipeline.lockWorld(drawUIDirectly);
+    bool isRendered = false;
+
+    if (isWorldLocked)
+    {
+      // a frame only looks different from the last one after input, a simulation step that ran a task or a map change
+      isRedrawNeeded = evManager.checkEvents(event, engine) || isRedrawNeeded;
+      isRedrawNeeded = framePipeline.takeSimulationChanges() || isRedrawNeeded;
+      isRedrawNeeded = (engine.map != nullptr && engine.map->hasPendingChanges()) || isRedrawNeeded;
+      SaveGameService::instance().dispatchCompletions();
+
+      if (isRedrawNeeded)
+      {
+        RenderSnapshot &snapshot = framePipeline.beginSnapshot();
+
+        // record the tileMap
+        if (engine.map != nullptr)
+        {
+          engine.map->renderMap(snapshot);
+        }
+
+        frameBatcher.begin(snapshot);
+        if (engine.map != nullptr && Settings::instance().showMinimap)
+        {
+          // the minimap shows the same layers as the map
+          Minimap &minimap = engine.map->getMinimap();
+          minimap.setLayers(MapLayers::getActiveLayers());
+          minimap.update(renderer);
+          minimap.draw(frameBatcher,
+                       {Settings::instance().screenWidth - minimapSize - minimapMargin, minimapMargin, minimapSize, minimapSize});
+        }
 
-    evManager.checkEvents(event, engine);
-    gameClock.tick();
+        // record the ui
+        // TODO: This is only temporary until the new UI is ready. Remove this afterwards
+        if (GameStates::instance().drawUI && !drawUIDirectly)
+        {
+          drawUIDirectly = !framePipeline.recordUI(renderer, frameBatcher, [&uiManager]() { uiManager.drawUI(); });
+        }
+        frameBatcher.end();
 
-    m_GamePlay.update();
+        framePipeline.publishSnapshot();
+        isRendered = true;
+        isRedrawNeeded = false;
+      }
+
+      if (fpsLastTime < SDL_GetTicks() - fpsIntervall * 1000)
+      {
+        fpsLastTime = SDL_GetTicks();
+        std::ostringstream fpsText;
+        fpsText << frameScheduler.getRenderedFrames() << " FPS";
+        if (frameScheduler.getSkippedFrames() > 0)
+        {
+          fpsText << " (" << frameScheduler.getSkippedFrames() << " unchanged frames skipped)";
+        }
+        if (engine.map != nullptr)
+        {
+          const BatchStats &renderStats = engine.map->getRenderStats();
+          fpsText << ", " << renderStats.drawCalls << " draw calls, " << renderStats.textureChanges << " texture changes, "
+                  << engine.map->getOccludedQuadCount() << " covered quads culled";
+        }
+        const FrameTimeStats &simulationTimes = framePipeline.getSimulationTimes();
+        const FrameTimeStats &renderTimes = frameScheduler.getFrameTimes();
+        fpsText << std::fixed << std::setprecision(1) << ", frame p50/p99: render " << renderTimes.percentile(50) << "/"
+                << renderTimes.percentile(99) << " ms, simulation " << simulationTimes.percentile(50) << "/"
+                << simulationTimes.percentile(99) << " ms";
+        if (frameScheduler.getFrameBudget() > 0)
+        {
+          fpsText << ", budget " << frameScheduler.getFrameBudget() << " ms, " << frameScheduler.getOverBudgetFrames()
+                  << " frames over budget";
+        }
+        uiManager.setFPSCounterText(fpsText.str());
+        frameScheduler.resetFrameCounts();
+        // the new text has to be shown
+        isRedrawNeeded = true;
+      }
 
-    // render the tileMap
-    if (engine.map != nullptr)
+      // the snapshot holds everything that's drawn from the world, the simulation can go on while it's submitted. Only
+      // the UI that is drawn directly still needs the world
+      if (!drawUIDirectly)
+      {
+        framePipeline.unlockWorld();
+      }
+    }
+    else
     {
-      engine.map->renderMap();
+      // the simulation is still busy, keep the window responsive. The last snapshot stays on screen
+      SDL_PumpEvents();
     }
 
-    // render the ui
-    // TODO: This is only temporary until the new UI is ready. Remove this afterwards
-    if (GameStates::instance().drawUI)
+    if (isRendered)
     {
-      uiManager.drawUI();
+      SDL_RenderClear(renderer);
+      if (Settings::instance().useSoftwareRasterizer())
+      {
+        framePipeline.submit(renderer, softwareRasterizer);
+      }
+      else
+      {
+        framePipeline.submit(renderer);
+      }
     }
 
-    // preset the game screen
-    WindowManager::instance().renderScreen();
-
-    fpsFrames++;
+    if (isWorldLocked && drawUIDirectly)
+    {
+      if (isRendered && GameStates::instance().drawUI)
+      {
+        uiManager.drawUI();
+      }
+      framePipeline.unlockWorld();
+    }
 
-    if (fpsLastTime < SDL_GetTicks() - fpsIntervall * 1000)
+    if (isRendered)
     {
-      fpsLastTime = SDL_GetTicks();
-      uiManager.setFPSCounterText(std::to_string(fpsFrames) + " FPS");
-      fpsFrames = 0;
+      // preset the game screen
+      WindowManager::instance().renderScreen();
     }
 
 #ifdef MICROPROFILE_ENABLED
     MicroProfileFlip(nullptr);
 #endif
+
+    // sleep until the next frame is due
+    frameScheduler.endFrame(isRendered);
   }
+
+  framePipeline.stopSimulation();
+
+  // don't quit before the last savegame is written
+  SaveGameService::instance().waitForSaves();
+  SaveGameService::instance().dispatchCompletions();
 }
 
 void Game::shutdown()
@@ -13,6 +13,7 @@
 #endif
 #include "services/Randomizer.hxx"
 #include "services/GameClock.hxx"
+#include "services/SaveGameService.hxx"
 #include "services/ResourceManager.hxx"
 #include "LOG.hxx"
 #include "Exception.hxx"
@@ -4,6 +4,9 @@
 #include "basics/mapEdit.hxx"
 #include "basics/Settings.hxx"
 #include "ResourcesManager.hxx"
+#include "Filesystem.hxx"
+#include "Exception.hxx"
+#include "LOG.hxx"
 
 Engine::Engine() {}
 
@@ -25,6 +28,9 @@ void Engine::toggleFullScreen() { WindowManager::instance().toggleFullScreen();
 
 void Engine::loadGame(const std::string &fileName)
 {
+  // the savegame might still be written
+  SaveGameService::instance().waitForSaves();
+
   Map *newMap = Map::loadMapFromFile(fileName);
 
   if (newMap)
@@ -32,13 +38,109 @@ void Engine::loadGame(const std::string &fileName)
     delete map;
     map = newMap;
     m_running = true;
+    // the journal belongs to the old map
+    m_journalSaveGame.clear();
+  }
+}
+
+void Engine::saveGame(const std::string &fileName, SaveGameFormat format, SaveGameService::Callback onCompletion)
+{
+  const std::string filePath = fs::getBasePath() + fileName;
+  if (filePath == m_journalSaveGame)
+  {
+    // the journal doesn't belong to the new savegame anymore
+    m_journalSaveGame.clear();
+  }
+
+  SaveGameService::instance().save(map->createSaveGameSnapshot(), filePath, format,
+                                   [fileName, onCompletion](const std::string &error)
+                                   {
+                                     if (error.empty())
+                                     {
+                                       LOG(LOG_INFO) << "Saved the game to " << fileName;
+                                     }
+                                     if (onCompletion)
+                                     {
+                                       onCompletion(error);
+                                     }
+                                   });
+}
+
+void Engine::autoSaveGame(const std::string &fileName)
+{
+  if (!map)
+  {
+    return;
+  }
+
+  const std::string filePath = fs::getBasePath() + fileName;
+  const std::string journalPath = SaveGameJournal::journalPath(filePath);
+  // after an autosave failed, the journal might not match the savegame anymore
+  const auto onCompletion = [this](const std::string &error)
+  {
+    if (!error.empty())
+    {
+      m_journalSaveGame.clear();
+    }
+  };
+
+  const size_t maxJournaledNodes = map->getNodeCount() / SaveGameJournal::compactionDivisor;
+  if (filePath == m_journalSaveGame && m_journaledNodes + map->getUnsavedNodeCount() <= maxJournaledNodes)
+  {
+    if (!map->hasUnsavedChanges())
+    {
+      return;
+    }
+
+    m_journaledNodes += map->getUnsavedNodeCount();
+    auto pBatch = std::make_shared<SaveGameJournal::Batch>(map->takeUnsavedChanges());
+    SaveGameService::instance().enqueue(
+        [pBatch, journalPath, pIsJournalStarted = m_pIsJournalStarted]()
+        {
+          // if the savegame failed, the journal on disk belongs to an older one that lacks the changes before the batch
+          if (!*pIsJournalStarted)
+          {
+            throw CytopiaError(TRACE_INFO "The journal " + journalPath + " hasn't been started");
+          }
+          SaveGameJournal::append(journalPath, *pBatch);
+        },
+        onCompletion);
+    return;
   }
+
+  // fold the journal into a new savegame. The journal is only replaced after the savegame has been written, a journal
+  // that doesn't match the savegame is ignored when it's loaded
+  auto pSnapshot = std::make_shared<SaveGameSnapshot>(map->createSaveGameSnapshot());
+  map->markChangesSaved();
+  m_journalSaveGame = filePath;
+  m_journaledNodes = 0;
+  // only the worker thread accesses it once the jobs are queued, the jobs run one after another
+  m_pIsJournalStarted = std::make_shared<bool>(false);
+
+  SaveGameService::instance().enqueue(
+      [pSnapshot, filePath, journalPath, pIsJournalStarted = m_pIsJournalStarted]()
+      {
+        pSnapshot->saveToFile(filePath, SaveGameFormat::BINARY);
+        const SaveGameJournal::Header header{SaveGameJournal::fileChecksum(filePath), pSnapshot->columns(),
+                                             pSnapshot->rows()};
+        SaveGameJournal::create(journalPath, header, pSnapshot->getTileIDs());
+        *pIsJournalStarted = true;
+      },
+      [fileName, onCompletion](const std::string &error)
+      {
+        if (error.empty())
+        {
+          LOG(LOG_INFO) << "Autosaved the game to " << fileName;
+        }
+        onCompletion(error);
+      });
 }
 
 void Engine::newGame()
 {
   delete map;
   m_running = true;
+  m_journalSaveGame.clear();
 
   const int mapSize = Settings::instance().mapSize;
 
@@ -3,9 +3,13 @@
 
 #include <SDL.h>
 
+#include <memory>
+#include <string>
+
 #include "WindowManager.hxx"
 #include "basics/point.hxx"
 #include "Map.hxx"
+#include "../services/SaveGameService.hxx"
 #include "../util/Singleton.hxx"
 
 class Engine : public Singleton<Engine>
@@ -56,7 +60,24 @@ public:
     */
   void loadGame(const std::string &fileName);
 
-  void saveGame(const std::string &fileName) const { map->saveMapToFile(fileName); };
+  /** @brief Saves the game in the background
+    * Takes a snapshot of the map and writes it on the worker thread of the SaveGameService.
+    * @param fileName FileName of the saved game
+    * @param format the file format, json is meant for exporting the map
+    * @param onCompletion called on the game thread once the savegame has been written or failed to
+    * @see Map#saveMapToFile
+    */
+  void saveGame(const std::string &fileName, SaveGameFormat format = SaveGameFormat::BINARY,
+                SaveGameService::Callback onCompletion = nullptr);
+
+  /** @brief Autosaves the game in the background
+    * Only the nodes that changed since the last autosave are appended to the SaveGameJournal of the savegame. The first
+    * autosave of a game, and every one after the journal has grown past a part of the map, folds the journal into a new
+    * savegame and starts an empty journal instead.
+    * @param fileName FileName of the saved game
+    * @see SaveGameJournal#compactionDivisor
+    */
+  void autoSaveGame(const std::string &fileName);
 
   /** @brief Creates a new game
     * Creates a new game
@@ -69,6 +90,12 @@ private:
   Engine();
   ~Engine();
   bool m_running = false;
+  /// full path of the savegame whose journal autosaves append to, empty if the next autosave has to save completely
+  std::string m_journalSaveGame;
+  /// number of nodes in the journal
+  size_t m_journaledNodes = 0;
+  /// set by the worker thread once the savegame and its empty journal have been written
+  std::shared_ptr<bool> m_pIsJournalStarted;
 };
 
 #endif
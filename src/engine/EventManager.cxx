@@ -31,7 +31,7 @@ void EventManager::unHighlightNodes()
   m_nodesToPlace.clear();
 }
 
-void EventManager::checkEvents(SDL_Event &event, Engine &engine)
+bool EventManager::checkEvents(SDL_Event &event, Engine &engine)
 {
 #ifdef MICROPROFILE_ENABLED
   MICROPROFILE_SCOPEI("EventManager", "checkEvents", MP_BEIGE);
@@ -39,9 +39,12 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
   // check for UI events first
   SDL_Point mouseScreenCoords;
   Point mouseIsoCoords{};
+  bool hasEvents = false;
 
   while (SDL_PollEvent(&event))
   {
+    hasEvents = true;
+
     switch (event.type)
     {
     case SDL_QUIT:
@@ -283,7 +286,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
         {
           if ((event.motion.xrel == 0) && (event.motion.yrel == 0))
           {
-            return;
+            return true;
           }
           Camera::instance().moveCameraX(event.motion.xrel);
           Camera::instance().moveCameraY(event.motion.yrel);
@@ -313,6 +316,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
             if (it != Point::INVALID())
             {
               (engine.map->getMapNode(it)).setNodeTransparency(0, Layer::BUILDINGS);
+              engine.map->invalidateNode(it);
             }
           }
           m_transparentBuildings.clear();
@@ -324,8 +328,9 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
           }
           else
           {
-            m_nodesToHighlight = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
             // get all node coordinates the tile we'll place occupies
+            const TileFootprint footprint = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
+            m_nodesToHighlight.assign(footprint.begin(), footprint.end());
 
             if (m_nodesToHighlight.empty() && mouseIsoCoords.isWithinMapBoundaries())
             {
@@ -362,8 +367,9 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
             m_nodesToPlace.push_back(mouseIsoCoords);
           }
           m_placementAllowed = false;
-          std::vector<Point> nodesToAdd;
-          TileData *tileToPlaceData = TileManager::instance().getTileData(tileToPlace);
+          m_nodesToAdd.clear();
+          const TileId tileToPlaceId = TileManager::instance().getTileId(tileToPlace);
+          const TileData *tileToPlaceData = TileManager::instance().getTileData(tileToPlaceId);
 
           // if we touch a bigger than 1x1 tile also add all nodes of the building to highlight.
           for (const auto &coords : m_nodesToHighlight)
@@ -376,22 +382,22 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
             }
             else
             {
-              layer = TileManager::instance().getTileLayer(tileToPlace);
+              layer = TileManager::instance().getTileLayer(tileToPlaceId);
             }
             Point currentOriginPoint = engine.map->getNodeOrigCornerPoint(coords, layer);
 
-            std::string currentTileID = engine.map->getTileID(currentOriginPoint, layer);
-            for (auto &foundNode : TileManager::instance().getTargetCoordsOfTileID(currentOriginPoint, currentTileID))
+            const TileId currentTileId = engine.map->getTileId(currentOriginPoint, layer);
+            for (auto &foundNode : TileManager::instance().getTargetCoordsOfTileID(currentOriginPoint, currentTileId))
             {
               // only add the node if it's unique
               if (std::find(m_nodesToHighlight.begin(), m_nodesToHighlight.end(), foundNode) == m_nodesToHighlight.end())
               {
-                nodesToAdd.push_back(foundNode);
+                m_nodesToAdd.push_back(foundNode);
               }
             }
           }
           // add the nodes we've found
-          m_nodesToHighlight.insert(m_nodesToHighlight.end(), nodesToAdd.begin(), nodesToAdd.end());
+          m_nodesToHighlight.insert(m_nodesToHighlight.end(), m_nodesToAdd.begin(), m_nodesToAdd.end());
 
           // for ground decoration, place all ground decoration files beneath the building
           if (tileToPlaceData && tileToPlaceData->tileType == +TileType::GROUNDDECORATION)
@@ -402,7 +408,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
           // we need to check if placement is allowed and set a bool to color ALL the highlighted tiles and not just those who can't be placed
           for (const auto &highlitNode : m_nodesToHighlight)
           {
-            if (!engine.map->isPlacementOnNodeAllowed(highlitNode, tileToPlace) || demolishMode)
+            if (!engine.map->isPlacementOnNodeAllowed(highlitNode, tileToPlaceId) || demolishMode)
             {
               // already occupied tile, mark red
               m_placementAllowed = false;
@@ -434,6 +440,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
               if (tileData && tileData->category != "Flora")
               {
                 engine.map->getMapNode(buildingCoordinates).setNodeTransparency(0.6f, Layer::BUILDINGS);
+                engine.map->invalidateNode(buildingCoordinates);
                 m_transparentBuildings.push_back(buildingCoordinates);
               }
             }
@@ -464,7 +471,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
         // game event handling
         mouseScreenCoords = {event.button.x, event.button.y};
         mouseIsoCoords = convertScreenToIsoCoordinates(mouseScreenCoords);
-        const std::vector targetObjectNodes = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
+        const TileFootprint targetObjectNodes = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
 
         //check if the coords for the click and for the occpuied tiles of the tileID we want to place are within map boundaries
         bool canPlaceTileID = false;
@@ -543,7 +550,7 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
       mouseScreenCoords = {event.button.x, event.button.y};
       mouseIsoCoords = convertScreenToIsoCoordinates(mouseScreenCoords);
       // gather all nodes the objects that'll be placed is going to occupy.
-      std::vector targetObjectNodes = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
+      const TileFootprint targetObjectNodes = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
 
       if (event.button.button == SDL_BUTTON_LEFT)
       {
@@ -601,4 +608,6 @@ void EventManager::checkEvents(SDL_Event &event, Engine &engine)
       break;
     }
   }
+
+  return hasEvents;
 }
@@ -14,7 +14,10 @@ public:
   EventManager() = default;
   ~EventManager() = default;
 
-  void checkEvents(SDL_Event &event, Engine &engine);
+  /** @brief Handle all pending SDL events
+   * @return true if there were any events, the frame might look different then
+   */
+  bool checkEvents(SDL_Event &event, Engine &engine);
   /**
  * @brief Unhighlight Highlited Nodes.
  * This sets a node to be unhighlited.
@@ -37,6 +40,8 @@ private:
   std::vector<Point> m_nodesToPlace = {};
   std::vector<Point> m_nodesToHighlight = {};
   std::vector<Point> m_transparentBuildings;
+  /// nodes of multi-node tiles that are found while highlighting, kept between frames so it doesn't need to be allocated again
+  std::vector<Point> m_nodesToAdd;
 };
 
 #endif
@@ -6,53 +6,47 @@
 #include "GameStates.hxx"
 #include "Settings.hxx"
 
-MapNode::MapNode(Point isoCoordinates, const std::string &terrainID, const std::string &tileID)
-    : m_isoCoordinates(std::move(isoCoordinates)), m_sprite{std::make_unique<Sprite>(m_isoCoordinates)},
-      m_autotileOrientation(LAYERS_COUNT, TileOrientation::TILE_DEFAULT_ORIENTATION),
-      m_mapNodeData{std::vector(LAYERS_COUNT, MapNodeData{"", nullptr, 0, m_isoCoordinates, true, TileMap::DEFAULT})},
-      m_autotileBitmask(LAYERS_COUNT)
+void MapNode::initialize(int height, const std::string &terrainID, const std::string &tileID)
 {
-  setTileID(terrainID, isoCoordinates);
-  if (!tileID.empty()) // in case tileID is not supplied skip it
+  TileManager &tileManager = TileManager::instance();
+  const TileId tileId = tileManager.getTileId(tileID);
+
+  m_grid->height(m_index) = static_cast<uint8_t>(height);
+  m_grid->sprite(m_index).isoCoordinates = getCoordinates();
+
+  setTileID(tileManager.getTileId(terrainID), getCoordinates());
+  if (tileId != EMPTY_TILE_ID) // in case tileID is not supplied skip it
   {
-    setTileID(tileID, isoCoordinates);
+    setTileID(tileId, getCoordinates());
   }
   // always add blueprint tiles too when creating the node
-  setTileID("terrain_blueprint", isoCoordinates);
-  const Layer layer = TileManager::instance().getTileLayer(tileID);
-  updateTexture(layer);
+  setTileID(tileManager.getTileId("terrain_blueprint"), getCoordinates());
+  updateTexture(tileManager.getTileLayer(tileId));
 }
 
 bool MapNode::changeHeight(const bool higher)
 {
   constexpr int minHeight = 0;
-  auto &height = m_isoCoordinates.height;
+  auto &height = m_grid->height(m_index);
 
   if ((higher && (height < maxHeight)) || (!higher && (height > minHeight)))
   {
     higher ? ++height : --height;
-    m_sprite->isoCoordinates = m_isoCoordinates;
+    m_grid->sprite(m_index).isoCoordinates = getCoordinates();
     return true;
   }
 
   return false;
 }
 
-void MapNode::render() const { m_sprite->render(); }
-
-void MapNode::setBitmask(unsigned char elevationBitmask, std::vector<uint8_t> autotileBitmask)
-{
-  m_elevationBitmask = elevationBitmask;
-  m_autotileBitmask = autotileBitmask;
-  updateTexture();
-}
+void MapNode::render(SpriteBatcher &batcher) const { m_grid->sprite(m_index).render(batcher); }
 
-void MapNode::setTileID(const std::string &tileID, const Point &origCornerPoint)
+void MapNode::setTileID(TileId tileId, const Point &origCornerPoint)
 {
-  TileData *tileData = TileManager::instance().getTileData(tileID);
-  if (tileData && !tileID.empty())
+  TileData *tileData = TileManager::instance().getTileData(tileId);
+  if (tileData)
   {
-    const Layer layer = TileManager::instance().getTileLayer(tileID);
+    const Layer layer = TileManager::instance().getTileLayer(tileId);
     switch (layer)
     {
     case Layer::ZONE:
@@ -71,31 +65,31 @@ void MapNode::setTileID(const std::string &tileID, const Point &origCornerPoint)
       {
         this->setNodeTransparency(0.6, Layer::BLUEPRINT);
       }
-      m_mapNodeData[Layer::ZONE].shouldRender = false;
+      m_grid->setShouldRender(Layer::ZONE, m_index, false);
       break;
     default:
       break;
     }
 
-    m_mapNodeData[layer].origCornerPoint = origCornerPoint;
-    m_previousTileID = m_mapNodeData[layer].tileID;
-    m_mapNodeData[layer].tileData = tileData;
-    m_mapNodeData[layer].tileID = tileID;
+    m_grid->origCornerIndex(layer, m_index) =
+        origCornerPoint.x >= 0 ? m_grid->nodeIdx(origCornerPoint.x, origCornerPoint.y) : -1;
+    m_grid->previousTileId(m_index) = m_grid->tileId(layer, m_index);
+    m_grid->tileId(layer, m_index) = tileId;
 
     // Determine if the tile should have a random rotation or not.
-    if (m_mapNodeData[layer].tileData->tiles.pickRandomTile && m_mapNodeData[layer].tileData->tiles.count > 1)
+    if (tileData->tiles.pickRandomTile && tileData->tiles.count > 1)
     {
       /** set tileIndex to a rand between 1 and count, this will be the displayed image of the entire tileset
       * if this tile has ordered frames, like roads then pickRandomTile must be set to 0.
       **/
-      m_mapNodeData[layer].tileIndex = rand() % m_mapNodeData[layer].tileData->tiles.count;
+      m_grid->tileIndex(layer, m_index) = static_cast<uint16_t>(rand() % tileData->tiles.count);
     }
     else
     {
       /** must be reset to 0 otherwise overwritting tiles would keep the old
       * tile's tileIndex which creates problems if it's supposed to be 0
       **/
-      m_mapNodeData[layer].tileIndex = 0;
+      m_grid->tileIndex(layer, m_index) = 0;
     }
     updateTexture(layer);
   }
@@ -103,24 +97,24 @@ void MapNode::setTileID(const std::string &tileID, const Point &origCornerPoint)
 
 Layer MapNode::getTopMostActiveLayer() const
 {
-  if (MapLayers::isLayerActive(Layer::BUILDINGS) && m_mapNodeData[Layer::BUILDINGS].tileData)
+  if (MapLayers::isLayerActive(Layer::BUILDINGS) && isLayerOccupied(Layer::BUILDINGS))
   {
     return Layer::BUILDINGS;
   }
-  else if (MapLayers::isLayerActive(Layer::BLUEPRINT) && m_mapNodeData[Layer::UNDERGROUND].tileData)
+  else if (MapLayers::isLayerActive(Layer::BLUEPRINT) && isLayerOccupied(Layer::UNDERGROUND))
   {
     return Layer::UNDERGROUND;
   }
-  else if (MapLayers::isLayerActive(Layer::BLUEPRINT) && m_mapNodeData[Layer::BLUEPRINT].tileData)
+  else if (MapLayers::isLayerActive(Layer::BLUEPRINT) && isLayerOccupied(Layer::BLUEPRINT))
   {
     return Layer::BLUEPRINT;
   }
-  else if (MapLayers::isLayerActive(Layer::GROUND_DECORATION) && m_mapNodeData[Layer::GROUND_DECORATION].tileData)
+  else if (MapLayers::isLayerActive(Layer::GROUND_DECORATION) && isLayerOccupied(Layer::GROUND_DECORATION))
   {
     return Layer::GROUND_DECORATION;
   }
   // terrain is our fallback, since there's always terrain.
-  else if (MapLayers::isLayerActive(Layer::TERRAIN) && m_mapNodeData[Layer::TERRAIN].tileData)
+  else if (MapLayers::isLayerActive(Layer::TERRAIN) && isLayerOccupied(Layer::TERRAIN))
   {
     return Layer::TERRAIN;
   }
@@ -131,25 +125,24 @@ void MapNode::setNodeTransparency(const float transparencyFactor, const Layer &l
 {
   // TODO refactoring: Consider replacing magic number (255) with constexpr.
   unsigned char alpha = (1 - transparencyFactor) * 255;
-  m_sprite->setSpriteTranparencyFactor(layer, alpha);
+  m_grid->sprite(m_index).setSpriteTranparencyFactor(layer, alpha);
 }
 
-bool MapNode::isPlacableOnSlope(const std::string &tileID) const
+bool MapNode::isPlacableOnSlope(TileId tileId) const
 {
-  TileData *tileData = TileManager::instance().getTileData(tileID);
+  TileData *tileData = TileManager::instance().getTileData(tileId);
   if (tileData && tileData->tileType == +TileType::ZONE)
   {
     // zones are allowed to pass slopes.
     return true;
   }
-  if (tileData && m_elevationOrientation != TileSlopes::DEFAULT_ORIENTATION)
+  if (tileData && m_grid->elevationOrientation(m_index) != TileSlopes::DEFAULT_ORIENTATION)
   {
     // we need to check the terrain layer for it's orientation so we can calculate the resulting x offset in the spritesheet.
-    const int clipRectX = tileData->slopeTiles.clippingWidth * static_cast<int>(m_autotileOrientation[Layer::TERRAIN]);
-    // while loading game, m_previousTileID will be equal to "terrain" for terrin tiles while it's empty "" when starting new game.
-    // so the check here on m_previousTileID is needed both (temporary), empty and "terrain", this will be fixed in new PR.
+    const int clipRectX = tileData->slopeTiles.clippingWidth * m_grid->autotileOrientation(Layer::TERRAIN, m_index);
+    // the previous tileID is empty for terrain tiles, both while loading a game and when starting a new one.
     if (clipRectX >= static_cast<int>(tileData->slopeTiles.count) * tileData->slopeTiles.clippingWidth &&
-        (m_previousTileID.empty() || m_previousTileID == "terrain"))
+        m_grid->previousTileId(m_index) == EMPTY_TILE_ID)
     {
       return false;
     }
@@ -157,13 +150,13 @@ bool MapNode::isPlacableOnSlope(const std::string &tileID) const
   return true;
 }
 
-bool MapNode::isPlacementAllowed(const std::string &newTileID) const
+bool MapNode::isPlacementAllowed(TileId newTileId) const
 {
-  TileData *tileData = TileManager::instance().getTileData(newTileID);
+  TileData *tileData = TileManager::instance().getTileData(newTileId);
 
   if (tileData)
   {
-    const Layer layer = TileManager::instance().getTileLayer(newTileID);
+    const Layer layer = TileManager::instance().getTileLayer(newTileId);
     // layer specific checks:
     switch (layer)
     {
@@ -171,8 +164,8 @@ bool MapNode::isPlacementAllowed(const std::string &newTileID) const
       // zones can overplace themselves and everything else
       return true;
     case Layer::ROAD:
-      if ((isLayerOccupied(Layer::BUILDINGS) && (m_mapNodeData[Layer::BUILDINGS].tileData->category != "Flora")) ||
-          isLayerOccupied(Layer::WATER) || !isPlacableOnSlope(newTileID))
+      if ((isLayerOccupied(Layer::BUILDINGS) && (getTileData(Layer::BUILDINGS)->category != "Flora")) ||
+          isLayerOccupied(Layer::WATER) || !isPlacableOnSlope(newTileId))
       { // roads cannot be placed:
         // - on buildings that are not category flora.
         // - on water
@@ -181,13 +174,13 @@ bool MapNode::isPlacementAllowed(const std::string &newTileID) const
       }
       return true;
     case Layer::GROUND_DECORATION:
-      if (m_mapNodeData[Layer::GROUND_DECORATION].tileData || m_mapNodeData[Layer::BUILDINGS].tileData)
+      if (isLayerOccupied(Layer::GROUND_DECORATION) || isLayerOccupied(Layer::BUILDINGS))
       { // allow placement of ground decoration on existing ground decoration and on buildings.
         return true;
       }
       break;
     case Layer::BUILDINGS:
-      TileData *tileDataBuildings = m_mapNodeData[Layer::BUILDINGS].tileData;
+      const TileData *tileDataBuildings = getTileData(Layer::BUILDINGS);
       if (tileDataBuildings && tileDataBuildings->isOverPlacable)
       { // buildings with overplacable flag
         return true;
@@ -220,7 +213,7 @@ bool MapNode::isPlacementAllowed(const std::string &newTileID) const
       }
     }
 
-    if (!isPlacableOnSlope(newTileID))
+    if (!isPlacableOnSlope(newTileId))
     { // Check if a tile has slope frames and therefore can be placed on a node with a slope
       return false;
     }
@@ -230,7 +223,7 @@ bool MapNode::isPlacementAllowed(const std::string &newTileID) const
       return true;
     }
 
-    if (m_mapNodeData[layer].tileID.empty())
+    if (!isLayerOccupied(layer))
     { // of course allow placement on empty tiles
       return true;
     }
@@ -242,8 +235,11 @@ bool MapNode::isPlacementAllowed(const std::string &newTileID) const
 void MapNode::updateTexture(const Layer &layer)
 {
   SDL_Rect clipRect{0, 0, 0, 0};
+  int clippingWidth = 0;
+  Sprite &sprite = m_grid->sprite(m_index);
   //TODO: Refactor this
-  m_elevationOrientation = TileManager::instance().calculateSlopeOrientation(m_elevationBitmask);
+  const size_t elevationOrientation = TileManager::instance().calculateSlopeOrientation(m_grid->elevationBitmask(m_index));
+  m_grid->elevationOrientation(m_index) = static_cast<uint8_t>(elevationOrientation);
   std::vector<Layer> layersToGoOver;
   if (layer != Layer::NONE)
   {
@@ -257,192 +253,216 @@ void MapNode::updateTexture(const Layer &layer)
 
   for (auto currentLayer : layersToGoOver)
   {
-    if (m_mapNodeData[currentLayer].tileData)
+    const TileId tileId = m_grid->tileId(currentLayer, m_index);
+    const TileData *tileData = TileManager::instance().getTileData(tileId);
+
+    if (tileData)
     {
+      uint8_t &tileMap = m_grid->tileMap(currentLayer, m_index);
+      uint8_t &autotileOrientation = m_grid->autotileOrientation(currentLayer, m_index);
+      const uint16_t tileIndex = m_grid->tileIndex(currentLayer, m_index);
       size_t spriteCount = 1;
-      m_mapNodeData[currentLayer].tileMap = TileMap::DEFAULT;
-      if (m_elevationOrientation == TileSlopes::DEFAULT_ORIENTATION)
+
+      tileMap = TileMap::DEFAULT;
+      if (elevationOrientation == TileSlopes::DEFAULT_ORIENTATION)
       {
-        if (m_mapNodeData[currentLayer].tileData->tileType == +TileType::WATER ||
-            m_mapNodeData[currentLayer].tileData->tileType == +TileType::TERRAIN ||
-            m_mapNodeData[currentLayer].tileData->tileType == +TileType::BLUEPRINT)
+        if (tileData->tileType == +TileType::WATER || tileData->tileType == +TileType::TERRAIN ||
+            tileData->tileType == +TileType::BLUEPRINT)
         {
-          m_autotileOrientation[currentLayer] = TileManager::instance().calculateTileOrientation(m_autotileBitmask[currentLayer]);
-          m_mapNodeData[currentLayer].tileMap = TileMap::DEFAULT;
-          if (currentLayer == Layer::TERRAIN && m_autotileOrientation[currentLayer] != TileOrientation::TILE_DEFAULT_ORIENTATION)
+          autotileOrientation =
+              TileManager::instance().calculateTileOrientation(m_grid->autotileBitmask(currentLayer, m_index));
+          tileMap = TileMap::DEFAULT;
+          if (currentLayer == Layer::TERRAIN && autotileOrientation != TileOrientation::TILE_DEFAULT_ORIENTATION)
           {
-            m_mapNodeData[Layer::TERRAIN].tileMap = TileMap::SHORE;
+            tileMap = TileMap::SHORE;
             // for shore tiles, we need to reset the tileIndex to 0, else a random tile would be picked. This is a little bit hacky.
-            m_mapNodeData[Layer::TERRAIN].tileIndex = 0;
+            m_grid->tileIndex(Layer::TERRAIN, m_index) = 0;
           }
         }
         // if the node can autotile, calculate it's tile orientation
-        else if (TileManager::instance().isTileIDAutoTile(getTileID(currentLayer)))
+        else if (TileManager::instance().isTileIDAutoTile(tileId))
         {
-          m_autotileOrientation[currentLayer] = TileManager::instance().calculateTileOrientation(m_autotileBitmask[currentLayer]);
+          autotileOrientation =
+              TileManager::instance().calculateTileOrientation(m_grid->autotileBitmask(currentLayer, m_index));
         }
       }
-      else if (m_elevationOrientation >= TileSlopes::N && m_elevationOrientation <= TileSlopes::BETWEEN)
+      else if (elevationOrientation >= TileSlopes::N && elevationOrientation <= TileSlopes::BETWEEN)
       {
-        if (m_mapNodeData[currentLayer].tileData->slopeTiles.fileName.empty())
+        if (tileData->slopeTiles.fileName.empty())
         {
-          m_mapNodeData[currentLayer].tileMap = TileMap::DEFAULT;
-          m_autotileOrientation[currentLayer] = TileOrientation::TILE_DEFAULT_ORIENTATION;
+          tileMap = TileMap::DEFAULT;
+          autotileOrientation = TileOrientation::TILE_DEFAULT_ORIENTATION;
         }
         else
         {
-          m_mapNodeData[currentLayer].tileMap = TileMap::SLOPES; // TileSlopes [N,E,w,S]
-          m_autotileOrientation[currentLayer] = static_cast<TileOrientation>(m_elevationOrientation);
+          tileMap = TileMap::SLOPES; // TileSlopes [N,E,w,S]
+          autotileOrientation = static_cast<uint8_t>(elevationOrientation);
         }
       }
 
-      switch (m_mapNodeData[currentLayer].tileMap)
+      switch (tileMap)
       {
       case TileMap::DEFAULT:
-        m_clippingWidth = m_mapNodeData[currentLayer].tileData->tiles.clippingWidth;
-        if (m_mapNodeData[currentLayer].tileIndex != 0)
+        clippingWidth = tileData->tiles.clippingWidth;
+        if (tileIndex != 0)
         {
-          clipRect.x = m_clippingWidth * m_mapNodeData[currentLayer].tileIndex;
+          clipRect.x = clippingWidth * tileIndex;
         }
         else
         {
           // only check for rectangular roads when there are frames for it. Spritesheets with rect-roads have 20 items
-          if (GameStates::instance().rectangularRoads && m_mapNodeData[currentLayer].tileData->tiles.count == 20)
+          if (GameStates::instance().rectangularRoads && tileData->tiles.count == 20)
           {
-            switch (m_autotileOrientation[currentLayer])
+            switch (autotileOrientation)
             {
             case TileOrientation::TILE_S_AND_W:
-              m_autotileOrientation[currentLayer] = TileOrientation::TILE_S_AND_W_RECT;
+              autotileOrientation = TileOrientation::TILE_S_AND_W_RECT;
               break;
             case TileOrientation::TILE_S_AND_E:
-              m_autotileOrientation[currentLayer] = TileOrientation::TILE_S_AND_E_RECT;
+              autotileOrientation = TileOrientation::TILE_S_AND_E_RECT;
               break;
             case TileOrientation::TILE_N_AND_E:
-              m_autotileOrientation[currentLayer] = TileOrientation::TILE_N_AND_E_RECT;
+              autotileOrientation = TileOrientation::TILE_N_AND_E_RECT;
               break;
             case TileOrientation::TILE_N_AND_W:
-              m_autotileOrientation[currentLayer] = TileOrientation::TILE_N_AND_W_RECT;
+              autotileOrientation = TileOrientation::TILE_N_AND_W_RECT;
               break;
 
             default:
               break;
             }
           }
-          clipRect.x = m_clippingWidth * static_cast<int>(m_autotileOrientation[currentLayer]);
+          clipRect.x = clippingWidth * static_cast<int>(autotileOrientation);
         }
 
-        if (!m_mapNodeData[currentLayer].tileID.empty())
+        sprite.setClipRect(
+            {clipRect.x + clippingWidth * tileData->tiles.offset, 0, clippingWidth, tileData->tiles.clippingHeight},
+            static_cast<Layer>(currentLayer));
+        if (m_grid->shouldRender(currentLayer, m_index))
         {
-          m_sprite->setClipRect({clipRect.x + m_clippingWidth * m_mapNodeData[currentLayer].tileData->tiles.offset, 0,
-                                 m_clippingWidth, m_mapNodeData[currentLayer].tileData->tiles.clippingHeight},
-                                static_cast<Layer>(currentLayer));
-          if (m_mapNodeData[currentLayer].shouldRender)
-          {
-            m_sprite->setTexture(TileManager::instance().getTexture(m_mapNodeData[currentLayer].tileID),
-                                 static_cast<Layer>(currentLayer));
-          }
+          sprite.setTexture(TileManager::instance().getTexture(tileId), static_cast<Layer>(currentLayer),
+                            TileManager::instance().getAtlasRegion(tileId),
+                            TileManager::instance().getSpriteGeometryId(tileId));
         }
 
-        spriteCount = m_mapNodeData[currentLayer].tileData->tiles.count;
+        spriteCount = tileData->tiles.count;
         break;
       case TileMap::SHORE:
-        m_clippingWidth = m_mapNodeData[currentLayer].tileData->shoreTiles.clippingWidth;
-        if (m_mapNodeData[currentLayer].tileIndex != 0)
+        clippingWidth = tileData->shoreTiles.clippingWidth;
+        if (m_grid->tileIndex(currentLayer, m_index) != 0)
         {
-          clipRect.x = m_clippingWidth * m_mapNodeData[currentLayer].tileIndex;
+          clipRect.x = clippingWidth * m_grid->tileIndex(currentLayer, m_index);
         }
         else
         {
-          clipRect.x = m_clippingWidth * static_cast<int>(m_autotileOrientation[currentLayer]);
+          clipRect.x = clippingWidth * static_cast<int>(autotileOrientation);
         }
 
-        if (!m_mapNodeData[currentLayer].tileID.empty())
+        sprite.setClipRect({clipRect.x + clippingWidth * tileData->shoreTiles.offset, 0, clippingWidth,
+                            tileData->shoreTiles.clippingHeight},
+                           static_cast<Layer>(currentLayer));
+        if (m_grid->shouldRender(currentLayer, m_index))
         {
-          m_sprite->setClipRect({clipRect.x + m_clippingWidth * m_mapNodeData[currentLayer].tileData->shoreTiles.offset, 0,
-                                 m_clippingWidth, m_mapNodeData[currentLayer].tileData->shoreTiles.clippingHeight},
-                                static_cast<Layer>(currentLayer));
-          if (m_mapNodeData[currentLayer].shouldRender)
-          {
-            m_sprite->setTexture(TileManager::instance().getTexture(m_mapNodeData[currentLayer].tileID + "_shore"),
-                                 static_cast<Layer>(currentLayer));
-          }
+          sprite.setTexture(TileManager::instance().getTexture(tileId, TileMap::SHORE), static_cast<Layer>(currentLayer),
+                            TileManager::instance().getAtlasRegion(tileId, TileMap::SHORE),
+                            TileManager::instance().getSpriteGeometryId(tileId, TileMap::SHORE));
         }
 
-        spriteCount = m_mapNodeData[currentLayer].tileData->shoreTiles.count;
+        spriteCount = tileData->shoreTiles.count;
         break;
       case TileMap::SLOPES:
-        if (m_mapNodeData[currentLayer].tileData->slopeTiles.fileName.empty())
+        if (tileData->slopeTiles.fileName.empty())
         {
           break;
         }
-        m_clippingWidth = m_mapNodeData[currentLayer].tileData->slopeTiles.clippingWidth;
-        clipRect.x = m_mapNodeData[currentLayer].tileData->slopeTiles.clippingWidth *
-                     static_cast<int>(m_autotileOrientation[currentLayer]);
-        spriteCount = m_mapNodeData[currentLayer].tileData->slopeTiles.count;
-        if (clipRect.x <= static_cast<int>(spriteCount) * m_clippingWidth)
+        clippingWidth = tileData->slopeTiles.clippingWidth;
+        clipRect.x = tileData->slopeTiles.clippingWidth * static_cast<int>(autotileOrientation);
+        spriteCount = tileData->slopeTiles.count;
+        if (clipRect.x <= static_cast<int>(spriteCount) * clippingWidth)
         {
-          m_sprite->setClipRect({clipRect.x + m_mapNodeData[currentLayer].tileData->slopeTiles.offset * m_clippingWidth, 0,
-                                 m_clippingWidth, m_mapNodeData[currentLayer].tileData->slopeTiles.clippingHeight},
-                                static_cast<Layer>(currentLayer));
-          m_sprite->setTexture(TileManager::instance().getTexture(m_mapNodeData[currentLayer].tileID),
-                               static_cast<Layer>(currentLayer));
+          sprite.setClipRect({clipRect.x + tileData->slopeTiles.offset * clippingWidth, 0, clippingWidth,
+                              tileData->slopeTiles.clippingHeight},
+                             static_cast<Layer>(currentLayer));
+          sprite.setTexture(TileManager::instance().getTexture(tileId, TileMap::SLOPES), static_cast<Layer>(currentLayer),
+                            TileManager::instance().getAtlasRegion(tileId, TileMap::SLOPES),
+                            TileManager::instance().getSpriteGeometryId(tileId, TileMap::SLOPES));
         }
         break;
       default:
         break;
       }
 
-      if (clipRect.x >= static_cast<int>(spriteCount) * m_clippingWidth)
+      if (clipRect.x >= static_cast<int>(spriteCount) * clippingWidth)
       {
-        m_mapNodeData[currentLayer].tileID = m_previousTileID;
-        if (m_previousTileID.empty())
-        {
-          m_mapNodeData[currentLayer].tileData = nullptr;
-        }
+        m_grid->tileId(currentLayer, m_index) = m_grid->previousTileId(m_index);
         updateTexture(currentLayer);
       }
-      m_sprite->spriteCount = spriteCount;
+      sprite.spriteCount = spriteCount;
     }
   }
 }
 
-bool MapNode::isSlopeNode() const { return m_mapNodeData[Layer::TERRAIN].tileMap == TileMap::SLOPES; }
+bool MapNode::isSlopeNode() const { return m_grid->tileMap(Layer::TERRAIN, m_index) == TileMap::SLOPES; }
+
+Point MapNode::getOrigCornerPoint(Layer layer) const
+{
+  const int origCornerIndex = m_grid->origCornerIndex(layer, m_index);
+
+  return (origCornerIndex >= 0) ? m_grid->coordinates(origCornerIndex) : Point::INVALID();
+}
+
+MapNodeData MapNode::getMapNodeDataForLayer(Layer layer) const
+{
+  return MapNodeData{m_grid->tileId(layer, m_index), m_grid->tileIndex(layer, m_index), getOrigCornerPoint(layer),
+                     m_grid->shouldRender(layer, m_index), static_cast<TileMap>(m_grid->tileMap(layer, m_index))};
+}
 
-void MapNode::setCoordinates(const Point &newIsoCoordinates)
+std::vector<MapNodeData> MapNode::getMapNodeData() const
 {
-  m_isoCoordinates = newIsoCoordinates;
-  m_sprite->isoCoordinates = m_isoCoordinates;
+  std::vector<MapNodeData> mapNodeData;
+  mapNodeData.reserve(LAYERS_COUNT);
+
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    mapNodeData.push_back(getMapNodeDataForLayer(static_cast<Layer>(layer)));
+  }
+
+  return mapNodeData;
 }
 
-const MapNodeData &MapNode::getActiveMapNodeData() const { return m_mapNodeData[getTopMostActiveLayer()]; }
+MapNodeData MapNode::getActiveMapNodeData() const { return getMapNodeDataForLayer(getTopMostActiveLayer()); }
 
-void MapNode::setMapNodeData(std::vector<MapNodeData> &&mapNodeData, const Point &currNodeIsoCoordinates)
+void MapNode::setAutotileBitMask(const std::array<uint8_t, LAYERS_COUNT> &bitMask)
+{
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    m_grid->autotileBitmask(static_cast<Layer>(layer), m_index) = bitMask[layer];
+  }
+}
+
+void MapNode::setMapNodeData(const std::vector<MapNodeData> &mapNodeData, const Point &currNodeIsoCoordinates)
 {
-  m_mapNodeData.swap(mapNodeData);
   this->setNodeTransparency(Settings::instance().zoneLayerTransparency, Layer::ZONE);
 
-  // updates the pointers to the tiles, after loading tileIDs from json
-  for (auto &it : m_mapNodeData)
+  for (auto layer = 0U; layer < LAYERS_COUNT && layer < mapNodeData.size(); ++layer)
   {
-    delete it.tileData;
-
-    it.tileData = TileManager::instance().getTileData(it.tileID);
-    if (it.origCornerPoint != currNodeIsoCoordinates)
-    {
-      it.shouldRender = false;
-    }
+    const Layer currentLayer = static_cast<Layer>(layer);
+    const MapNodeData &data = mapNodeData[layer];
+
+    m_grid->tileId(currentLayer, m_index) = data.tileId;
+    m_grid->tileIndex(currentLayer, m_index) = static_cast<uint16_t>(data.tileIndex);
+    m_grid->origCornerIndex(currentLayer, m_index) =
+        data.origCornerPoint.x >= 0 ? m_grid->nodeIdx(data.origCornerPoint.x, data.origCornerPoint.y) : -1;
+    m_grid->setShouldRender(currentLayer, m_index, data.origCornerPoint == currNodeIsoCoordinates);
   }
 }
 
 void MapNode::demolishLayer(const Layer &layer)
 {
-  m_mapNodeData[layer].tileData = nullptr;
-  m_mapNodeData[layer].tileID = "";
-  m_autotileOrientation[layer] =
-      TileOrientation::TILE_DEFAULT_ORIENTATION; // We need to reset TileOrientation, in case it's set (demolishing autotiles)
-  m_mapNodeData[layer].origCornerPoint = this->getCoordinates();
-  m_mapNodeData[Layer::ZONE].shouldRender = true;
-  m_sprite->clearSprite(layer);
+  // We need to reset TileOrientation too, in case it's set (demolishing autotiles)
+  m_grid->clearLayer(layer, m_index);
+  m_grid->setShouldRender(Layer::ZONE, m_index, true);
+  m_grid->sprite(m_index).clearSprite(layer);
 }
 
 void MapNode::demolishNode(const Layer &demolishLayer)
@@ -460,14 +480,14 @@ void MapNode::demolishNode(const Layer &demolishLayer)
 
   for (auto &layer : layersToDemolish)
   {
-    if (MapLayers::isLayerActive(layer) && m_mapNodeData[layer].tileData)
+    const TileData *tileData = getTileData(layer);
+
+    if (MapLayers::isLayerActive(layer) && tileData)
     {
-      if ((GameStates::instance().demolishMode == DemolishMode::DEFAULT &&
-           m_mapNodeData[layer].tileData->tileType == +TileType::ZONE) ||
-          (GameStates::instance().demolishMode == DemolishMode::DE_ZONE &&
-           m_mapNodeData[layer].tileData->tileType != +TileType::ZONE) ||
+      if ((GameStates::instance().demolishMode == DemolishMode::DEFAULT && tileData->tileType == +TileType::ZONE) ||
+          (GameStates::instance().demolishMode == DemolishMode::DE_ZONE && tileData->tileType != +TileType::ZONE) ||
           (GameStates::instance().demolishMode == DemolishMode::GROUND_DECORATION &&
-           m_mapNodeData[layer].tileData->tileType != +TileType::GROUNDDECORATION))
+           tileData->tileType != +TileType::GROUNDDECORATION))
       {
         continue;
       }
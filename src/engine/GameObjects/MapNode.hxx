@@ -3,7 +3,7 @@
 
 #include <SDL.h>
 
-#include <memory>
+#include <array>
 #include <string>
 #include <algorithm>
 #include <vector>
@@ -11,13 +11,15 @@
 #include "../Sprite.hxx"
 #include "../common/enums.hxx"
 #include "../basics/point.hxx"
+#include "../map/MapGrid.hxx"
 
 #include "../TileManager.hxx"
 
+class SpriteBatcher;
+
 struct MapNodeData
 {
-  std::string tileID;
-  TileData *tileData = nullptr;
+  TileId tileId = EMPTY_TILE_ID;
   int32_t tileIndex = 0;
   Point origCornerPoint = Point::INVALID();
   bool shouldRender = true;
@@ -25,46 +27,46 @@ struct MapNodeData
 };
 
 /** @brief Class that holds map nodes
- * Each tile is represented by the map nodes class.
+ * Each tile is represented by the map nodes class. A MapNode is a lightweight view on a single node of the MapGrid,
+ * all its data lives in the grid's attribute arrays.
+ * @see MapGrid
  */
 
 class MapNode
 {
 public:
-  MapNode(Point isoCoordinates, const std::string &terrainID, const std::string &newTileID = "");
-
-  /** @brief Move constructor.
+  /** @brief Create a view on a node of the grid
+    * @param grid the grid that holds the node's data
+    * @param index node index within the grid
     */
-  MapNode(MapNode &&mn) noexcept
-      : m_isoCoordinates(std::move(mn.m_isoCoordinates)), m_sprite(std::move(mn.m_sprite)),
-        m_previousTileID(std::move(mn.m_previousTileID)), m_autotileOrientation(std::move(mn.m_autotileOrientation)),
-        m_elevationOrientation(mn.m_elevationOrientation), m_clippingWidth(mn.m_clippingWidth),
-        m_mapNodeData(std::move(mn.m_mapNodeData)), m_autotileBitmask(std::move(mn.m_autotileBitmask)),
-        m_elevationBitmask(mn.m_elevationBitmask){};
+  MapNode(MapGrid &grid, int index) : m_grid(&grid), m_index(index){};
 
-  /**
-    * @brief Destroys the MapNode object
-    */
   ~MapNode() = default;
 
+  /** @brief Initialize the node
+    * Sets the height of the node and places the terrain and (optional) tile on it.
+    * @param height the height of the node
+    * @param terrainID tileID of the terrain
+    * @param newTileID (optional) tileID that should be placed on top of the terrain
+    */
+  void initialize(int height, const std::string &terrainID, const std::string &newTileID = "");
+
   /** @brief get Sprite
     * get the Sprite* object for this nodes
     * @returns the Sprite of this node.
     * @see Sprite
     */
-  Sprite *getSprite() const { return m_sprite.get(); };
+  Sprite *getSprite() const { return &m_grid->sprite(m_index); };
 
   /** @brief get iso coordinates of this node
     * gets the iso coordinates of this node
-    * @returns a pointer to the node's iso coordinates
+    * @returns the node's iso coordinates
     */
-  const Point &getCoordinates() const { return m_isoCoordinates; };
+  Point getCoordinates() const { return m_grid->coordinates(m_index); };
 
-  /** @brief sets the iso coordinates of this node
-    * sets the iso coordinates of this node
-    * @param newIsoCoordinates the new iso coordinates for the node
+  /** @brief get the index of this node within the MapGrid
     */
-  void setCoordinates(const Point &newIsoCoordinates);
+  int getIndex() const { return m_index; };
 
   /** @brief Change Height
     * Increases or decrease the height of the node and its sprite
@@ -78,35 +80,42 @@ public:
   /** @brief Render MapNode
   * Renders the sprite object(s) of the node
   */
-  void render() const;
+  void render(SpriteBatcher &batcher) const;
 
-  void setBitmask(unsigned char elevationBitmask, std::vector<uint8_t> tileTypeBitmask);
+  unsigned char getElevationBitmask() const { return m_grid->elevationBitmask(m_index); };
 
-  unsigned char getElevationBitmask() const { return m_elevationBitmask; };
+  const TileData *getTileData(Layer layer) const { return TileManager::instance().getTileData(getTileId(layer)); };
 
-  const TileData *getTileData(Layer layer) const { return m_mapNodeData[layer].tileData; };
+  /** @brief get the handle of the TileID of specific layer inside NodeData.
+    * @param layer - what layer should be checked on.
+    */
+  TileId getTileId(Layer layer) const { return m_grid->tileId(layer, m_index); };
 
   /** @brief get TileID of specific layer inside NodeData.
     * @param layer - what layer should be checked on.
     */
-  const std::string &getTileID(Layer layer) const { return m_mapNodeData[layer].tileID; };
+  const std::string &getTileID(Layer layer) const { return TileManager::instance().getTileIDString(getTileId(layer)); };
+
+  /** @brief get the TileMap (default, slope or shore tiles) that is used for a layer
+    */
+  TileMap getTileMap(Layer layer) const { return static_cast<TileMap>(m_grid->tileMap(layer, m_index)); };
 
-  bool isPlacementAllowed(const std::string &newTileID) const;
+  bool isPlacementAllowed(TileId newTileId) const;
 
-  /// Overwrite m_mapData with the one loaded from a savegame. This function to be used only by loadGame
-  void setMapNodeData(std::vector<MapNodeData> &&mapNodeData, const Point &isoCoordinates);
+  /// Overwrite the node data with the one loaded from a savegame. This function to be used only by loadGame
+  void setMapNodeData(const std::vector<MapNodeData> &mapNodeData, const Point &isoCoordinates);
 
-  const std::vector<MapNodeData> &getMapNodeData() const { return m_mapNodeData; };
-  const MapNodeData &getMapNodeDataForLayer(Layer layer) const { return m_mapNodeData[layer]; };
+  /// Collect the data of all layers, e.g. for serialization
+  std::vector<MapNodeData> getMapNodeData() const;
+  MapNodeData getMapNodeDataForLayer(Layer layer) const;
 
-  const MapNodeData &getActiveMapNodeData() const;
+  MapNodeData getActiveMapNodeData() const;
 
   /** @brief tileID placeable on slope tile.
     * check if tileID is placeable on slope.
-    * @param tileID - the tileID which need to be checked whether allowing placement on slope or not.
-    * @param layer - what layer should be checked on, in case this is not BUILDING layer the placement is OK.
+    * @param tileId - the tileID which need to be checked whether allowing placement on slope or not.
     */
-  bool isPlacableOnSlope(const std::string &tileID) const;
+  bool isPlacableOnSlope(TileId tileId) const;
 
   /** @brief check if current Node Terrain is Slope Terrain.
     */
@@ -127,9 +136,9 @@ public:
     */
   void demolishLayer(const Layer &layer);
 
-  void setTileID(const std::string &tileType, const Point &origPoint);
+  void setTileID(TileId tileId, const Point &origPoint);
 
-  const Point &getOrigCornerPoint(Layer layer) const { return getMapNodeDataForLayer(layer).origCornerPoint; }
+  Point getOrigCornerPoint(Layer layer) const;
 
   /** @brief return topmost active layer.
     * check layers in order of significance for the topmost active layer that has an active tile on that layer
@@ -137,17 +146,17 @@ public:
     */
   Layer getTopMostActiveLayer() const;
 
-  bool isLayerOccupied(const Layer &layer) const { return m_mapNodeData[layer].tileData != nullptr; }
+  bool isLayerOccupied(const Layer &layer) const { return m_grid->tileId(layer, m_index) != EMPTY_TILE_ID; }
 
-  void setRenderFlag(Layer layer, bool shouldRender) { m_mapNodeData[layer].shouldRender = shouldRender; }
+  void setRenderFlag(Layer layer, bool shouldRender) { m_grid->setShouldRender(layer, m_index, shouldRender); }
 
   /** @brief Set elevation bit mask.
     */
-  inline void setElevationBitMask(const unsigned char bitMask) { m_elevationBitmask = bitMask; }
+  inline void setElevationBitMask(const unsigned char bitMask) { m_grid->elevationBitmask(m_index) = bitMask; }
 
   /** @brief Set autotile bit mask.
     */
-  inline void setAutotileBitMask(std::vector<unsigned char> &&bitMask) { m_autotileBitmask = std::move(bitMask); }
+  void setAutotileBitMask(const std::array<uint8_t, LAYERS_COUNT> &bitMask);
 
   /** @brief Update texture.
     */
@@ -161,26 +170,13 @@ public:
    */
   void setNodeTransparency(const float transparencyFactor, const Layer &layer) const;
 
-  /**
-  * Update the Z-Index of this mapNode
-  * @param the new Z-Index
-  */
-  void setZIndex(int zIndex) { m_isoCoordinates.z = zIndex; };
-
   /**
    * @brief Maximum height of the node.
    */
   static const int maxHeight = 32;
 
 private:
-  Point m_isoCoordinates;
-  std::unique_ptr<Sprite> m_sprite;
-  std::string m_previousTileID = "terrain";
-  std::vector<TileOrientation> m_autotileOrientation;
-  size_t m_elevationOrientation = TileSlopes::DEFAULT_ORIENTATION;
-  int m_clippingWidth = 0;
-  std::vector<MapNodeData> m_mapNodeData;
-  std::vector<unsigned char> m_autotileBitmask;
-  unsigned char m_elevationBitmask = 0;
+  MapGrid *m_grid;
+  int m_index;
 };
 #endif
@@ -4,17 +4,26 @@
 #include "basics/isoMath.hxx"
 #include "basics/mapEdit.hxx"
 #include "basics/Settings.hxx"
+#include "basics/GameStates.hxx"
 #include "LOG.hxx"
-#include "basics/compression.hxx"
+#include "basics/ZlibStream.hxx"
 #include "common/Constants.hxx"
 #include "ResourcesManager.hxx"
+#include "WindowManager.hxx"
+#include "map/BinarySaveGame.hxx"
+#include "map/JsonSaveGame.hxx"
 #include "map/MapLayers.hxx"
-#include "common/JsonSerialization.hxx"
+#include "map/SaveGameLoader.hxx"
+#include "map/VisibleRange.hxx"
 #include "Filesystem.hxx"
+#include "ParallelFor.hxx"
 #include "../services/Randomizer.hxx"
 
-#include "json.hxx"
-
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <numeric>
 #include <sstream>
 #include <string>
 #include <set>
@@ -24,7 +33,15 @@
 #include "microprofile/microprofile.h"
 #endif
 
-using json = nlohmann::json;
+namespace
+{
+/// rows a building can span, demolishing one of its nodes demolishes all of them
+constexpr int buildingReachRows = static_cast<int>(MAX_TILE_FOOTPRINT);
+/** rows setTileID and demolishNode can change around a node: a new building demolishes the buildings it overlaps, and
+ * the neighbors of the changed nodes are updated
+ */
+constexpr int editReachRows = 2 * buildingReachRows;
+} // namespace
 
 NeighbourNodesPosition operator++(NeighbourNodesPosition &nn, int)
 {
@@ -67,16 +84,17 @@ NeighbourNodesPosition operator++(NeighbourNodesPosition &nn, int)
   return res;
 }
 
-void Map::getNodeInformation(const Point &isoCoordinates) const
+void Map::getNodeInformation(const Point &isoCoordinates)
 {
+  loadRows(isoCoordinates.x, isoCoordinates.x);
   const MapNode &mapNode = mapNodes[nodeIdx(isoCoordinates.x, isoCoordinates.y)];
-  const MapNodeData &mapNodeData = mapNode.getActiveMapNodeData();
-  const TileData *tileData = mapNodeData.tileData;
+  const MapNodeData mapNodeData = mapNode.getActiveMapNodeData();
+  const TileData *tileData = TileManager::instance().getTileData(mapNodeData.tileId);
   LOG(LOG_INFO) << "===== TILE at " << isoCoordinates.x << ", " << isoCoordinates.y << ", " << mapNode.getCoordinates().height
                 << "=====";
-  LOG(LOG_INFO) << "[Layer: TERRAIN] ID: " << mapNode.getMapNodeDataForLayer(Layer::TERRAIN).tileID;
-  LOG(LOG_INFO) << "[Layer: WATER] ID: " << mapNode.getMapNodeDataForLayer(Layer::WATER).tileID;
-  LOG(LOG_INFO) << "[Layer: BUILDINGS] ID: " << mapNode.getMapNodeDataForLayer(Layer::BUILDINGS).tileID;
+  LOG(LOG_INFO) << "[Layer: TERRAIN] ID: " << mapNode.getTileID(Layer::TERRAIN);
+  LOG(LOG_INFO) << "[Layer: WATER] ID: " << mapNode.getTileID(Layer::WATER);
+  LOG(LOG_INFO) << "[Layer: BUILDINGS] ID: " << mapNode.getTileID(Layer::BUILDINGS);
   LOG(LOG_INFO) << "Category: " << tileData->category;
   LOG(LOG_INFO) << "FileName: " << tileData->tiles.fileName;
   LOG(LOG_INFO) << "PickRandomTile: " << tileData->tiles.pickRandomTile;
@@ -85,42 +103,100 @@ void Map::getNodeInformation(const Point &isoCoordinates) const
 }
 
 Map::Map(int columns, int rows, const bool generateTerrain)
-    : pMapNodesVisible(new Sprite *[columns * rows]), m_columns(columns), m_rows(rows)
+    : m_grid(columns, rows), m_chunks(columns, rows), pMapNodesVisible(new Sprite *[columns * rows]), m_minimap(m_grid),
+      m_columns(columns), m_rows(rows)
 {
   // TODO move Random Engine out of map
   randomEngine.seed();
   MapLayers::enableLayers({TERRAIN, BUILDINGS, WATER, GROUND_DECORATION, ZONE, ROAD});
 
+  m_nodesToBeUpdatedMarks.resize(m_grid.nodeCount());
+  m_nodesToElevateMarks.resize(m_grid.nodeCount());
+  m_nodesToDemolishMarks.resize(m_grid.nodeCount());
+  m_unsavedNodeMarks.resize(m_grid.nodeCount());
+  m_minimap.subscribe(*this);
+
+  mapNodes.reserve(m_grid.nodeCount());
+  for (int index = 0; index < m_grid.nodeCount(); ++index)
+  {
+    mapNodes.emplace_back(m_grid, index);
+  }
+
+  // ZOrder starts from topmost node to the right. (0,127) =1,(1,127) =2, ...
+  mapNodesInDrawingOrder.reserve(m_grid.nodeCount());
+  for (int y = m_columns - 1; y >= 0; y--)
+  {
+    for (int x = 0; x < m_rows; x++)
+    {
+      mapNodesInDrawingOrder.push_back(&mapNodes[nodeIdx(x, y)]);
+    }
+  }
+
   if (generateTerrain)
   {
-    m_terrainGen.generateTerrain(mapNodes, mapNodesInDrawingOrder);
+    m_terrainGen.generateTerrain(mapNodes);
+    updateAllNodes();
   }
 
-  updateAllNodes();
+  m_grid.logMemoryFootprint();
 }
 
 Map::~Map() { delete[] pMapNodesVisible; }
 
-std::vector<NeighborNode> Map::getNeighborNodes(const Point &isoCoordinates, const bool includeCentralNode)
+NeighborNodes Map::getNeighborNodes(const Point &isoCoordinates, const bool includeCentralNode)
 {
-  std::vector<NeighborNode> neighbors;
+  NeighborNodes neighbors;
 
-  for (auto it : PointFunctions::getNeighbors(isoCoordinates, includeCentralNode))
+  for (const auto &offset : neighborOffsets)
   {
-    neighbors.push_back({&mapNodes[nodeIdx(it.x, it.y)], PointFunctions::getNeighborPositionToOrigin(it, isoCoordinates)});
+    const int neighborX = isoCoordinates.x + offset.x;
+    const int neighborY = isoCoordinates.y + offset.y;
+
+    if ((!includeCentralNode && offset.position == NeighbourNodesPosition::CENTER) || neighborX < 0 || neighborX >= m_rows ||
+        neighborY < 0 || neighborY >= m_columns)
+    {
+      continue;
+    }
+
+    neighbors.push_back({&mapNodes[nodeIdx(neighborX, neighborY)], offset.position});
   }
 
   return neighbors;
 }
 
-bool Map::updateHeight(MapNode &mapNode, const bool higher, std::vector<NeighborNode> &neighbors)
+NeighborNodes Map::getNeighborNodes(int index)
+{
+  const int x = index / m_columns;
+  const int y = index % m_columns;
+  NeighborNodes neighbors;
+
+  for (const auto &offset : neighborOffsets)
+  {
+    const int neighborX = x + offset.x;
+    const int neighborY = y + offset.y;
+
+    if (offset.position == NeighbourNodesPosition::CENTER || neighborX < 0 || neighborX >= m_rows || neighborY < 0 ||
+        neighborY >= m_columns)
+    {
+      continue;
+    }
+
+    neighbors.push_back({&mapNodes[nodeIdx(neighborX, neighborY)], offset.position});
+  }
+
+  return neighbors;
+}
+
+bool Map::updateHeight(MapNode &mapNode, const bool higher, const NeighborNodes &neighbors)
 {
   if (mapNode.changeHeight(higher))
   {
+    signalChangeHeight.emit(mapNode);
     for (const auto neighbour : neighbors)
     {
       if (neighbour.pNode->isLayerOccupied(Layer::ZONE))
       {
+        markNodeChanged(neighbour.pNode->getCoordinates());
         neighbour.pNode->demolishLayer(Layer::ZONE);
       }
     }
@@ -133,10 +209,12 @@ bool Map::updateHeight(MapNode &mapNode, const bool higher, std::vector<Neighbor
 
 void Map::changeHeight(const Point &isoCoordinates, const bool higher)
 {
+  // the heights that settle beyond the loaded rows are decoded on demand by settleNodeHeights
+  loadRows(isoCoordinates.x - editReachRows, isoCoordinates.x + editReachRows);
+
   MapNode &mapNode = mapNodes[nodeIdx(isoCoordinates.x, isoCoordinates.y)];
   std::vector<MapNode *> nodesToUpdate{&mapNode};
-  auto neighbours = getNeighborNodes(isoCoordinates, true);
-  std::vector<Point> neighorCoordinates = PointFunctions::getNeighbors(isoCoordinates, true);
+  const NeighborNodes neighbours = getNeighborNodes(isoCoordinates, true);
 
   if (updateHeight(mapNode, higher, neighbours))
   {
@@ -145,17 +223,27 @@ void Map::changeHeight(const Point &isoCoordinates, const bool higher)
     {
       const int centerHeight = getMapNode(isoCoordinates).getCoordinates().height;
 
-      for (Point &neighbourCoord : neighorCoordinates)
+      for (const auto &neighbour : neighbours)
       {
-        MapNode &neighborNode = getMapNode(neighbourCoord);
-        if (centerHeight < neighborNode.getCoordinates().height)
+        if (centerHeight < neighbour.pNode->getCoordinates().height)
         {
-          neighborNode.changeHeight(false);
-          nodesToUpdate.push_back(&neighborNode);
+          neighbour.pNode->changeHeight(false);
+          signalChangeHeight.emit(*neighbour.pNode);
+          nodesToUpdate.push_back(neighbour.pNode);
         }
       }
     }
-    demolishNode(neighorCoordinates);
+    for (const MapNode *pNode : nodesToUpdate)
+    {
+      markNodeChanged(pNode->getCoordinates());
+    }
+    std::vector<Point> neighborCoordinates;
+    neighborCoordinates.reserve(neighbours.size());
+    for (const auto &neighbour : neighbours)
+    {
+      neighborCoordinates.push_back(neighbour.pNode->getCoordinates());
+    }
+    demolishNode(neighborCoordinates);
     updateNodeNeighbors(nodesToUpdate);
   }
 }
@@ -164,125 +252,235 @@ void Map::increaseHeight(const Point &isoCoordinates) { changeHeight(isoCoordina
 
 void Map::decreaseHeight(const Point &isoCoordinates) { changeHeight(isoCoordinates, false); }
 
+// those bitmask combinations require the tile to be elevated.
+static constexpr unsigned char elevateTileComb[] = {
+    NeighbourNodesPosition::TOP | NeighbourNodesPosition::BOTTOM,
+    NeighbourNodesPosition::LEFT | NeighbourNodesPosition::RIGHT,
+    NeighbourNodesPosition::TOP_LEFT | NeighbourNodesPosition::RIGHT | NeighbourNodesPosition::BOTTOM,
+    NeighbourNodesPosition::TOP_RIGHT | NeighbourNodesPosition::LEFT | NeighbourNodesPosition::BOTTOM,
+    NeighbourNodesPosition::BOTTOM_LEFT | NeighbourNodesPosition::RIGHT | NeighbourNodesPosition::TOP,
+    NeighbourNodesPosition::BOTTOM_RIGHT | NeighbourNodesPosition::LEFT | NeighbourNodesPosition::TOP};
+
+static bool requiresElevation(unsigned char elevationBitmask)
+{
+  for (const auto &elBitMask : elevateTileComb)
+  {
+    if ((elevationBitmask & elBitMask) == elBitMask)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 void Map::updateNodeNeighbors(std::vector<MapNode *> &nodes)
 {
-  // those bitmask combinations require the tile to be elevated.
-  constexpr unsigned char elevateTileComb[] = {
-      NeighbourNodesPosition::TOP | NeighbourNodesPosition::BOTTOM,
-      NeighbourNodesPosition::LEFT | NeighbourNodesPosition::RIGHT,
-      NeighbourNodesPosition::TOP_LEFT | NeighbourNodesPosition::RIGHT | NeighbourNodesPosition::BOTTOM,
-      NeighbourNodesPosition::TOP_RIGHT | NeighbourNodesPosition::LEFT | NeighbourNodesPosition::BOTTOM,
-      NeighbourNodesPosition::BOTTOM_LEFT | NeighbourNodesPosition::RIGHT | NeighbourNodesPosition::TOP,
-      NeighbourNodesPosition::BOTTOM_RIGHT | NeighbourNodesPosition::LEFT | NeighbourNodesPosition::TOP};
-
-  std::unordered_set<MapNode *> nodesToBeUpdated;
-  std::map<MapNode *, std::vector<NeighborNode>> nodeCache;
-  std::queue<MapNode *> nodesUpdatedHeight;
-  std::vector<MapNode *> nodesToElevate;
-  std::unordered_set<MapNode *> nodesToDemolish;
+  settleNodeHeights(nodes);
+  demolishChangedNodes();
+
+  for (int index : m_nodesToBeUpdated)
+  {
+    mapNodes[index].setAutotileBitMask(calculateAutotileBitmask(&mapNodes[index], getNeighborNodes(index)));
+  }
+
+  for (int index : m_nodesToBeUpdated)
+  {
+    markNodeChanged(mapNodes[index].getCoordinates());
+    mapNodes[index].updateTexture();
+  }
+}
+
+void Map::settleNodeHeights(std::vector<MapNode *> &nodes)
+{
+  // the work buffers are reused for every call, starting a new epoch empties all sets of marked nodes
+  m_nodesToBeUpdatedMarks.nextEpoch();
+  m_nodesToElevateMarks.nextEpoch();
+  m_nodesToDemolishMarks.nextEpoch();
+  m_nodesToBeUpdated.clear();
+  m_nodesToElevate.clear();
+  m_nodesToDemolish.clear();
 
   for (auto &pUpdateNode : nodes)
   {
-    nodesUpdatedHeight.push(pUpdateNode);
+    // FIFO queue, a node can be queued more than once
+    m_nodesUpdatedHeight.clear();
+    size_t queueFront = 0;
+    m_nodesUpdatedHeight.push_back(pUpdateNode->getIndex());
 
-    while (!nodesUpdatedHeight.empty() || !nodesToElevate.empty())
+    while (queueFront < m_nodesUpdatedHeight.size() || !m_nodesToElevate.empty())
     {
-      while (!nodesUpdatedHeight.empty())
+      while (queueFront < m_nodesUpdatedHeight.size())
       {
-        const auto pHeighChangedNode = nodesUpdatedHeight.front();
-        nodesUpdatedHeight.pop();
-        const int tileHeight = pHeighChangedNode->getCoordinates().height;
-
-        if (nodeCache.count(pHeighChangedNode) == 0)
-        {
-          nodeCache[pHeighChangedNode] = getNeighborNodes(pHeighChangedNode->getCoordinates(), false);
-        }
+        const int heightChangedIdx = m_nodesUpdatedHeight[queueFront++];
+        // the neighbors of the node may change their height, which depends on their own neighbors
+        waitForDecodedRows(heightChangedIdx / m_columns - 2, heightChangedIdx / m_columns + 2);
+        const int tileHeight = mapNodes[heightChangedIdx].getCoordinates().height;
 
-        if (std::find(nodesToElevate.begin(), nodesToElevate.end(), pHeighChangedNode) == nodesToElevate.end())
+        if (m_nodesToElevateMarks.tryMark(heightChangedIdx))
         {
-          nodesToElevate.push_back(pHeighChangedNode);
+          m_nodesToElevate.push_back(heightChangedIdx);
         }
 
-        for (const auto &neighbour : nodeCache[pHeighChangedNode])
+        for (const auto &neighbour : getNeighborNodes(heightChangedIdx))
         {
-          const auto pNode = neighbour.pNode;
-          const auto &nodeCoordinate = pNode->getCoordinates();
-          const int heightDiff = tileHeight - nodeCoordinate.height;
+          MapNode *const pNode = neighbour.pNode;
+          const int neighborIdx = pNode->getIndex();
+          const int heightDiff = tileHeight - pNode->getCoordinates().height;
 
-          if (nodeCache.count(pNode) == 0)
+          if (m_nodesToElevateMarks.tryMark(neighborIdx))
           {
-            nodeCache[pNode] = getNeighborNodes(pNode->getCoordinates(), false);
-          }
-
-          if (std::find(nodesToElevate.begin(), nodesToElevate.end(), pNode) == nodesToElevate.end())
-          {
-            nodesToElevate.push_back(pNode);
+            m_nodesToElevate.push_back(neighborIdx);
           }
 
           if (std::abs(heightDiff) > 1)
           {
-            nodesUpdatedHeight.push(pNode);
-            updateHeight(*pNode, (heightDiff > 1) ? true : false, nodeCache[pNode]);
+            m_nodesUpdatedHeight.push_back(neighborIdx);
+            updateHeight(*pNode, (heightDiff > 1) ? true : false, getNeighborNodes(neighborIdx));
           }
         }
       }
 
-      while (nodesUpdatedHeight.empty() && !nodesToElevate.empty())
+      while (queueFront == m_nodesUpdatedHeight.size() && !m_nodesToElevate.empty())
       {
-        MapNode *pEleNode = nodesToElevate.back();
-        nodesToBeUpdated.insert(pEleNode);
-        nodesToElevate.pop_back();
+        const int eleNodeIdx = m_nodesToElevate.back();
+        waitForDecodedRows(eleNodeIdx / m_columns - 1, eleNodeIdx / m_columns + 1);
+        MapNode &eleNode = mapNodes[eleNodeIdx];
+        m_nodesToElevate.pop_back();
+        m_nodesToElevateMarks.unmark(eleNodeIdx);
 
-        if (nodeCache.count(pEleNode) == 0)
+        if (m_nodesToBeUpdatedMarks.tryMark(eleNodeIdx))
         {
-          nodeCache[pEleNode] = getNeighborNodes(pEleNode->getCoordinates(), false);
+          m_nodesToBeUpdated.push_back(eleNodeIdx);
         }
 
-        const unsigned char elevationBitmask = getElevatedNeighborBitmask(pEleNode->getCoordinates());
+        const unsigned char elevationBitmask = getElevatedNeighborBitmask(eleNode.getCoordinates());
 
-        if (elevationBitmask != pEleNode->getElevationBitmask())
+        if (elevationBitmask != eleNode.getElevationBitmask())
         {
-          nodesToDemolish.insert(pEleNode);
-          pEleNode->setElevationBitMask(elevationBitmask);
+          if (m_nodesToDemolishMarks.tryMark(eleNodeIdx))
+          {
+            m_nodesToDemolish.push_back(eleNodeIdx);
+          }
+          eleNode.setElevationBitMask(elevationBitmask);
         }
 
-        for (const auto &elBitMask : elevateTileComb)
+        if (requiresElevation(elevationBitmask))
         {
-          if ((elevationBitmask & elBitMask) == elBitMask)
-          {
-            updateHeight(*pEleNode, true, nodeCache[pEleNode]);
-            nodesUpdatedHeight.push(pEleNode);
-            break;
-          }
+          updateHeight(eleNode, true, getNeighborNodes(eleNodeIdx));
+          m_nodesUpdatedHeight.push_back(eleNodeIdx);
         }
       }
     }
   }
+}
 
-  if (!nodesToDemolish.empty())
+void Map::demolishChangedNodes()
+{
+  if (!m_nodesToDemolish.empty())
   {
-    std::vector<Point> nodesToDemolishV(nodesToDemolish.size());
-    std::transform(nodesToDemolish.begin(), nodesToDemolish.end(), nodesToDemolishV.begin(),
-                   [](MapNode *mn) { return mn->getCoordinates(); });
+    std::vector<Point> nodesToDemolishV(m_nodesToDemolish.size());
+    std::transform(m_nodesToDemolish.begin(), m_nodesToDemolish.end(), nodesToDemolishV.begin(),
+                   [this](int index) { return mapNodes[index].getCoordinates(); });
     demolishNode(nodesToDemolishV);
   }
+}
 
-  for (auto pNode : nodesToBeUpdated)
+bool Map::areNodeHeightsSettled(size_t begin, size_t end)
+{
+  std::atomic<bool> isSettled = true;
+
+  parallelFor(begin, end,
+              [this, &isSettled](size_t index)
+              {
+                const Point coordinates = mapNodes[index].getCoordinates();
+                for (const auto &neighbor : getNeighborNodes(static_cast<int>(index)))
+                {
+                  if (std::abs(coordinates.height - neighbor.pNode->getCoordinates().height) > 1)
+                  {
+                    isSettled.store(false, std::memory_order_relaxed);
+                    return;
+                  }
+                }
+                if (requiresElevation(getElevatedNeighborBitmask(coordinates)))
+                {
+                  isSettled.store(false, std::memory_order_relaxed);
+                }
+              });
+
+  return isSettled;
+}
+
+void Map::updateAllNodes(bool inParallel)
+{
+  loadAllNodes();
+
+  // every node may have changed, it's cheaper to recolor the whole minimap than to collect the nodes
+  m_minimap.markAllDirty();
+
+  if (!inParallel)
   {
-    pNode->setAutotileBitMask(calculateAutotileBitmask(pNode, nodeCache[pNode]));
+    updateNodeNeighbors(mapNodesInDrawingOrder);
+    return;
   }
 
-  for (auto pNode : nodesToBeUpdated)
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Update all nodes", MP_YELLOW);
+#endif
+
+  for (const MapNode &mapNode : mapNodes)
   {
-    pNode->updateTexture();
+    markNodeChanged(mapNode.getCoordinates());
   }
+
+  if (areNodeHeightsSettled(0, mapNodes.size()))
+  {
+    // no node will change its height, so the elevation bitmasks only depend on the current heights
+    std::vector<uint8_t> elevationChanged(mapNodes.size(), 0);
+    parallelFor(0, mapNodes.size(),
+                [this, &elevationChanged](size_t index)
+                {
+                  MapNode &mapNode = mapNodes[index];
+                  const unsigned char elevationBitmask = getElevatedNeighborBitmask(mapNode.getCoordinates());
+                  elevationChanged[index] = (elevationBitmask != mapNode.getElevationBitmask());
+                  mapNode.setElevationBitMask(elevationBitmask);
+                });
+
+    m_nodesToDemolish.clear();
+    for (int index = 0; index < static_cast<int>(mapNodes.size()); ++index)
+    {
+      if (elevationChanged[index])
+      {
+        m_nodesToDemolish.push_back(index);
+      }
+    }
+  }
+  else
+  {
+    // settling the heights depends on the order of the nodes, this has to be done one node after another
+    settleNodeHeights(mapNodesInDrawingOrder);
+  }
+  demolishChangedNodes();
+
+  // the autotile bitmasks depend on the tiles of the neighbors, which can change while updating the textures, so
+  // all bitmasks must be calculated first
+  parallelFor(0, mapNodes.size(),
+              [this](size_t index)
+              {
+                MapNode &mapNode = mapNodes[index];
+                mapNode.setAutotileBitMask(calculateAutotileBitmask(&mapNode, getNeighborNodes(static_cast<int>(index))));
+              });
+  parallelFor(0, mapNodes.size(), [this](size_t index) { mapNodes[index].updateTexture(); });
 }
 
-void Map::updateAllNodes() { updateNodeNeighbors(mapNodesInDrawingOrder); }
+bool Map::isPlacementOnNodeAllowed(const Point &isoCoordinates, const std::string &tileID)
+{
+  return isPlacementOnNodeAllowed(isoCoordinates, TileManager::instance().getTileId(tileID));
+}
 
-bool Map::isPlacementOnNodeAllowed(const Point &isoCoordinates, const std::string &tileID) const
+bool Map::isPlacementOnNodeAllowed(const Point &isoCoordinates, TileId tileId)
 {
-  return mapNodes[nodeIdx(isoCoordinates.x, isoCoordinates.y)].isPlacementAllowed(tileID);
+  loadRows(isoCoordinates.x, isoCoordinates.x);
+  return mapNodes[nodeIdx(isoCoordinates.x, isoCoordinates.y)].isPlacementAllowed(tileId);
 }
 
 unsigned char Map::getElevatedNeighborBitmask(Point centerCoordinates)
@@ -290,12 +488,19 @@ unsigned char Map::getElevatedNeighborBitmask(Point centerCoordinates)
   unsigned char bitmask = 0;
   const auto centralNodeHeight = getMapNode(centerCoordinates).getCoordinates().height;
 
-  for (const auto &neighborCoordinates : PointFunctions::getNeighbors(centerCoordinates, false))
+  for (const auto &offset : neighborOffsets)
   {
-    if (getMapNode(neighborCoordinates).getCoordinates().height > centralNodeHeight)
+    const int neighborX = centerCoordinates.x + offset.x;
+    const int neighborY = centerCoordinates.y + offset.y;
+
+    if (neighborX < 0 || neighborX >= m_rows || neighborY < 0 || neighborY >= m_columns)
     {
-      bitmask |= PointFunctions::getNeighborPositionToOrigin(neighborCoordinates, centerCoordinates);
+      continue;
     }
+
+    // the central node is never higher than itself, so it doesn't need to be skipped
+    const bool isHigher = mapNodes[nodeIdx(neighborX, neighborY)].getCoordinates().height > centralNodeHeight;
+    bitmask |= isHigher * offset.position;
   }
 
   return bitmask;
@@ -311,13 +516,14 @@ Point Map::getNodeOrigCornerPoint(const Point &isoCoordinates, Layer layer)
   return Point::INVALID();
 }
 
-std::vector<uint8_t> Map::calculateAutotileBitmask(const MapNode *const pMapNode, const std::vector<NeighborNode> &neighborNodes)
+std::array<uint8_t, LAYERS_COUNT> Map::calculateAutotileBitmask(const MapNode *const pMapNode,
+                                                                const NeighborNodes &neighborNodes)
 {
-  std::vector<uint8_t> tileOrientationBitmask(LAYERS_COUNT, 0);
+  std::array<uint8_t, LAYERS_COUNT> tileOrientationBitmask{};
 
   for (auto currentLayer : allLayersOrdered)
   {
-    auto pCurrentTileData = pMapNode->getMapNodeDataForLayer(currentLayer).tileData;
+    auto pCurrentTileData = pMapNode->getTileData(currentLayer);
 
     if (pCurrentTileData)
     {
@@ -325,7 +531,7 @@ std::vector<uint8_t> Map::calculateAutotileBitmask(const MapNode *const pMapNode
       {
         for (const auto &neighbour : neighborNodes)
         {
-          const auto pTileData = neighbour.pNode->getMapNodeDataForLayer(Layer::WATER).tileData;
+          const auto pTileData = neighbour.pNode->getTileData(Layer::WATER);
 
           if (pTileData && pTileData->tileType == +TileType::WATER)
           {
@@ -335,14 +541,13 @@ std::vector<uint8_t> Map::calculateAutotileBitmask(const MapNode *const pMapNode
       }
 
       // only auto-tile categories that can be tiled.
-      const std::string& nodeTileId = pMapNode->getMapNodeDataForLayer(currentLayer).tileID;
+      const TileId nodeTileId = pMapNode->getTileId(currentLayer);
       if (TileManager::instance().isTileIDAutoTile(nodeTileId))
       {
         for (const auto &neighbour : neighborNodes)
         {
-          const MapNodeData &nodeData = neighbour.pNode->getMapNodeDataForLayer(currentLayer);
-
-          if (nodeData.tileData && ((nodeData.tileID == nodeTileId) || (pCurrentTileData->tileType == +TileType::ROAD)))
+          if (neighbour.pNode->isLayerOccupied(currentLayer) &&
+              ((neighbour.pNode->getTileId(currentLayer) == nodeTileId) || (pCurrentTileData->tileType == +TileType::ROAD)))
           {
             tileOrientationBitmask[currentLayer] |= neighbour.position;
           }
@@ -354,16 +559,81 @@ std::vector<uint8_t> Map::calculateAutotileBitmask(const MapNode *const pMapNode
   return tileOrientationBitmask;
 }
 
-void Map::renderMap() const
+void Map::renderMap(RenderSnapshot &snapshot)
 {
 #ifdef MICROPROFILE_ENABLED
   MICROPROFILE_SCOPEI("Map", "Render Map", MP_YELLOW);
 #endif
 
-  for (int i = 0; i < m_visibleNodesCount; ++i)
+  // the nodes on screen are loaded before they're drawn, the rest of a lazily loaded savegame one chunk per frame
+  loadVisibleNodes();
+  loadNextChunk();
+
+  // nodes changed since the last refresh, their sprites and the visible area need an update
+  if (m_chunks.hasDirtyChunks())
   {
-    pMapNodesVisible[i]->render();
+    refresh();
   }
+
+  SDL_Renderer *renderer = WindowManager::instance().getRenderer();
+  const unsigned int activeLayers = MapLayers::getActiveLayers();
+
+  // everything on screen moves when the camera moves, and all nodes change when other layers are shown
+  const Camera &camera = Camera::instance();
+  const LayerEditMode layerEditMode = GameStates::instance().layerEditMode;
+  if (camera.cameraOffset().x != m_renderedCameraOffset.x || camera.cameraOffset().y != m_renderedCameraOffset.y ||
+      camera.zoomLevel() != m_renderedZoomLevel || activeLayers != m_renderedLayers ||
+      layerEditMode != m_renderedLayerEditMode)
+  {
+    m_damage.invalidate();
+    m_renderedCameraOffset = camera.cameraOffset();
+    m_renderedZoomLevel = camera.zoomLevel();
+    m_renderedLayers = activeLayers;
+    m_renderedLayerEditMode = layerEditMode;
+  }
+  snapshot.getDamage() = takeDamage();
+
+  // when zoomed far out, the details of the sprites aren't visible anyway
+  if (Camera::instance().zoomLevel() < Settings::instance().overviewZoomLevel)
+  {
+    m_overview.update(renderer, m_chunks, m_grid, activeLayers);
+
+    if (m_overview.isAvailable())
+    {
+      m_spriteBatcher.begin(snapshot);
+      m_overview.draw(m_spriteBatcher);
+      m_spriteBatcher.end();
+      m_renderStats = m_spriteBatcher.getStats();
+      m_occludedQuads = 0;
+      return;
+    }
+  }
+
+  // the cached chunks are render targets, the software rasterizer can't draw from them
+  const bool useTerrainCache = Settings::instance().cacheStaticTerrain && !Settings::instance().useSoftwareRasterizer() &&
+                               (activeLayers & TerrainChunkCache::cachedLayers);
+
+  if (useTerrainCache)
+  {
+    m_terrainCache.update(renderer, m_chunks, m_grid, activeLayers);
+  }
+  else
+  {
+    m_terrainCache.clear();
+  }
+
+  m_spriteBatcher.begin(snapshot);
+
+  if (useTerrainCache)
+  {
+    // the static layers of all cached chunks are drawn first, everything else is drawn node by node on top of them
+    m_terrainCache.draw(m_spriteBatcher, m_chunks);
+  }
+  m_occludedQuads =
+      m_drawLists.draw(m_spriteBatcher, activeLayers, useTerrainCache ? &m_terrainCache : nullptr, m_chunks);
+
+  m_spriteBatcher.end();
+  m_renderStats = m_spriteBatcher.getStats();
 }
 
 void Map::refresh()
@@ -372,29 +642,78 @@ void Map::refresh()
   MICROPROFILE_SCOPEI("Map", "Refresh Map", MP_YELLOW);
 #endif
 
+  loadVisibleNodes();
+
+  // the geometry of all tile spritesheets is scaled once per zoom level and shared by the sprites of all nodes
+  TileManager::instance().setSpriteZoomLevel(Camera::instance().zoomLevel());
+
+  // sprites are positioned in world coordinates, so only chunks that changed or that are shown with a new zoom level
+  // need to be refreshed, moving the camera only changes which chunks are visible.
+  // the screen changes where the sprites of changed nodes have been before they changed, which has been added to the
+  // damage when they were marked, and where they are after the refresh
+  m_chunks.refreshDirtyChunks(m_grid);
   calculateVisibleMap();
+  m_drawLists.build(pMapNodesVisible, m_visibleNodesCount, m_grid);
+  damageChangedNodes();
+  m_changedNodes.clear();
+}
 
-  for (int i = 0; i < m_visibleNodesCount; ++i)
+void Map::markNodeChanged(const Point &isoCoordinates)
+{
+  m_chunks.markDirty(isoCoordinates);
+
+  // every change of a node is drawn, so the nodes for the autosave journal are collected here as well. Loading nodes
+  // from a savegame doesn't change them
+  const int index = nodeIdx(isoCoordinates.x, isoCoordinates.y);
+  if (!m_isLoadingChunks && m_unsavedNodeMarks.tryMark(index))
   {
-    pMapNodesVisible[i]->refresh();
+    m_unsavedNodes.push_back(index);
   }
+
+  // e.g. when a map is loaded, it's cheaper to redraw everything than to look at every node
+  constexpr size_t maxChangedNodes = 4096;
+  if (m_damage.isFull())
+  {
+    return;
+  }
+  if (m_changedNodes.size() >= maxChangedNodes)
+  {
+    m_damage.invalidate();
+    m_changedNodes.clear();
+    return;
+  }
+  // the node hasn't changed yet, so its sprite is still where it has been drawn
+  invalidateNode(isoCoordinates);
+  m_changedNodes.push_back(isoCoordinates);
 }
 
-//TODO: move it out from the map
-SDL_Color Map::getColorOfPixelInSurface(SDL_Surface *surface, int x, int y) const
+void Map::damageChangedNodes()
 {
-  SDL_Color Color{0, 0, 0, SDL_ALPHA_TRANSPARENT};
-
-  if (surface)
+  for (const Point &isoCoordinates : m_changedNodes)
   {
-    const int bpp = surface->format->BytesPerPixel;
-    Uint8 *p = &static_cast<Uint8 *>(surface->pixels)[y * surface->pitch + x * bpp];
-    const Uint32 pixel = *reinterpret_cast<Uint32 *>(p);
+    invalidateNode(isoCoordinates);
+  }
+}
 
-    SDL_GetRGBA(pixel, surface->format, &Color.r, &Color.g, &Color.b, &Color.a);
+void Map::invalidateNode(const Point &isoCoordinates)
+{
+  if (m_damage.isFull() || !isoCoordinates.isWithinMapBoundaries())
+  {
+    return;
   }
 
-  return Color;
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+  SDL_Rect rect = m_grid.sprite(m_grid.nodeIdx(isoCoordinates.x, isoCoordinates.y)).getWorldBoundingBox();
+  rect.x -= cameraOffset.x;
+  rect.y -= cameraOffset.y;
+  m_damage.add(rect);
+}
+
+DamageRegion Map::takeDamage()
+{
+  DamageRegion damage = m_damage;
+  m_damage.clear();
+  return damage;
 }
 
 Point Map::findNodeInMap(const SDL_Point &screenCoordinates, const Layer &layer)
@@ -434,8 +753,15 @@ Point Map::findNodeInMap(const SDL_Point &screenCoordinates, const Layer &layer)
     // Move y up and down 2 neighbors.
     for (int y = std::max(yMiddlePoint - neighborReach, 0); (y <= yMiddlePoint + neighborReach) && (y < mapSize); ++y)
     {
+      // nodes that haven't been loaded yet have no sprite that could be clicked
+      const int index = nodeIdx(x, y);
+      if (!isNodeLoaded(index))
+      {
+        continue;
+      }
+
       //get all coordinates for node at x,y
-      Point coordinate = getMapNode(Point(x, y)).getCoordinates();
+      Point coordinate = mapNodes[index].getCoordinates();
 
       if (isClickWithinTile(screenCoordinates, coordinate, layer))
       {
@@ -449,6 +775,11 @@ Point Map::findNodeInMap(const SDL_Point &screenCoordinates, const Layer &layer)
 
 void Map::demolishNode(const std::vector<Point> &isoCoordinates, bool updateNeighboringTiles, Layer layer)
 {
+  for (const Point &isoCoord : isoCoordinates)
+  {
+    loadRows(isoCoord.x - editReachRows, isoCoord.x + editReachRows);
+  }
+
   std::unordered_set<MapNode *> nodesToDemolish;
 
   for (auto &isoCoord : isoCoordinates)
@@ -460,7 +791,7 @@ void Map::demolishNode(const std::vector<Point> &isoCoordinates, bool updateNeig
       // Check for multi-node buildings first. Those are on the buildings layer, even if we want to demolish another layer than Buildings.
       // In case we add more Layers that support Multi-node, add a for loop here
       // If demolishNode is called for layer GROUNDECORATION, we'll still need to gather all nodes from the multi-node building to delete the decoration under the entire building
-      auto pNodeTileData = node.getMapNodeDataForLayer(Layer::BUILDINGS).tileData;
+      auto pNodeTileData = node.getTileData(Layer::BUILDINGS);
 
       if (pNodeTileData && ((pNodeTileData->RequiredTiles.height > 1) || (pNodeTileData->RequiredTiles.width > 1)))
       {
@@ -468,10 +799,10 @@ void Map::demolishNode(const std::vector<Point> &isoCoordinates, bool updateNeig
 
         if (origCornerPoint.isWithinMapBoundaries())
         {
-          const std::string &tileID = getMapNode(origCornerPoint).getTileID(Layer::BUILDINGS);
+          const TileId tileId = getMapNode(origCornerPoint).getTileId(Layer::BUILDINGS);
 
           // get all the occupied nodes and demolish them
-          for (auto buildingCoords : TileManager::instance().getTargetCoordsOfTileID(origCornerPoint, tileID))
+          for (auto buildingCoords : TileManager::instance().getTargetCoordsOfTileID(origCornerPoint, tileId))
           {
             nodesToDemolish.insert(&mapNodes[nodeIdx(buildingCoords.x, buildingCoords.y)]);
           }
@@ -485,6 +816,7 @@ void Map::demolishNode(const std::vector<Point> &isoCoordinates, bool updateNeig
   std::vector<MapNode *> updateNodes;
   for (auto pNode : nodesToDemolish)
   {
+    markNodeChanged(pNode->getCoordinates());
     pNode->demolishNode(layer);
     signalDemolish.emit(pNode);
     // TODO: Play sound effect here
@@ -509,21 +841,17 @@ bool Map::isClickWithinTile(const SDL_Point &screenCoordinates, Point isoCoordin
 
   auto &node = mapNodes[nodeIdx(isoCoordinate.x, isoCoordinate.y)];
   auto pSprite = node.getSprite();
-  std::vector<Layer> layersToGoOver;
 
   // Layers ordered for hitcheck
-  if (layer == Layer::NONE)
-  {
-    Layer layers[] = {Layer::TERRAIN, Layer::WATER, Layer::UNDERGROUND, Layer::BLUEPRINT};
-    layersToGoOver.insert(layersToGoOver.begin(), std::begin(layers), std::end(layers));
-  }
-  else
-  {
-    layersToGoOver.push_back(layer);
-  }
+  static constexpr Layer defaultLayers[] = {Layer::TERRAIN, Layer::WATER, Layer::UNDERGROUND, Layer::BLUEPRINT};
+  const Layer *layersBegin = (layer == Layer::NONE) ? std::begin(defaultLayers) : &layer;
+  const Layer *layersEnd = (layer == Layer::NONE) ? std::end(defaultLayers) : &layer + 1;
+  const double zoomLevel = Camera::instance().zoomLevel();
 
-  for (auto &curLayer : layersToGoOver)
+  for (const Layer *pLayer = layersBegin; pLayer != layersEnd; ++pLayer)
   {
+    const Layer curLayer = *pLayer;
+
     if (!MapLayers::isLayerActive(curLayer))
     {
       continue;
@@ -539,21 +867,20 @@ bool Map::isClickWithinTile(const SDL_Point &screenCoordinates, Point isoCoordin
 
     if (SDL_PointInRect(&screenCoordinates, &spriteRect))
     {
-      std::string tileID = node.getMapNodeDataForLayer(curLayer).tileID;
-      assert(!tileID.empty());
+      const TileId tileId = node.getTileId(curLayer);
+      assert(tileId != EMPTY_TILE_ID);
 
-      // Calculate the position of the clicked pixel within the surface and "un-zoom" the position to match the un-adjusted surface
-      const int pixelX = static_cast<int>((screenCoordinates.x - spriteRect.x) / Camera::instance().zoomLevel()) + clipRect.x;
-      const int pixelY = static_cast<int>((screenCoordinates.y - spriteRect.y) / Camera::instance().zoomLevel()) + clipRect.y;
+      // Calculate the position of the clicked pixel within the spritesheet and "un-zoom" it to match the un-adjusted spritesheet
+      const int pixelX = static_cast<int>((screenCoordinates.x - spriteRect.x) / zoomLevel) + clipRect.x;
+      const int pixelY = static_cast<int>((screenCoordinates.y - spriteRect.y) / zoomLevel) + clipRect.y;
 
-      if ((curLayer == Layer::TERRAIN) && (node.getMapNodeDataForLayer(Layer::TERRAIN).tileMap == TileMap::SHORE))
-      {
-        tileID.append("_shore");
-      }
+      const TileMap tileMap = ((curLayer == Layer::TERRAIN) && (node.getTileMap(Layer::TERRAIN) == TileMap::SHORE))
+                                  ? TileMap::SHORE
+                                  : TileMap::DEFAULT;
 
       // Check if the clicked Sprite is not transparent (we hit a point within the pixel)
-      if (getColorOfPixelInSurface(ResourcesManager::instance().getTileSurface(tileID), pixelX, pixelY).a !=
-          SDL_ALPHA_TRANSPARENT)
+      const HitMask *hitMask = TileManager::instance().getHitMask(tileId, tileMap);
+      if (hitMask && hitMask->isOpaque(pixelX, pixelY))
       {
         return true;
       }
@@ -569,8 +896,13 @@ void Map::highlightNode(const Point &isoCoordinates, const SpriteRGBColor &rgbCo
   if (isoCoordinates.isWithinMapBoundaries())
   {
     const auto pSprite = getMapNode(isoCoordinates).getSprite();
-    pSprite->highlightColor = rgbColor;
-    pSprite->highlightSprite = true;
+    const SpriteRGBColor &color = pSprite->highlightColor;
+    if (!pSprite->highlightSprite || color.r != rgbColor.r || color.g != rgbColor.g || color.b != rgbColor.b)
+    {
+      pSprite->highlightColor = rgbColor;
+      pSprite->highlightSprite = true;
+      invalidateNode(isoCoordinates);
+    }
   }
 }
 
@@ -579,84 +911,661 @@ std::string Map::getTileID(const Point &isoCoordinates, Layer layer)
   return (isoCoordinates.isWithinMapBoundaries()) ? getMapNode(isoCoordinates).getTileID(layer) : "";
 }
 
+TileId Map::getTileId(const Point &isoCoordinates, Layer layer)
+{
+  return (isoCoordinates.isWithinMapBoundaries()) ? getMapNode(isoCoordinates).getTileId(layer) : EMPTY_TILE_ID;
+}
+
 void Map::unHighlightNode(const Point &isoCoordinates)
 {
   if (isoCoordinates.isWithinMapBoundaries())
   {
-    getMapNode(isoCoordinates).getSprite()->highlightSprite = false;
+    Sprite *pSprite = getMapNode(isoCoordinates).getSprite();
+    if (pSprite->highlightSprite)
+    {
+      pSprite->highlightSprite = false;
+      invalidateNode(isoCoordinates);
+    }
   }
 }
 
-void Map::saveMapToFile(const std::string &fileName)
+namespace
+{
+void checkSaveGameVersion(size_t saveGameVersion)
 {
-  //create savegame json string
-  const json j =
-      json{{"Savegame version", SAVEGAME_VERSION}, {"columns", this->m_columns}, {"rows", this->m_rows}, {"mapNode", mapNodes}};
+  if (saveGameVersion != SAVEGAME_VERSION)
+  {
+    /* @todo Check savegame version for compatibility and add upgrade functions here later if needed */
+    throw CytopiaError(TRACE_INFO "Trying to load a Savegame with version " + std::to_string(saveGameVersion) +
+                       " but only save-games with version " + std::to_string(SAVEGAME_VERSION) + " are supported");
+  }
+}
 
-#ifdef DEBUG
-  // Write uncompressed savegame for easier debugging
-  fs::writeStringToFile(fileName + ".txt", j.dump());
-#endif
+/// Check the saved height and origin corner of a node, the origin corner is -1 if there is none
+bool isValidNodeData(uint8_t height, int32_t origCornerIndex, int nodeCount)
+{
+  return height <= MapNode::maxHeight && origCornerIndex >= -1 && origCornerIndex < nodeCount;
+}
+
+/// Keep only the latest state of every node of the journal, sorted by node index
+SaveGameJournal::Batch latestJournalChanges(const SaveGameJournal::Batch &journal)
+{
+  std::vector<size_t> positions(journal.size());
+  std::iota(positions.begin(), positions.end(), 0);
+  std::stable_sort(positions.begin(), positions.end(), [&journal](size_t a, size_t b)
+                   { return journal.nodeIndices[a] < journal.nodeIndices[b]; });
+
+  SaveGameJournal::Batch latestChanges;
+  for (size_t i = 0; i < positions.size(); ++i)
+  {
+    // later batches come later in a run of the same node
+    if (i + 1 == positions.size() || journal.nodeIndices[positions[i]] != journal.nodeIndices[positions[i + 1]])
+    {
+      latestChanges.addNode(journal, positions[i]);
+    }
+  }
+  return latestChanges;
+}
+
+/// Write a saved layer of a node into the grid, like MapNode::setMapNodeData without touching the sprite of the node
+void setSavedLayer(MapGrid &grid, Layer layer, int index, TileId tileId, uint16_t tileIndex, int32_t origCornerIndex)
+{
+  grid.tileId(layer, index) = tileId;
+  grid.tileIndex(layer, index) = tileIndex;
+  grid.origCornerIndex(layer, index) = origCornerIndex;
+  grid.setShouldRender(layer, index, origCornerIndex == index);
+}
+
+/// Get the first and the last row a savegame chunk covers
+std::pair<int, int> getChunkRows(const BinarySaveGame::ChunkLocation &location, int columns)
+{
+  const int firstNode = static_cast<int>(location.firstNode);
+  return {firstNode / columns, (firstNode + static_cast<int>(location.nodeCount) - 1) / columns};
+}
+} // namespace
 
-  const std::string compressedSaveGame = compressString(j.dump());
+void Map::saveMapToFile(const std::string &fileName, SaveGameFormat format)
+{
+  createSaveGameSnapshot().saveToFile(fs::getBasePath() + fileName, format);
+}
 
-  if (!compressedSaveGame.empty())
+SaveGameJournal::Batch Map::takeUnsavedChanges()
+{
+  SaveGameJournal::Batch batch;
+  for (int index : m_unsavedNodes)
   {
-    fs::writeStringToFile(fileName, compressedSaveGame, true);
+    batch.addNode(m_grid, index);
   }
+  markChangesSaved();
+  return batch;
+}
+
+void Map::markChangesSaved()
+{
+  m_unsavedNodeMarks.nextEpoch();
+  m_unsavedNodes.clear();
 }
 
 Map *Map::loadMapFromFile(const std::string &fileName)
 {
-  std::string jsonAsString = decompressString(fs::readFileAsString(fileName, true));
+  const std::string filePath = fs::getBasePath() + fileName;
+  std::ifstream stream(filePath, std::ios_base::in | std::ios_base::binary);
+
+  if (!stream)
+  {
+    throw ConfigurationError(TRACE_INFO "Can't open file " + fileName);
+  }
+
+  if (BinarySaveGame::isBinarySaveGame(stream))
+  {
+    stream.close();
+    // the nodes are brought up to date chunk by chunk when they're needed, instead of with updateAllNodes
+    return loadBinaryMap(filePath);
+  }
 
-  if (jsonAsString.empty())
-    return nullptr;
+  InflateStreamBuf inflateBuffer(stream);
+  std::istream decompressedStream(&inflateBuffer);
+  std::unique_ptr<Map> map(loadJsonMap(decompressedStream));
+  stream.close();
 
-  json saveGameJSON = json::parse(jsonAsString, nullptr, false);
+  map->replayJournal(filePath);
+  map->updateAllNodes();
+  // the loaded map is the saved state
+  map->markChangesSaved();
 
-  if (saveGameJSON.is_discarded())
-    throw ConfigurationError(TRACE_INFO "Could not parse savegame file " + fileName);
+  return map.release();
+}
 
-  size_t saveGameVersion = saveGameJSON.value("Savegame version", 0);
+void Map::readJournal(const std::string &saveGamePath,
+                      const std::function<void(const SaveGameJournal::Batch &, const std::vector<TileId> &)> &applyBatch)
+{
+  const std::string journalPath = SaveGameJournal::journalPath(saveGamePath);
+  std::ifstream stream(journalPath, std::ios_base::in | std::ios_base::binary);
 
-  if (saveGameVersion != SAVEGAME_VERSION)
+  if (!stream)
   {
-    /* @todo Check savegame version for compatibility and add upgrade functions here later if needed */
-    throw CytopiaError(TRACE_INFO "Trying to load a Savegame with version " + std::to_string(saveGameVersion) +
-                       " but only save-games with version " + std::to_string(SAVEGAME_VERSION) + " are supported");
+    // only autosaves have a journal
+    return;
   }
 
-  int columns = saveGameJSON.value("columns", -1);
-  int rows = saveGameJSON.value("rows", -1);
+  try
+  {
+    SaveGameJournal::Reader reader(stream);
+    const SaveGameJournal::Header &header = reader.getHeader();
 
-  if (columns == -1 || rows == -1)
-    return nullptr;
+    if (header.columns != m_columns || header.rows != m_rows ||
+        header.baseChecksum != SaveGameJournal::fileChecksum(saveGamePath))
+    {
+      LOG(LOG_INFO) << "Ignoring the journal " << journalPath << ", it belongs to another version of the savegame";
+      return;
+    }
 
-  Map *map = new Map(columns, rows, false);
-  map->mapNodes.reserve(columns * rows);
+    // the tile handles of the journal might differ from the ones of the loaded tile data
+    std::vector<TileId> tileIds;
+    tileIds.reserve(reader.getTileIDs().size());
+    for (const std::string &tileID : reader.getTileIDs())
+    {
+      tileIds.push_back(TileManager::instance().getTileId(tileID));
+    }
+
+    SaveGameJournal::Batch batch;
+    int batchCount = 0;
+
+    while (reader.readBatch(batch))
+    {
+      // check the whole batch first, so a damaged batch isn't applied partially
+      for (size_t i = 0; i < batch.size(); ++i)
+      {
+        bool isDamaged = batch.nodeIndices[i] < 0 || batch.nodeIndices[i] >= m_grid.nodeCount();
+        for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+        {
+          isDamaged = isDamaged || batch.tileRefs[layer][i] >= tileIds.size() ||
+                      !isValidNodeData(batch.heights[i], batch.origCornerIndices[layer][i], m_grid.nodeCount());
+        }
+        if (isDamaged)
+        {
+          throw ConfigurationError(TRACE_INFO "Journal batch " + std::to_string(batchCount) + " is damaged");
+        }
+      }
 
-  for (const auto &it : saveGameJSON["mapNode"].items())
+      applyBatch(batch, tileIds);
+      ++batchCount;
+    }
+
+    LOG(LOG_INFO) << "Replayed " << batchCount << " batches of the journal " << journalPath;
+  }
+  catch (const ConfigurationError &error)
   {
-    Point coordinates = json(it.value())["coordinates"].get<Point>();
-    // set coordinates (height) of the map
-    map->mapNodes.emplace_back(MapNode{Point{coordinates.x, coordinates.y, coordinates.z, coordinates.height}, ""});
-    // load back mapNodeData (tileIDs, Buildins, ...)
-    map->mapNodes.back().setMapNodeData(json(it.value())["mapNodeData"], coordinates);
+    LOG(LOG_WARNING) << "Stopped replaying the journal " << journalPath << ": " << error.what();
   }
+}
+
+void Map::replayJournal(const std::string &saveGamePath)
+{
+  std::vector<MapNodeData> mapNodeData(LAYERS_COUNT);
+
+  readJournal(saveGamePath,
+              [this, &mapNodeData](const SaveGameJournal::Batch &batch, const std::vector<TileId> &tileIds)
+              {
+                for (size_t i = 0; i < batch.size(); ++i)
+                {
+                  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+                  {
+                    const int32_t origCornerIndex = batch.origCornerIndices[layer][i];
+
+                    MapNodeData &data = mapNodeData[layer];
+                    data.tileId = tileIds[batch.tileRefs[layer][i]];
+                    data.tileIndex = batch.tileIndices[layer][i];
+                    data.origCornerPoint =
+                        (origCornerIndex >= 0) ? m_grid.coordinates(origCornerIndex) : Point::INVALID();
+                  }
+
+                  MapNode &mapNode = mapNodes[batch.nodeIndices[i]];
+                  mapNode.initialize(batch.heights[i], "");
+                  mapNode.setMapNodeData(mapNodeData, mapNode.getCoordinates());
+                }
+              });
+}
 
-  // Now put those newly created nodes in correct drawing order
-  for (int x = 0; x < columns; x++)
+Map *Map::loadJsonMap(std::istream &stream)
+{
+  std::unique_ptr<Map> map;
+  std::vector<TileId> tileIds;
+  std::vector<MapNodeData> mapNodeData(LAYERS_COUNT);
+
+  JsonSaveGame::read(
+      stream,
+      [&map](const JsonSaveGame::Header &header) {
+        checkSaveGameVersion(header.saveGameVersion);
+        map = std::make_unique<Map>(header.columns, header.rows, false);
+      },
+      [&](const JsonSaveGame::Node &node, const std::vector<std::string> &tileIDs) {
+        const Point &coordinates = node.coordinates;
+        if (coordinates.x < 0 || coordinates.x >= map->m_rows || coordinates.y < 0 || coordinates.y >= map->m_columns)
+        {
+          throw ConfigurationError(TRACE_INFO "Savegame contains a node outside of the map");
+        }
+
+        // the tile handles of the savegame might differ from the ones of the loaded tile data
+        while (tileIds.size() < tileIDs.size())
+        {
+          tileIds.push_back(TileManager::instance().getTileId(tileIDs[tileIds.size()]));
+        }
+
+        for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+        {
+          const JsonSaveGame::NodeLayer &nodeLayer = node.layers[layer];
+          mapNodeData[layer].tileId = tileIds[nodeLayer.tileRef];
+          mapNodeData[layer].tileIndex = nodeLayer.tileIndex;
+          mapNodeData[layer].origCornerPoint = nodeLayer.origCornerPoint;
+        }
+
+        MapNode &mapNode = map->getMapNode(coordinates);
+        // set coordinates (height) of the map
+        mapNode.initialize(coordinates.height, "");
+        // load back mapNodeData (tileIDs, Buildins, ...)
+        mapNode.setMapNodeData(mapNodeData, coordinates);
+      });
+
+  return map.release();
+}
+
+Map *Map::loadBinaryMap(const std::string &filePath)
+{
+  auto loader = std::make_unique<SaveGameLoader>(filePath);
+  const BinarySaveGame::Header &header = loader->getHeader();
+
+  checkSaveGameVersion(header.saveGameVersion);
+
+  std::unique_ptr<Map> map = std::make_unique<Map>(header.columns, header.rows, false);
+
+  // the tile handles of the savegame might differ from the ones of the loaded tile data
+  map->m_saveGameTileIds.reserve(loader->getTileIDs().size());
+  for (const std::string &tileID : loader->getTileIDs())
+  {
+    map->m_saveGameTileIds.push_back(TileManager::instance().getTileId(tileID));
+  }
+
+  // the journal is small compared to the map, it's read at once and applied to the chunks its nodes belong to
+  SaveGameJournal::Batch journal;
+  map->readJournal(filePath,
+                   [&map, &journal](const SaveGameJournal::Batch &batch, const std::vector<TileId> &tileIds)
+                   {
+                     for (size_t i = 0; i < batch.size(); ++i)
+                     {
+                       journal.addNode(batch, i);
+                     }
+                     map->m_journalTileIds = tileIds;
+                   });
+  map->m_journalChanges = latestJournalChanges(journal);
+
+  // the chunks closest to the camera are drawn first
+  const int cameraRow =
+      calculateIsoCoordinates({Settings::instance().screenWidth / 2, Settings::instance().screenHeight / 2}).x;
+  const size_t chunkCount = loader->getChunkCount();
+  std::vector<int> cameraDistances(chunkCount, 0);
+  map->m_chunkLoadStates.assign(chunkCount, ChunkLoadState::DECODING);
+  for (size_t chunkNumber = 0; chunkNumber < chunkCount; ++chunkNumber)
+  {
+    const BinarySaveGame::ChunkLocation &location = loader->getChunkLocation(chunkNumber);
+    if (location.nodeCount == 0)
+    {
+      map->m_chunkLoadStates[chunkNumber] = ChunkLoadState::LOADED;
+      ++map->m_loadedChunkCount;
+      continue;
+    }
+
+    const std::pair<int, int> rows = getChunkRows(location, header.columns);
+    cameraDistances[chunkNumber] = std::max({rows.first - cameraRow, cameraRow - rows.second, 0});
+  }
+  map->m_chunkLoadOrder.resize(chunkCount);
+  std::iota(map->m_chunkLoadOrder.begin(), map->m_chunkLoadOrder.end(), 0);
+  std::stable_sort(map->m_chunkLoadOrder.begin(), map->m_chunkLoadOrder.end(),
+                   [&cameraDistances](size_t a, size_t b) { return cameraDistances[a] < cameraDistances[b]; });
+
+  // coloring all nodes of the minimap would race with the workers, the nodes are colored once they're loaded
+  map->m_minimap.markAllClean();
+  // refreshing the sprites would race with the workers too
+  map->m_chunks.setRowsLoading(0, header.rows - 1, true);
+
+  Map *pMap = map.get();
+  loader->start(map->m_chunkLoadOrder, [pMap](const BinarySaveGame::Chunk &chunk) { pMap->applySaveGameChunk(chunk); });
+  map->m_saveGameLoader = std::move(loader);
+  map->releaseSaveGameLoader();
+
+  return map.release();
+}
+
+void Map::applySaveGameChunk(const BinarySaveGame::Chunk &chunk)
+{
+  // check the whole chunk first, so a damaged chunk isn't applied partially
+  for (int i = 0; i < chunk.nodeCount; ++i)
   {
-    for (int y = columns - 1; y >= 0; y--)
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
     {
-      map->mapNodesInDrawingOrder.emplace_back(&map->mapNodes[x * columns + y]);
+      if (chunk.tileRefs[layer][i] >= m_saveGameTileIds.size() ||
+          !isValidNodeData(chunk.heights[i], chunk.origCornerIndices[layer][i], m_grid.nodeCount()))
+      {
+        throw ConfigurationError(TRACE_INFO "Binary savegame node " + std::to_string(chunk.firstNode + i) +
+                                 " is damaged");
+      }
     }
   }
 
-  map->updateAllNodes();
+  // the game thread draws the map meanwhile, so only the saved columns of the grid are written here. The sprites and
+  // textures of the nodes are set up on the game thread when the chunk is loaded
+  for (int i = 0; i < chunk.nodeCount; ++i)
+  {
+    const int index = chunk.firstNode + i;
+    m_grid.height(index) = chunk.heights[i];
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      setSavedLayer(m_grid, static_cast<Layer>(layer), index, m_saveGameTileIds[chunk.tileRefs[layer][i]],
+                    chunk.tileIndices[layer][i], chunk.origCornerIndices[layer][i]);
+    }
+  }
+
+  // the journal has been checked when it has been read, its newer states of the nodes replace the saved ones
+  const std::vector<int32_t> &journalNodes = m_journalChanges.nodeIndices;
+  for (auto it = std::lower_bound(journalNodes.begin(), journalNodes.end(), chunk.firstNode);
+       it != journalNodes.end() && *it < chunk.firstNode + chunk.nodeCount; ++it)
+  {
+    const size_t i = static_cast<size_t>(it - journalNodes.begin());
+    m_grid.height(*it) = m_journalChanges.heights[i];
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      setSavedLayer(m_grid, static_cast<Layer>(layer), *it, m_journalTileIds[m_journalChanges.tileRefs[layer][i]],
+                    m_journalChanges.tileIndices[layer][i], m_journalChanges.origCornerIndices[layer][i]);
+    }
+  }
+}
+
+void Map::placeLoadedSprites(size_t begin, size_t end)
+{
+  // what MapNode::initialize and MapNode::setMapNodeData do to the sprite of a node
+  for (size_t index = begin; index < end; ++index)
+  {
+    m_grid.sprite(index).isoCoordinates = m_grid.coordinates(static_cast<int>(index));
+    mapNodes[index].setNodeTransparency(Settings::instance().zoneLayerTransparency, Layer::ZONE);
+  }
+}
+
+void Map::loadRows(int firstRow, int lastRow)
+{
+  // the nodes that are being loaded only access nodes whose chunks have been waited for
+  if (!m_saveGameLoader || m_isLoadingChunks)
+  {
+    return;
+  }
+
+  const std::pair<size_t, size_t> chunks = getSaveGameChunks(firstRow, lastRow);
+  for (size_t chunkNumber = chunks.first; chunkNumber <= chunks.second && m_saveGameLoader; ++chunkNumber)
+  {
+    finishSaveGameChunk(chunkNumber);
+  }
+  releaseSaveGameLoader();
+}
+
+void Map::waitForDecodedRows(int firstRow, int lastRow)
+{
+  if (!m_saveGameLoader)
+  {
+    return;
+  }
+
+  // the nodes of decoded chunks are only written by the game thread, their sprites are set up when they're loaded
+  const std::pair<size_t, size_t> chunks = getSaveGameChunks(firstRow, lastRow);
+  for (size_t chunkNumber = chunks.first; chunkNumber <= chunks.second; ++chunkNumber)
+  {
+    if (m_chunkLoadStates[chunkNumber] == ChunkLoadState::DECODING)
+    {
+      m_saveGameLoader->waitForChunk(chunkNumber);
+    }
+  }
+}
+
+void Map::loadAllNodes()
+{
+  if (!m_saveGameLoader || m_isLoadingChunks)
+  {
+    return;
+  }
+
+  for (size_t position = 0; position < m_chunkLoadOrder.size(); ++position)
+  {
+    finishSaveGameChunk(m_chunkLoadOrder[position]);
+  }
+  releaseSaveGameLoader();
+}
+
+void Map::loadVisibleNodes()
+{
+  if (!m_saveGameLoader)
+  {
+    return;
+  }
+
+  const size_t loadedChunkCount = m_loadedChunkCount;
+  // below the overview zoom level the overview shows the whole map
+  if (Camera::instance().zoomLevel() < Settings::instance().overviewZoomLevel)
+  {
+    loadAllNodes();
+  }
+  else
+  {
+    int firstRow = m_rows;
+    int lastRow = -1;
+    VisibleRange::forEachRow(m_columns, m_rows, calculateScreenDiamond(),
+                             [&firstRow, &lastRow](int, int xFirst, int xLast)
+                             {
+                               firstRow = std::min(firstRow, xFirst);
+                               lastRow = std::max(lastRow, xLast);
+                             });
+    // buildings are drawn by their origin node, which can be outside of the screen. The map chunks on screen are only
+    // drawn once all of their rows are loaded
+    if (firstRow <= lastRow)
+    {
+      firstRow = std::max(firstRow - buildingReachRows, 0);
+      lastRow += buildingReachRows;
+      loadRows(firstRow - firstRow % MapChunks::chunkSize,
+               lastRow - lastRow % MapChunks::chunkSize + MapChunks::chunkSize - 1);
+    }
+  }
 
-  return map;
+  // the nodes haven't been drawn before, so the screen rects their sprites had are empty
+  if (m_loadedChunkCount != loadedChunkCount)
+  {
+    m_damage.invalidate();
+  }
+}
+
+void Map::loadNextChunk()
+{
+  if (!m_saveGameLoader)
+  {
+    return;
+  }
+
+  // the chunks that have been needed earlier are skipped
+  while (m_nextChunkToLoad < m_chunkLoadOrder.size() &&
+         m_chunkLoadStates[m_chunkLoadOrder[m_nextChunkToLoad]] == ChunkLoadState::LOADED)
+  {
+    ++m_nextChunkToLoad;
+  }
+  if (m_nextChunkToLoad < m_chunkLoadOrder.size())
+  {
+    finishSaveGameChunk(m_chunkLoadOrder[m_nextChunkToLoad]);
+  }
+  releaseSaveGameLoader();
+}
+
+std::pair<size_t, size_t> Map::getSaveGameChunks(int firstRow, int lastRow) const
+{
+  firstRow = std::max(firstRow, 0);
+  lastRow = std::min(lastRow, m_rows - 1);
+  if (firstRow > lastRow)
+  {
+    return {1, 0};
+  }
+
+  return {m_saveGameLoader->getChunkOfNode(nodeIdx(firstRow, 0)),
+          m_saveGameLoader->getChunkOfNode(nodeIdx(lastRow, m_columns - 1))};
+}
+
+void Map::settleSaveGameChunk(size_t chunkNumber)
+{
+  if (m_chunkLoadStates[chunkNumber] != ChunkLoadState::DECODING)
+  {
+    return;
+  }
+
+  // the elevation of a node depends on its neighbors, and demolishing a node demolishes the whole building on it
+  const BinarySaveGame::ChunkLocation &location = m_saveGameLoader->getChunkLocation(chunkNumber);
+  const std::pair<int, int> rows = getChunkRows(location, m_columns);
+  const std::pair<size_t, size_t> chunks =
+      getSaveGameChunks(rows.first - buildingReachRows, rows.second + buildingReachRows);
+  for (size_t neighborChunk = chunks.first; neighborChunk <= chunks.second; ++neighborChunk)
+  {
+    m_saveGameLoader->waitForChunk(neighborChunk);
+  }
+
+  const size_t begin = location.firstNode;
+  const size_t end = begin + location.nodeCount;
+  m_isLoadingChunks = true;
+
+  if (!areNodeHeightsSettled(begin, end))
+  {
+    m_isLoadingChunks = false;
+    loadSaveGameAtOnce();
+    return;
+  }
+
+  // like updateAllNodes with settled heights
+  std::vector<uint8_t> elevationChanged(end - begin, 0);
+  parallelFor(begin, end,
+              [this, begin, &elevationChanged](size_t index)
+              {
+                MapNode &mapNode = mapNodes[index];
+                const unsigned char elevationBitmask = getElevatedNeighborBitmask(mapNode.getCoordinates());
+                elevationChanged[index - begin] = (elevationBitmask != mapNode.getElevationBitmask());
+                mapNode.setElevationBitMask(elevationBitmask);
+              });
+
+  m_nodesToDemolish.clear();
+  for (size_t index = begin; index < end; ++index)
+  {
+    if (elevationChanged[index - begin])
+    {
+      m_nodesToDemolish.push_back(static_cast<int>(index));
+    }
+  }
+  demolishChangedNodes();
+
+  m_isLoadingChunks = false;
+  m_chunkLoadStates[chunkNumber] = ChunkLoadState::SETTLED;
+}
+
+void Map::finishSaveGameChunk(size_t chunkNumber)
+{
+  if (m_chunkLoadStates[chunkNumber] == ChunkLoadState::LOADED)
+  {
+    return;
+  }
+
+  // the autotiling depends on the tiles of the neighbors, which may be demolished while the chunks around settle
+  const BinarySaveGame::ChunkLocation &location = m_saveGameLoader->getChunkLocation(chunkNumber);
+  const std::pair<int, int> rows = getChunkRows(location, m_columns);
+  const std::pair<size_t, size_t> chunks =
+      getSaveGameChunks(rows.first - buildingReachRows, rows.second + buildingReachRows);
+  for (size_t neighborChunk = chunks.first; neighborChunk <= chunks.second; ++neighborChunk)
+  {
+    settleSaveGameChunk(neighborChunk);
+    if (!m_saveGameLoader)
+    {
+      // the whole savegame has been loaded at once
+      return;
+    }
+  }
+
+  const size_t begin = location.firstNode;
+  const size_t end = begin + location.nodeCount;
+  placeLoadedSprites(begin, end);
+  parallelFor(begin, end,
+              [this](size_t index)
+              {
+                MapNode &mapNode = mapNodes[index];
+                mapNode.setAutotileBitMask(calculateAutotileBitmask(&mapNode, getNeighborNodes(static_cast<int>(index))));
+              });
+  parallelFor(begin, end, [this](size_t index) { mapNodes[index].updateTexture(); });
+
+  for (size_t index = begin; index < end; ++index)
+  {
+    m_chunks.markDirty(mapNodes[index].getCoordinates());
+    m_minimap.markNodeDirty(static_cast<int>(index));
+  }
+
+  m_chunkLoadStates[chunkNumber] = ChunkLoadState::LOADED;
+  ++m_loadedChunkCount;
+
+  // the map chunks are squares across several savegame chunks, they're drawn once all of their rows are loaded
+  for (int firstRow = rows.first - rows.first % MapChunks::chunkSize; firstRow <= rows.second;
+       firstRow += MapChunks::chunkSize)
+  {
+    const int lastRow = std::min(firstRow + MapChunks::chunkSize, m_rows) - 1;
+    const std::pair<size_t, size_t> bandChunks = getSaveGameChunks(firstRow, lastRow);
+    bool isBandLoaded = true;
+    for (size_t bandChunk = bandChunks.first; bandChunk <= bandChunks.second; ++bandChunk)
+    {
+      isBandLoaded = isBandLoaded && (m_chunkLoadStates[bandChunk] == ChunkLoadState::LOADED);
+    }
+    if (isBandLoaded)
+    {
+      m_chunks.setRowsLoading(firstRow, lastRow, false);
+    }
+  }
+}
+
+void Map::releaseSaveGameLoader()
+{
+  if (!m_saveGameLoader || m_loadedChunkCount < m_chunkLoadStates.size())
+  {
+    return;
+  }
+
+  // all chunks have been decoded, this only joins the workers and unmaps the savegame
+  m_saveGameLoader.reset();
+  m_chunkLoadStates = {};
+  m_chunkLoadOrder = {};
+  m_nextChunkToLoad = 0;
+  m_saveGameTileIds = {};
+  m_journalChanges = {};
+  m_journalTileIds = {};
+  LOG(LOG_INFO) << "All nodes of the savegame have been loaded";
+}
+
+void Map::loadSaveGameAtOnce()
+{
+  LOG(LOG_WARNING) << "The heights of the savegame aren't settled, all nodes are loaded at once";
+
+  for (size_t chunkNumber = 0; chunkNumber < m_chunkLoadStates.size(); ++chunkNumber)
+  {
+    m_saveGameLoader->waitForChunk(chunkNumber);
+  }
+  placeLoadedSprites(0, mapNodes.size());
+  m_loadedChunkCount = m_chunkLoadStates.size();
+  releaseSaveGameLoader();
+  m_chunks.setRowsLoading(0, m_rows - 1, false);
+
+  // settling the heights depends on the order of the nodes, so it can't be done chunk by chunk
+  m_isLoadingChunks = true;
+  updateAllNodes();
+  m_isLoadingChunks = false;
+}
+
+bool Map::isNodeLoaded(int index) const
+{
+  return !m_saveGameLoader ||
+         m_chunkLoadStates[m_saveGameLoader->getChunkOfNode(index)] == ChunkLoadState::LOADED;
 }
 
 bool Map::isAllowSetTileId(const Layer layer, const MapNode *const pMapNode)
@@ -673,7 +1582,7 @@ bool Map::isAllowSetTileId(const Layer layer, const MapNode *const pMapNode)
   //   break;
   case Layer::ZONE:
     if ((pMapNode->isLayerOccupied(Layer::BUILDINGS) &&
-         pMapNode->getMapNodeDataForLayer(Layer::BUILDINGS).tileData->category != "Flora") ||
+         pMapNode->getTileData(Layer::BUILDINGS)->category != "Flora") ||
         pMapNode->isLayerOccupied(Layer::WATER) || pMapNode->isLayerOccupied(Layer::ROAD) || pMapNode->isSlopeNode())
     {
       return false;
@@ -681,7 +1590,7 @@ bool Map::isAllowSetTileId(const Layer layer, const MapNode *const pMapNode)
     break;
   case Layer::WATER:
     if (pMapNode->isLayerOccupied(Layer::BUILDINGS) &&
-        pMapNode->getMapNodeDataForLayer(Layer::BUILDINGS).tileData->category != "Flora")
+        pMapNode->getTileData(Layer::BUILDINGS)->category != "Flora")
     {
       return false;
     }
@@ -693,40 +1602,69 @@ bool Map::isAllowSetTileId(const Layer layer, const MapNode *const pMapNode)
   return true;
 }
 
-void Map::calculateVisibleMap(void)
+ScreenDiamond Map::calculateScreenDiamond() const
 {
   const Point topLeft = calculateIsoCoordinates({0, 0});
   const Point bottomRight = calculateIsoCoordinates({Settings::instance().screenWidth, Settings::instance().screenHeight});
 
   // Screen edges
-  const int left = topLeft.x + topLeft.y - 2;
-  const int right = bottomRight.x + bottomRight.y + 1;
-  const int top = topLeft.y - topLeft.x + 1;
+  ScreenDiamond screenBounds;
+  screenBounds.left = topLeft.x + topLeft.y - 2;
+  screenBounds.right = bottomRight.x + bottomRight.y + 1;
+  screenBounds.top = topLeft.y - topLeft.x + 1;
   // Lower the bottom because of high terrain nodes under the screen which will be pushed into the view
-  const int bottom = bottomRight.y - bottomRight.x - 1 - MapNode::maxHeight;
+  screenBounds.bottom = bottomRight.y - bottomRight.x - 1 - MapNode::maxHeight;
+  return screenBounds;
+}
+
+void Map::calculateVisibleMap(void)
+{
+  const ScreenDiamond screenBounds = calculateScreenDiamond();
+
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+  const SDL_Rect screenRect{cameraOffset.x, cameraOffset.y, Settings::instance().screenWidth,
+                            Settings::instance().screenHeight};
+  m_chunks.cull(m_grid, screenRect, Camera::instance().zoomLevel());
 
   m_visibleNodesCount = 0;
 
   // ZOrder starts from topmost node to the right. (0,127) =1,(1,127) =2, ...
-  for (int y = m_columns - 1; y >= 0; y--)
-  {
-    for (int x = 0; x < m_rows; x++)
-    {
-      const int xVal = x + y;
-      const int yVal = y - x;
-
-      if ((xVal >= left) && (xVal <= right) && (yVal <= top) && (yVal >= bottom))
-      {
-        pMapNodesVisible[m_visibleNodesCount++] = mapNodes[nodeIdx(x, y)].getSprite();
-      }
-    }
-  }
+  // Chunks that are not visible are skipped as a whole, this keeps the drawing order across chunk borders.
+  VisibleRange::forEachRow(m_columns, m_rows, screenBounds,
+                           [this](int y, int xFirst, int xLast)
+                           {
+                             const int chunkY = y / MapChunks::chunkSize;
+                             const int lastChunkX = xLast / MapChunks::chunkSize;
+
+                             for (int chunkX = xFirst / MapChunks::chunkSize; chunkX <= lastChunkX; ++chunkX)
+                             {
+                               if (!m_chunks.isChunkVisible(chunkX, chunkY))
+                               {
+                                 continue;
+                               }
+
+                               const int chunkXFirst = std::max(xFirst, chunkX * MapChunks::chunkSize);
+                               const int chunkXLast = std::min(xLast, (chunkX + 1) * MapChunks::chunkSize - 1);
+                               for (int x = chunkXFirst; x <= chunkXLast; ++x)
+                               {
+                                 pMapNodesVisible[m_visibleNodesCount++] = mapNodes[nodeIdx(x, y)].getSprite();
+                               }
+                             }
+                           });
 }
 
 void Map::setTileID(const std::string &tileID, Point coordinate)
 {
-  TileData *tileData = TileManager::instance().getTileData(tileID);
-  std::vector<Point> targetCoordinates = TileManager::instance().getTargetCoordsOfTileID(coordinate, tileID);
+  setTileID(TileManager::instance().getTileId(tileID), coordinate);
+}
+
+void Map::setTileID(TileId tileId, Point coordinate)
+{
+  loadRows(coordinate.x - editReachRows, coordinate.x + editReachRows);
+
+  TileManager &tileManager = TileManager::instance();
+  TileData *tileData = tileManager.getTileData(tileId);
+  const TileFootprint targetCoordinates = tileManager.getTargetCoordsOfTileID(coordinate, tileId);
 
   if (!tileData || targetCoordinates.empty())
   { // if the node would not outside of map boundaries, targetCoordinates would be empty
@@ -735,33 +1673,34 @@ void Map::setTileID(const std::string &tileID, Point coordinate)
 
   for (auto coord : targetCoordinates)
   { // first check all nodes if it is possible to place the building before doing anything
-    if (!isPlacementOnNodeAllowed(coord, tileID))
+    if (!isPlacementOnNodeAllowed(coord, tileId))
     { //make sure every target coordinate is valid for placement, not just the origin coordinate.
       return;
     }
   }
 
-  Layer layer = TileManager::instance().getTileLayer(tileID);
-  std::string randomGroundDecorationTileID;
+  Layer layer = tileManager.getTileLayer(tileId);
+  TileId randomGroundDecorationTileId = EMPTY_TILE_ID;
   std::vector<MapNode *> nodesToBeUpdated;
 
   // if this building has groundDeco, grab a random tileID from the list
   if (!tileData->groundDecoration.empty())
   {
-    randomGroundDecorationTileID =
-        *Randomizer::instance().choose(tileData->groundDecoration.begin(), tileData->groundDecoration.end());
+    randomGroundDecorationTileId = tileManager.getTileId(
+        *Randomizer::instance().choose(tileData->groundDecoration.begin(), tileData->groundDecoration.end()));
   }
 
   // for >1x1 buildings, clear all the nodes that are going to be occupied before placing anything.
   if (targetCoordinates.size() > 1)
   {
-    demolishNode(targetCoordinates, 0, Layer::BUILDINGS);
+    demolishNode({targetCoordinates.begin(), targetCoordinates.end()}, 0, Layer::BUILDINGS);
   }
 
   for (auto coord : targetCoordinates)
   { // now we can place our building
 
     MapNode &currentMapNode = mapNodes[nodeIdx(coord.x, coord.y)];
+    markNodeChanged(coord);
 
     if (coord != coordinate && targetCoordinates.size() > 1)
     { // for buildings >1x1 set every node on the layer that will be occupied to invisible exepct of the origin node
@@ -774,26 +1713,28 @@ void Map::setTileID(const std::string &tileID, Point coordinate)
 
     if (!targetCoordinates.size() == 1)
     { // if it's not a >1x1 building, place tileID on the current coordinate (e.g. ground decoration beneath a > 1x1 building)
-      currentMapNode.setTileID(tileID, coord);
+      currentMapNode.setTileID(tileId, coord);
     }
     else
     { // set the tileID for the mapNode of the origin coordinates only on the origin coordinate
       {
-        currentMapNode.setTileID(tileID, coordinate);
+        currentMapNode.setTileID(tileId, coordinate);
       }
     }
 
     // place ground deco if we have one
-    if (!randomGroundDecorationTileID.empty())
+    if (randomGroundDecorationTileId != EMPTY_TILE_ID)
     {
-      currentMapNode.setTileID(randomGroundDecorationTileID, coord);
+      currentMapNode.setTileID(randomGroundDecorationTileId, coord);
     }
 
     // For layers that autotile to each other, we need to update their neighbors too
-    if (TileManager::instance().isTileIDAutoTile(tileID))
+    if (tileManager.isTileIDAutoTile(tileId))
     {
       nodesToBeUpdated.push_back(&currentMapNode);
     }
+    signalChangeTile.emit(currentMapNode);
+
     // If we place a zone tile, add it to the ZoneManager
     // emit a signal to notify manager
     if (currentMapNode.getTileData(Layer::BUILDINGS) && currentMapNode.getTileData(Layer::ZONE))
@@ -814,9 +1755,14 @@ void Map::setTileID(const std::string &tileID, Point coordinate)
 }
 
 void Map::setTileID(const std::string &tileID, const std::vector<Point> &coordinates)
+{
+  setTileID(TileManager::instance().getTileId(tileID), coordinates);
+}
+
+void Map::setTileID(TileId tileId, const std::vector<Point> &coordinates)
 {
   for (auto coord : coordinates)
   {
-    setTileID(tileID, coord);
+    setTileID(tileId, coord);
   }
 }
\ No newline at end of file
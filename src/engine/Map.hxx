@@ -2,20 +2,43 @@
 #define MAP_HXX_
 
 #include <vector>
+#include <functional>
+#include <memory>
 #include <random>
+#include <iosfwd>
+#include <utility>
 
 #include "GameObjects/MapNode.hxx"
+#include "map/BinarySaveGame.hxx"
+#include "map/MapChunks.hxx"
+#include "map/MapGrid.hxx"
+#include "map/NodeMarks.hxx"
+#include "map/SaveGameJournal.hxx"
+#include "map/SaveGameSnapshot.hxx"
 #include "map/TerrainGenerator.hxx"
+#include "map/VisibleRange.hxx"
+#include "render/MapDrawLists.hxx"
+#include "render/MapOverview.hxx"
+#include "render/Minimap.hxx"
+#include "render/RenderSnapshot.hxx"
+#include "render/SpriteBatcher.hxx"
+#include "render/TerrainChunkCache.hxx"
 #include "../game/GamePlay.hxx"
 #include "PointFunctions.hxx"
 #include "basics/signal.hxx"
 
 struct NeighborNode
 {
-  MapNode *pNode;
-  NeighbourNodesPosition position;
+  MapNode *pNode = nullptr;
+  /// NeighbourNodesPosition of the node relative to the central node
+  unsigned char position = NeighbourNodesPosition::CENTER;
 };
 
+/// Neighbor nodes of a map node, stored without allocating
+using NeighborNodes = FixedVector<NeighborNode, neighborOffsets.size()>;
+
+class SaveGameLoader;
+
 class Map
 {
 public:
@@ -40,11 +63,27 @@ public:
     */
   void decreaseHeight(const Point &isoCoordinates);
 
-  /** \brief Render the elements contained in the Map
+  /** \brief Record the elements contained in the Map into a render snapshot
     * call the render() function of the sprite in the all contained MapNode elements
+    * Refreshes the map first if nodes changed since the last refresh. Below the overview zoom level the map is drawn from
+    * the map overview instead.
+    * Textures the map caches are updated with the renderer right away, the quads are only recorded.
+    * @param snapshot the snapshot the quads of the map are added to
     * @see Sprite#render
     */
-  void renderMap() const;
+  void renderMap(RenderSnapshot &snapshot);
+
+  /// Check if nodes changed since the map has been rendered the last time, or nodes are still loaded from a savegame
+  bool hasPendingChanges() const { return m_chunks.hasDirtyChunks() || m_saveGameLoader; };
+
+  /// Get the minimap of this map
+  Minimap &getMinimap() { return m_minimap; };
+
+  /// Get the number of draw calls, quads and texture changes of the last frame
+  const BatchStats &getRenderStats() const { return m_renderStats; };
+
+  /// Get the number of quads of the last frame that haven't been drawn because buildings cover them
+  int getOccludedQuadCount() const { return m_occludedQuads; };
 
   /**
  * @brief Sets a node to be highlit
@@ -61,6 +100,18 @@ public:
  */
   void unHighlightNode(const Point &isoCoordinates);
 
+  /** @brief Redraw a node in the next frame although it hasn't changed
+   * For changes of a node's sprite that don't need a refresh, like its transparency.
+   * @param isoCoordinates the node that looks different
+   */
+  void invalidateNode(const Point &isoCoordinates);
+
+  /** @brief Take the parts of the screen that changed since the damage has been taken the last time
+   * renderMap passes the damage on to the render snapshot.
+   * @returns the damage in screen coordinates
+   */
+  DamageRegion takeDamage();
+
   /**
  * @brief Returns the node at given screencoordinates
  *
@@ -84,6 +135,11 @@ public:
  */
   void setTileID(const std::string &tileID, const std::vector<Point> &coordinates);
 
+  /// @see setTileID(const std::string &, Point)
+  void setTileID(TileId tileId, Point coordinate);
+  /// @see setTileID(const std::string &, const std::vector<Point> &)
+  void setTileID(TileId tileId, const std::vector<Point> &coordinates);
+
   /**
  * @brief Demolish a node
  * This function gathers all tiles that should be demolished and invokes the nodes demolish function. When a building bigger than 1x1 is selected, all it's coordinates are added to the demolishing points.
@@ -95,9 +151,10 @@ public:
   void demolishNode(const std::vector<Point> &isoCoordinates, bool updateNeighboringTiles = false, Layer layer = Layer::NONE);
 
   /**
-   * @brief Refresh all the map tile textures
-   *
+   * @brief Refresh the map tile textures and the visible nodes
+   * Only the sprites of changed chunks or of visible chunks after a zoom level change are refreshed.
    * @see Sprite#refresh
+   * @see MapChunks
    */
   void refresh();
 
@@ -107,13 +164,47 @@ public:
   Point getNodeOrigCornerPoint(const Point &isoCoordinates, Layer layer = Layer::NONE);
 
   /** \brief Save Map to file
-  * Serializes the Map class to json and writes the data to a file.
+  * Serializes the Map class and writes the data to a file.
   * @param fileName The file the map should be written to
+  * @param format The file format, json is meant for exporting maps
+  * @see BinarySaveGame
+  */
+  void saveMapToFile(const std::string &fileName, SaveGameFormat format = SaveGameFormat::BINARY);
+
+  /** \brief Copy the state of the map a savegame needs
+  * The snapshot can be saved on another thread while the map changes.
+  * @see SaveGameService
   */
-  void saveMapToFile(const std::string &fileName);
+  SaveGameSnapshot createSaveGameSnapshot()
+  {
+    loadAllNodes();
+    return SaveGameSnapshot(m_grid, TileManager::instance().getTileIDStrings());
+  };
+
+  /// Check if nodes changed since the map has been saved or its changes have been taken the last time
+  bool hasUnsavedChanges() const { return !m_unsavedNodes.empty(); };
+
+  /// Get the number of nodes that changed since the map has been saved or its changes have been taken the last time
+  size_t getUnsavedNodeCount() const { return m_unsavedNodes.size(); };
+
+  /// Get the number of nodes of the map
+  int getNodeCount() const { return m_grid.nodeCount(); };
+
+  /** \brief Take the state of all nodes that changed since the last call
+  * Every node that setTileID, demolishNode or changeHeight changed, including the nodes those changes spread to, is
+  * taken once. Tile references of the batch are tile handles.
+  * @see SaveGameJournal
+  */
+  SaveGameJournal::Batch takeUnsavedChanges();
+
+  /// Forget about the changed nodes, e.g. because the map has been saved completely
+  void markChangesSaved();
 
   /** \brief Load Map from file
-  * Deserializes the Map class from a json file, creates a new Map and returns it.
+  * Deserializes the Map class from a binary or json file, creates a new Map and returns it.
+  * If the savegame has a SaveGameJournal, the changes in it are replayed on top of the savegame.
+  * A binary savegame is loaded lazily: the map is returned right away and the chunks of the savegame are decoded on
+  * worker threads, the ones closest to the camera first. Everything that accesses nodes waits for the chunks it needs.
   * @param fileName The file the map should be written to
   * @returns Map* Pointer to the newly created Map.
   */
@@ -124,13 +215,14 @@ public:
  * Used as Tile-Inspector until we implement a GUI variant
  * @param isoCoordinates Tile to inspect
  */
-  void getNodeInformation(const Point &isoCoordinates) const;
+  void getNodeInformation(const Point &isoCoordinates);
 
   /** \brief check if Tile is occupied
   * @param isoCoordinates Tile to inspect
   * @param tileID tileID which should be checked
   */
-  bool isPlacementOnNodeAllowed(const Point &isoCoordinates, const std::string &tileID) const;
+  bool isPlacementOnNodeAllowed(const Point &isoCoordinates, const std::string &tileID);
+  bool isPlacementOnNodeAllowed(const Point &isoCoordinates, TileId tileId);
 
   /** \brief get Tile ID of specific layer of specific iso coordinates
   * @param isoCoordinates: Tile to inspect
@@ -138,21 +230,127 @@ public:
   */
   std::string getTileID(const Point &isoCoordinates, Layer layer);
 
+  /** \brief get the handle of the Tile ID of specific layer of specific iso coordinates
+  * @param isoCoordinates: Tile to inspect
+  * @param layer: layer to check.
+  * @return the handle or EMPTY_TILE_ID if the coordinates are outside of the map
+  */
+  TileId getTileId(const Point &isoCoordinates, Layer layer);
+
   /** \brief Get pointer to a single mapNode at specific iso coordinates.
   * @param isoCoordinates: The node to retrieve.
   */
-  MapNode &getMapNode(Point isoCoords) { return mapNodes[nodeIdx(isoCoords.x, isoCoords.y)]; };
+  MapNode &getMapNode(Point isoCoords)
+  {
+    loadRows(isoCoords.x, isoCoords.x);
+    return mapNodes[nodeIdx(isoCoords.x, isoCoords.y)];
+  };
 
   /** \brief Get all mapnodes as a vector
    */
-  const std::vector<MapNode> &getMapNodes() { return mapNodes; };
+  const std::vector<MapNode> &getMapNodes()
+  {
+    loadAllNodes();
+    return mapNodes;
+  };
 
-private:
   /** \brief Update all mapNodes
   * Updates all mapNode and its adjacent tiles regarding height information, draws slopes for adjacent tiles and
-  * sets tiling for mapNode sprite if applicable
+  * sets tiling for mapNode sprite if applicable.
+  * The bitmasks and textures of all nodes are calculated in parallel, with the same result as updating the nodes one by one.
+  * @param inParallel if set to false, all nodes are passed to updateNodeNeighbors instead.
+  */
+  void updateAllNodes(bool inParallel = true);
+
+private:
+  /// How far the nodes of a chunk of a lazily loaded savegame are loaded
+  enum class ChunkLoadState : uint8_t
+  {
+    /// the nodes may still be decoded
+    DECODING,
+    /// the nodes are placed and their elevation is known, which may have demolished some of them
+    SETTLED,
+    /// the textures of the nodes are up to date, like after updateAllNodes
+    LOADED
+  };
+
+  /** \brief Create a map from a savegame in the BinarySaveGame format and start loading its nodes lazily
+  * The savegame is memory-mapped and its chunks are decoded on worker threads, the ones closest to the camera first.
+  * The changes in the journal of the savegame are applied to the chunks they belong to.
+  * @param filePath full path of the savegame
+  * @see SaveGameLoader
+  */
+  static Map *loadBinaryMap(const std::string &filePath);
+
+  /// Create a map from a stream of uncompressed json node by node, the textures of its nodes still have to be updated
+  static Map *loadJsonMap(std::istream &stream);
+
+  /** \brief Read the journal of a savegame batch by batch
+  * A journal that belongs to another savegame is ignored. Reading stops at the first damaged batch, e.g. one that has
+  * been written partially when the game crashed, the map then has the state of the last intact batch.
+  * @param saveGamePath full path of the savegame
+  * @param applyBatch called with every intact batch and the tile handles its tile references point to
+  */
+  void readJournal(const std::string &saveGamePath,
+                   const std::function<void(const SaveGameJournal::Batch &, const std::vector<TileId> &)> &applyBatch);
+
+  /** \brief Replay the journal of a savegame on the nodes that have been loaded from it
+  * @param saveGamePath full path of the savegame
+  * @see readJournal
+  */
+  void replayJournal(const std::string &saveGamePath);
+
+  /** \brief Write the nodes of a decoded savegame chunk and the journal changes that belong to them into the grid
+  * Called on the worker threads of the SaveGameLoader while the game thread draws the map, so it only writes the saved
+  * columns of the grid for the nodes of the chunk, not their sprites.
+  * @throws ConfigurationError if a node of the chunk is damaged, then no node has been written
+  */
+  void applySaveGameChunk(const BinarySaveGame::Chunk &chunk);
+
+  /// Set up the sprites of nodes that have been loaded from a savegame, the loader only writes their saved attributes
+  void placeLoadedSprites(size_t begin, size_t end);
+
+  /** \brief Wait for the nodes of some rows to be loaded from a lazily loaded savegame
+  * The chunks that cover the rows are decoded if necessary and brought to the state updateAllNodes leaves nodes in.
+  * Does nothing if no savegame is loaded lazily.
+  * @param firstRow first row (x coordinate) of the nodes
+  * @param lastRow last row of the nodes, inclusive
+  */
+  void loadRows(int firstRow, int lastRow);
+
+  /** \brief Wait for the nodes of some rows of a lazily loaded savegame to be decoded, without loading them
+  * The game thread can change decoded nodes, loading them later brings them up to date with their neighbors.
+  * @param firstRow first row (x coordinate) of the nodes
+  * @param lastRow last row of the nodes, inclusive
   */
-  void updateAllNodes();
+  void waitForDecodedRows(int firstRow, int lastRow);
+
+  /// Wait for all nodes of a lazily loaded savegame to be loaded
+  void loadAllNodes();
+
+  /// Load the nodes that are on screen, including the buildings that reach into it from outside
+  void loadVisibleNodes();
+
+  /// Load the next chunk of a lazily loaded savegame in the background, one chunk per frame
+  void loadNextChunk();
+
+  /// Get the range of savegame chunks that cover some rows
+  std::pair<size_t, size_t> getSaveGameChunks(int firstRow, int lastRow) const;
+
+  /// Place the nodes of a savegame chunk and set their elevation, the chunks around it are decoded first
+  void settleSaveGameChunk(size_t chunkNumber);
+
+  /// Update the autotiling and the textures of the nodes of a savegame chunk, the chunks around it are settled first
+  void finishSaveGameChunk(size_t chunkNumber);
+
+  /// Stop loading lazily once all chunks are loaded
+  void releaseSaveGameLoader();
+
+  /// Load all nodes like an eagerly loaded savegame, for savegames whose heights aren't settled
+  void loadSaveGameAtOnce();
+
+  /// Check if a node has been loaded completely, without waiting for it
+  bool isNodeLoaded(int index) const;
 
   /** \brief Get a bitmask that represents same-tile neighbors
   * Checks all neighboring tiles and returns the elevated neighbors in a bitmask:
@@ -160,11 +358,9 @@ private:
   * [ 0  0  0  0   0  0  0  0 ]
   * @param pMapNode Pointer to the map node to calculate mask for.
   * @param neighborNodes Neighbor nodes.
-  * @return Uint that stores the neighbor tiles
+  * @return Bitmask of same-tile neighbors for each layer
   */
-  std::vector<uint8_t> calculateAutotileBitmask(const MapNode *const pMapNode, const std::vector<NeighborNode> &neighborNodes);
-
-  SDL_Color getColorOfPixelInSurface(SDL_Surface *surface, int x, int y) const;
+  std::array<uint8_t, LAYERS_COUNT> calculateAutotileBitmask(const MapNode *const pMapNode, const NeighborNodes &neighborNodes);
 
   bool isClickWithinTile(const SDL_Point &screenCoordinates, Point isoCoordinate, const Layer &layer) const;
 
@@ -187,7 +383,13 @@ private:
   * @param includeCentralNode if set to true include the central node in the result.
   * @return All neighbor nodes.
   */
-  std::vector<NeighborNode> getNeighborNodes(const Point &isoCoordinates, const bool includeCentralNode);
+  NeighborNodes getNeighborNodes(const Point &isoCoordinates, const bool includeCentralNode);
+
+  /** \brief Get all neighbor nodes of a map node without the node itself, using index arithmetic.
+  * @param index index of the map node.
+  * @return All neighbor nodes, in the order of neighborOffsets.
+  */
+  NeighborNodes getNeighborNodes(int index);
 
   /** \brief Change map node height.
   * @param isoCoordinates iso coordinates.
@@ -200,6 +402,23 @@ private:
   */
   void updateNodeNeighbors(std::vector<MapNode *> &nodes);
 
+  /** \brief Change the heights of the nodes and all affected nodes until no neighbors differ by more than one level.
+  * Sets the elevation bitmasks of all affected nodes. They're collected in m_nodesToBeUpdated, nodes whose elevation
+  * bitmask changed are collected in m_nodesToDemolish.
+  * @param nodes Nodes which have to be updated.
+  */
+  void settleNodeHeights(std::vector<MapNode *> &nodes);
+
+  /// Demolish the nodes that have been collected in m_nodesToDemolish
+  void demolishChangedNodes();
+
+  /** \brief Check if updating the nodes would change any heights
+  * @param begin index of the first node to check
+  * @param end index after the last node to check
+  * @return true if no neighbors differ by more than one level and no node needs to be elevated.
+  */
+  bool areNodeHeightsSettled(size_t begin, size_t end);
+
   /** \brief Get elevated bit mask of the map node.
   * @param pMapNode Pointer to the map node to calculate elevated bit mask.
   * @param neighbors All neighbor map nodes.
@@ -213,16 +432,76 @@ private:
   * @param neighbors All neighbor map nodes.
   * @return true in case that height has been changed, otherwise false.
   */
-  bool updateHeight(MapNode &mapNode, const bool higher, std::vector<NeighborNode> &neighbors);
+  bool updateHeight(MapNode &mapNode, const bool higher, const NeighborNodes &neighbors);
 
   /** \brief For implementing frustum culling, find all map nodes which are visible on the screen. Only visible nodes will be rendered.
   */
   void calculateVisibleMap(void);
 
+  /// Get the bounds of the nodes on screen, including the ones below the screen whose height pushes them into view
+  ScreenDiamond calculateScreenDiamond() const;
+
+  /** @brief Mark the chunk of a node as dirty and remember the node, so the screen is redrawn where its sprite is
+   * Must be called before the node changes: the screen rect its sprite has been drawn to is damaged right away, the
+   * rect of the changed sprite is damaged in the next refresh.
+   */
+  void markNodeChanged(const Point &isoCoordinates);
+
+  /// Add the screen rects of the sprites of all changed nodes to the damage region
+  void damageChangedNodes();
+
+  MapGrid m_grid;
+  MapChunks m_chunks;
   std::vector<MapNode> mapNodes;
   std::vector<MapNode *> mapNodesInDrawingOrder;
   Sprite **pMapNodesVisible;
   int m_visibleNodesCount = 0;
+  SpriteBatcher m_spriteBatcher;
+  MapDrawLists m_drawLists;
+  BatchStats m_renderStats;
+  int m_occludedQuads = 0;
+  TerrainChunkCache m_terrainCache;
+  MapOverview m_overview;
+  Minimap m_minimap;
+
+  /// the parts of the screen that changed since the map has been rendered the last time
+  DamageRegion m_damage;
+  /// nodes whose sprites changed since the last refresh
+  std::vector<Point> m_changedNodes;
+  /// nodes that changed since the map has been saved or its changes have been taken the last time
+  NodeMarks m_unsavedNodeMarks;
+  std::vector<int> m_unsavedNodes;
+  /// the camera and layers the map has been rendered with the last time, any change damages the whole screen
+  SDL_Point m_renderedCameraOffset{0, 0};
+  double m_renderedZoomLevel = 0;
+  unsigned int m_renderedLayers = 0;
+  LayerEditMode m_renderedLayerEditMode = LayerEditMode::TERRAIN;
+
+  // work buffers of updateNodeNeighbors, they're kept between calls so they don't need to be allocated again
+  NodeMarks m_nodesToBeUpdatedMarks;
+  NodeMarks m_nodesToElevateMarks;
+  NodeMarks m_nodesToDemolishMarks;
+  std::vector<int> m_nodesToBeUpdated;
+  std::vector<int> m_nodesToElevate;
+  std::vector<int> m_nodesToDemolish;
+  std::vector<int> m_nodesUpdatedHeight;
+
+  // state of a binary savegame that is loaded lazily
+  std::vector<ChunkLoadState> m_chunkLoadStates;
+  /// the chunks in the order they're decoded, the background loading follows it too
+  std::vector<size_t> m_chunkLoadOrder;
+  size_t m_nextChunkToLoad = 0;
+  size_t m_loadedChunkCount = 0;
+  /// tile handles of the tile references of the savegame
+  std::vector<TileId> m_saveGameTileIds;
+  /// the latest state of every node the journal changes, sorted by node index
+  SaveGameJournal::Batch m_journalChanges;
+  std::vector<TileId> m_journalTileIds;
+  /// the map brings loaded nodes up to date, which are no changes of the player
+  bool m_isLoadingChunks = false;
+  /// nullptr once all nodes are loaded. Its workers use the members above, so it's destroyed before them
+  std::unique_ptr<SaveGameLoader> m_saveGameLoader;
+
   int m_columns;
   int m_rows;
   std::default_random_engine randomEngine;
@@ -234,12 +513,18 @@ private:
   Signal::Signal<void(const MapNode &)> signalPlaceBuilding;
   Signal::Signal<void(const MapNode &)> signalPlaceZone;
   Signal::Signal<void(MapNode *)> signalDemolish;
+  Signal::Signal<void(const MapNode &)> signalChangeTile;
+  Signal::Signal<void(const MapNode &)> signalChangeHeight;
 
 public:
   // Callback functions
   void registerCbPlaceBuilding(std::function<void(const MapNode &)> const &cb) { signalPlaceBuilding.connect(cb); }
   void registerCbPlaceZone(std::function<void(const MapNode &)> const &cb) { signalPlaceZone.connect(cb); }
   void registerCbDemolish(std::function<void(MapNode *)> const &cb) { signalDemolish.connect(cb); }
+  /// called for every node a tile is placed on
+  void registerCbChangeTile(std::function<void(const MapNode &)> const &cb) { signalChangeTile.connect(cb); }
+  /// called for every node whose height changed
+  void registerCbChangeHeight(std::function<void(const MapNode &)> const &cb) { signalChangeHeight.connect(cb); }
 };
 
 #endif
@@ -0,0 +1,250 @@
+#include "RenderBenchmark.hxx"
+
+#include "Engine.hxx"
+#include "Map.hxx"
+#include "ResourcesManager.hxx"
+#include "UIManager.hxx"
+#include "WindowManager.hxx"
+#include "basics/Camera.hxx"
+#include "basics/GameStates.hxx"
+#include "basics/Settings.hxx"
+#include "render/RenderSnapshot.hxx"
+#include "render/SoftwareRasterizer.hxx"
+#include "FrameTimeStats.hxx"
+#include "Filesystem.hxx"
+#include "LOG.hxx"
+#include "json.hxx"
+
+#include <SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using json = nlohmann::json;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+double milliseconds(Clock::time_point start, Clock::time_point end)
+{
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::string frameFileName(size_t frame)
+{
+  std::ostringstream fileName;
+  fileName << "frame_" << std::setw(5) << std::setfill('0') << frame << ".png";
+  return fileName.str();
+}
+} // namespace
+
+bool RenderBenchmark::run(const std::string &scriptFile, const std::string &outputDirectory,
+                          const std::string &referenceDirectory)
+{
+  std::ifstream scriptStream(scriptFile);
+  const json script = json::parse(scriptStream, nullptr, false);
+
+  if (!scriptStream || script.is_discarded())
+  {
+    LOG(LOG_ERROR) << "Could not parse benchmark script " << scriptFile;
+    return false;
+  }
+
+  m_cameraPath.clear();
+  for (const auto &keyFrame : script.value("CameraPath", json::array()))
+  {
+    m_cameraPath.push_back({{keyFrame.value("X", 0), keyFrame.value("Y", 0), 0, 0},
+                            keyFrame.value("Zoom", 1.0),
+                            std::max(keyFrame.value("Frames", 1), 1)});
+  }
+
+  if (m_cameraPath.empty())
+  {
+    LOG(LOG_ERROR) << "The benchmark script " << scriptFile << " has no camera path";
+    return false;
+  }
+
+  Engine &engine = Engine::instance();
+  const std::string saveGame = script.value("SaveGame", "");
+  if (saveGame.empty())
+  {
+    engine.newGame();
+  }
+  else
+  {
+    engine.loadGame(saveGame);
+  }
+
+  if (engine.map == nullptr)
+  {
+    LOG(LOG_ERROR) << "Could not load the map " << saveGame;
+    return false;
+  }
+
+  UIManager &uiManager = UIManager::instance();
+  uiManager.init();
+  GameStates::instance().drawUI = script.value("DrawUI", true);
+
+  std::ofstream timing;
+  if (fs::createDirectories(outputDirectory))
+  {
+    timing.open(fs::joinPath(outputDirectory, "timing.csv"));
+  }
+  if (!timing)
+  {
+    LOG(LOG_ERROR) << "Could not write to the output directory " << outputDirectory;
+    return false;
+  }
+  timing << "frame,camera_ms,record_map_ms,submit_ms,ui_ms,total_ms,draw_calls,occluded_quads,redrawn_pixels,"
+            "different_pixels\n";
+
+  SDL_Renderer *renderer = WindowManager::instance().getRenderer();
+  int width = 0;
+  int height = 0;
+  SDL_GetRendererOutputSize(renderer, &width, &height);
+  SDL_Surface *image = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+
+  const bool useSoftwareRasterizer = Settings::instance().useSoftwareRasterizer();
+  SoftwareRasterizer softwareRasterizer;
+  softwareRasterizer.addTextureAtlas(ResourcesManager::instance().getTileAtlas());
+
+  RenderSnapshot snapshot;
+  FrameTimeStats totalTimes;
+  size_t frame = 0;
+  size_t differentFrames = 0;
+
+  for (size_t keyFrame = 0; keyFrame < m_cameraPath.size(); ++keyFrame)
+  {
+    for (int step = 0; step < m_cameraPath[keyFrame].frames; ++step, ++frame)
+    {
+      // moving the camera refreshes the sprites of the map
+      const Clock::time_point start = Clock::now();
+      moveCamera(keyFrame, step);
+      const Clock::time_point cameraMoved = Clock::now();
+
+      snapshot.clear();
+      engine.map->renderMap(snapshot);
+      const Clock::time_point mapRecorded = Clock::now();
+
+      SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+      SDL_RenderClear(renderer);
+      if (useSoftwareRasterizer)
+      {
+        softwareRasterizer.submit(renderer, snapshot);
+      }
+      else
+      {
+        snapshot.submit(renderer);
+      }
+      const Clock::time_point submitted = Clock::now();
+
+      if (GameStates::instance().drawUI)
+      {
+        uiManager.drawUI();
+      }
+      const Clock::time_point end = Clock::now();
+      totalTimes.add(milliseconds(start, end));
+
+      // reading back the frame isn't part of the measured time
+      SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGBA32, image->pixels, image->pitch);
+      SDL_RenderPresent(renderer);
+
+      const std::string fileName = frameFileName(frame);
+      const std::string framePath = fs::joinPath(outputDirectory, fileName);
+      if (IMG_SavePNG(image, framePath.c_str()) != 0)
+      {
+        LOG(LOG_WARNING) << "Could not write frame " << framePath << ": " << IMG_GetError();
+      }
+
+      timing << frame << "," << milliseconds(start, cameraMoved) << "," << milliseconds(cameraMoved, mapRecorded) << ","
+             << milliseconds(mapRecorded, submitted) << "," << milliseconds(submitted, end) << ","
+             << milliseconds(start, end) << "," << engine.map->getRenderStats().drawCalls << ","
+             << engine.map->getOccludedQuadCount() << ","
+             << (useSoftwareRasterizer ? softwareRasterizer.getRedrawnPixels() : static_cast<size_t>(width) * height)
+             << ",";
+
+      if (!referenceDirectory.empty())
+      {
+        const std::string referencePath = fs::joinPath(referenceDirectory, fileName);
+        SDL_Surface *reference = IMG_Load(referencePath.c_str());
+        size_t differentPixels = static_cast<size_t>(width) * height;
+
+        if (reference)
+        {
+          SDL_Surface *convertedReference = SDL_ConvertSurfaceFormat(reference, SDL_PIXELFORMAT_RGBA32, 0);
+          differentPixels = countDifferentPixels(image, convertedReference);
+          SDL_FreeSurface(convertedReference);
+          SDL_FreeSurface(reference);
+        }
+        else
+        {
+          LOG(LOG_WARNING) << "Could not load reference frame " << referencePath << ": " << IMG_GetError();
+        }
+
+        if (differentPixels > 0)
+        {
+          ++differentFrames;
+        }
+        timing << differentPixels;
+      }
+      timing << "\n";
+    }
+  }
+
+  SDL_FreeSurface(image);
+
+  LOG(LOG_INFO) << "Rendered " << frame << " benchmark frames with "
+                << (useSoftwareRasterizer ? "the software rasterizer" : "the renderer") << ", p50/p99 " << totalTimes.percentile(50) << "/"
+                << totalTimes.percentile(99) << " ms of the last " << totalTimes.size() << " frames";
+  if (!referenceDirectory.empty())
+  {
+    LOG(LOG_INFO) << differentFrames << " frames differ from the reference frames in " << referenceDirectory;
+  }
+
+  return differentFrames == 0;
+}
+
+size_t RenderBenchmark::countDifferentPixels(SDL_Surface *image, SDL_Surface *reference)
+{
+  if (!image || !reference || image->w != reference->w || image->h != reference->h ||
+      image->format->format != reference->format->format)
+  {
+    const int w = std::max(image ? image->w : 0, reference ? reference->w : 0);
+    const int h = std::max(image ? image->h : 0, reference ? reference->h : 0);
+    return static_cast<size_t>(w) * h;
+  }
+
+  const int bytesPerPixel = image->format->BytesPerPixel;
+  size_t differentPixels = 0;
+  for (int y = 0; y < image->h; ++y)
+  {
+    const Uint8 *imageRow = static_cast<const Uint8 *>(image->pixels) + y * image->pitch;
+    const Uint8 *referenceRow = static_cast<const Uint8 *>(reference->pixels) + y * reference->pitch;
+    for (int x = 0; x < image->w; ++x)
+    {
+      if (!std::equal(imageRow + x * bytesPerPixel, imageRow + (x + 1) * bytesPerPixel, referenceRow + x * bytesPerPixel))
+      {
+        ++differentPixels;
+      }
+    }
+  }
+  return differentPixels;
+}
+
+void RenderBenchmark::moveCamera(size_t keyFrame, int frame) const
+{
+  const KeyFrame &from = m_cameraPath[keyFrame];
+  const KeyFrame &to = (keyFrame + 1 < m_cameraPath.size()) ? m_cameraPath[keyFrame + 1] : from;
+  const double t = static_cast<double>(frame) / from.frames;
+
+  // the camera is centered on nodes, so the path moves from node to node
+  Camera &camera = Camera::instance();
+  camera.setCenterIsoCoordinates({static_cast<int>(std::lround(from.center.x + (to.center.x - from.center.x) * t)),
+                                  static_cast<int>(std::lround(from.center.y + (to.center.y - from.center.y) * t)), 0, 0});
+  // centers the screen on the new coordinates and refreshes the map
+  camera.setZoomLevel(from.zoomLevel + (to.zoomLevel - from.zoomLevel) * t);
+}
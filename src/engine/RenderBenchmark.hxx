@@ -0,0 +1,58 @@
+#ifndef RENDERBENCHMARK_HXX_
+#define RENDERBENCHMARK_HXX_
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+#include "basics/point.hxx"
+
+/** @brief Renders a scripted camera path over a map and measures each frame
+ * Meant for headless mode, where the software renderer draws into an off-screen surface, but it works with a window too.
+ * The script is a JSON file:
+ * @code{.json}
+ * {
+ *   "SaveGame": "resources/save/benchmark.cts",
+ *   "DrawUI": true,
+ *   "CameraPath": [{"X": 64, "Y": 64, "Zoom": 1.0, "Frames": 60}, {"X": 20, "Y": 100, "Zoom": 2.0, "Frames": 1}]
+ * }
+ * @endcode
+ * Without a savegame a new map is generated. Each keyframe of the camera path is followed by the given number of frames
+ * that move the camera to the next keyframe, the last keyframe is simply held for its frames.
+ * Every frame is written as PNG to the output directory and its timing is appended to timing.csv there. If a reference
+ * directory with the frames of an earlier run is given, the frames are compared pixel by pixel.
+ * To compare the SoftwareRasterizer with SDL's software renderer, run the script once with and once without it and pass
+ * the frames of the first run as reference to the second one.
+ */
+class RenderBenchmark
+{
+public:
+  /** @brief Run the script and write the frames and their timing
+   * The game must be initialized.
+   * @param scriptFile path of the JSON script
+   * @param outputDirectory directory the frames and timing.csv are written to, created if it doesn't exist
+   * @param referenceDirectory directory with the frames to compare to, empty to skip the comparison
+   * @return false if the script couldn't be run or a frame differs from its reference
+   */
+  bool run(const std::string &scriptFile, const std::string &outputDirectory, const std::string &referenceDirectory);
+
+  /** @brief Count the pixels that differ between two images
+   * @return the number of differing pixels, all pixels of the larger image if the sizes differ
+   */
+  static size_t countDifferentPixels(SDL_Surface *image, SDL_Surface *reference);
+
+private:
+  struct KeyFrame
+  {
+    Point center;
+    double zoomLevel;
+    int frames;
+  };
+
+  /// Place the camera at the given frame of the path
+  void moveCamera(size_t keyFrame, int frame) const;
+
+  std::vector<KeyFrame> m_cameraPath;
+};
+
+#endif
@@ -6,11 +6,14 @@
 #include "LOG.hxx"
 #include "Exception.hxx"
 #include "Filesystem.hxx"
+#include "render/MapOverview.hxx"
 
 #include <SDL_image.h>
 
 #include "json.hxx"
 
+#include <algorithm>
+
 using json = nlohmann::json;
 
 ResourcesManager::ResourcesManager() { loadUITexture(); }
@@ -19,8 +22,44 @@ ResourcesManager::~ResourcesManager() { flush(); }
 
 void ResourcesManager::loadTexture(const std::string &id, const std::string &fileName)
 {
-  m_surfaceMap[id] = createSurfaceFromFile(fileName);
-  m_tileTextureMap[id] = createTextureFromSurface(m_surfaceMap[id]);
+  SDL_Surface *surface = createSurfaceFromFile(fileName);
+  m_tileTextureMap[id] = createTextureFromSurface(surface);
+  m_hitMaskMap[id] = HitMask(surface);
+  m_tileColorMap[id] = MapOverview::averageColor(surface);
+
+  // the surface is only needed until the spritesheet has been packed into the atlas
+  if (m_surfaceMap.count(id))
+  {
+    SDL_FreeSurface(m_surfaceMap[id]);
+  }
+  m_surfaceMap[id] = surface;
+}
+
+void ResourcesManager::buildTileAtlas()
+{
+  // add the spritesheets in a fixed order, so the atlas layout doesn't change between runs
+  std::vector<std::string> ids;
+  ids.reserve(m_surfaceMap.size());
+  for (const auto &it : m_surfaceMap)
+  {
+    ids.push_back(it.first);
+  }
+  std::sort(ids.begin(), ids.end());
+
+  m_tileAtlas.clear();
+  for (const auto &id : ids)
+  {
+    m_tileAtlas.add(id, m_surfaceMap[id]);
+  }
+  // the software rasterizer draws the map from the pixels of the pages
+  m_tileAtlas.setKeepsPageSurfaces(Settings::instance().useSoftwareRasterizer());
+  m_tileAtlas.build(WindowManager::instance().getRenderer());
+
+  for (const auto &it : m_surfaceMap)
+  {
+    SDL_FreeSurface(it.second);
+  }
+  m_surfaceMap.clear();
 }
 
 void ResourcesManager::loadUITexture()
@@ -76,13 +115,30 @@ SDL_Texture *ResourcesManager::getTileTexture(const std::string &id)
   throw UIError(TRACE_INFO "No texture found for " + id);
 }
 
-SDL_Surface *ResourcesManager::getTileSurface(const std::string &id)
+const HitMask &ResourcesManager::getTileHitMask(const std::string &id) const
+{
+  const auto it = m_hitMaskMap.find(id);
+  if (it != m_hitMaskMap.end())
+  {
+    return it->second;
+  }
+  throw UIError(TRACE_INFO "No hit mask found for " + id);
+}
+
+SDL_Color ResourcesManager::getTileColor(const std::string &id) const
 {
-  if (m_surfaceMap.find(id) != m_surfaceMap.end())
+  const auto it = m_tileColorMap.find(id);
+  if (it != m_tileColorMap.end())
   {
-    return m_surfaceMap.at(id);
+    return it->second;
   }
-  throw UIError(TRACE_INFO "No surface found for " + id);
+  throw UIError(TRACE_INFO "No color found for " + id);
+}
+
+SDL_Surface *ResourcesManager::getTileSurface(const std::string &id) const
+{
+  const auto it = m_surfaceMap.find(id);
+  return (it != m_surfaceMap.end()) ? it->second : nullptr;
 }
 
 SDL_Surface *ResourcesManager::createSurfaceFromFile(const std::string &fileName)
@@ -112,11 +168,15 @@ SDL_Texture *ResourcesManager::createTextureFromSurface(SDL_Surface *surface)
 
 void ResourcesManager::flush()
 {
+  m_tileAtlas.clear();
+
   for (const auto &it : m_surfaceMap)
   {
     SDL_FreeSurface(it.second);
   }
   m_surfaceMap.clear();
+  m_hitMaskMap.clear();
+  m_tileColorMap.clear();
 
   for (const auto &it : m_tileTextureMap)
   {
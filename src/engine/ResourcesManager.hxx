@@ -7,6 +7,8 @@
 #include <SDL.h>
 
 #include "TileManager.hxx"
+#include "render/HitMask.hxx"
+#include "render/TextureAtlas.hxx"
 
 enum ButtonState
 {
@@ -31,10 +33,26 @@ public:
   /** Retrieves Color of a specific tileID at coordinates with the texture */
 
   SDL_Texture *getTileTexture(const std::string &id);
-  SDL_Surface *getTileSurface(const std::string &id);
+
+  /** retrieves the mask of the non-transparent pixels of a tile spritesheet, used for picking */
+  const HitMask &getTileHitMask(const std::string &id) const;
+
+  /** retrieves the average color of a tile spritesheet, used for the map overview */
+  SDL_Color getTileColor(const std::string &id) const;
+
+  /** retrieves the surface of a tile spritesheet, nullptr once the spritesheets have been packed into the atlas */
+  SDL_Surface *getTileSurface(const std::string &id) const;
 
   void loadTexture(const std::string &id, const std::string &fileName);
 
+  /** @brief Pack all loaded tile spritesheets (including shore and slope sheets) into the tile texture atlas
+   * Should be called after all tile textures have been loaded. The surfaces of the spritesheets are released afterwards.
+   */
+  void buildTileAtlas();
+
+  /** retrieves the texture atlas that contains all tile spritesheets */
+  const TextureAtlas &getTileAtlas() const { return m_tileAtlas; };
+
 private:
   ResourcesManager();
   ~ResourcesManager();
@@ -56,7 +74,11 @@ private:
   std::unordered_map<std::string, std::unordered_map<std::string, SDL_Texture *>> m_uiTextureMap;
 
   std::unordered_map<std::string, SDL_Texture *> m_tileTextureMap;
+  /// surfaces of the tile spritesheets that have not been added to the atlas yet
   std::unordered_map<std::string, SDL_Surface *> m_surfaceMap;
+  std::unordered_map<std::string, HitMask> m_hitMaskMap;
+  std::unordered_map<std::string, SDL_Color> m_tileColorMap;
+  TextureAtlas m_tileAtlas;
 };
 
 #endif
@@ -1,7 +1,8 @@
 #include "Sprite.hxx"
 
 #include "ResourcesManager.hxx"
-#include "WindowManager.hxx"
+#include "TileManager.hxx"
+#include "render/SpriteBatcher.hxx"
 #include "basics/Camera.hxx"
 #include "basics/isoMath.hxx"
 #include "map/MapLayers.hxx"
@@ -16,96 +17,114 @@
 
 Sprite::Sprite(Point _isoCoordinates) : isoCoordinates(_isoCoordinates)
 {
-  m_screenCoordinates = convertIsoToScreenCoordinates(_isoCoordinates);
-  m_SpriteData.resize(LAYERS_COUNT); // resize the spritedata vector to the amount of layers we have.
+  m_screenCoordinates = convertIsoToScreenCoordinates(_isoCoordinates, true);
 }
 
-void Sprite::render() const
+void Sprite::render(SpriteBatcher &batcher) const
+{
+  render(batcher, Camera::instance().cameraOffset(), ~0U, highlightSprite);
+}
+
+void Sprite::render(SpriteBatcher &batcher, const SDL_Point &offset, unsigned int layerMask, bool highlight) const
 {
 #ifdef MICROPROFILE_ENABLED
   MICROPROFILE_SCOPEI("Map", "Sprite render", MP_RED);
 #endif
+  const bool isBlueprintMode = GameStates::instance().layerEditMode == LayerEditMode::BLUEPRINT;
+
   for (auto currentLayer : allLayersOrdered)
   {
-    if (MapLayers::isLayerActive(currentLayer) && m_SpriteData[currentLayer].texture)
-    {
-      if (highlightSprite)
-      {
-        SDL_SetTextureColorMod(m_SpriteData[currentLayer].texture, highlightColor.r, highlightColor.g, highlightColor.b);
-      }
+    SpriteQuad quad;
 
-      if (GameStates::instance().layerEditMode == LayerEditMode::BLUEPRINT && currentLayer != Layer::BLUEPRINT && currentLayer != Layer::UNDERGROUND)
-      {
-        SDL_SetTextureAlphaMod(m_SpriteData[currentLayer].texture, 80);
-      }
-      else
-      {
-        SDL_SetTextureAlphaMod(m_SpriteData[currentLayer].texture, m_SpriteData[currentLayer].alpha);
-      }
+    if ((layerMask & (1U << currentLayer)) && MapLayers::isLayerActive(currentLayer) && getQuad(currentLayer, quad))
+    {
+      // color and alpha modulation are passed as vertex colors, so the shared atlas texture is never modified
+      SDL_Color color{255, 255, 255, m_SpriteData[currentLayer].alpha};
 
-      if (m_SpriteData[currentLayer].clipRect.w != 0)
-      {
-        SDL_RenderCopy(WindowManager::instance().getRenderer(), m_SpriteData[currentLayer].texture,
-                       &m_SpriteData[currentLayer].clipRect, &m_SpriteData[currentLayer].destRect);
-      }
-      else
+      if (highlight)
       {
-        SDL_RenderCopy(WindowManager::instance().getRenderer(), m_SpriteData[currentLayer].texture, nullptr,
-                       &m_SpriteData[currentLayer].destRect);
+        color.r = highlightColor.r;
+        color.g = highlightColor.g;
+        color.b = highlightColor.b;
       }
 
-      if (highlightSprite)
+      if (isBlueprintMode && currentLayer != Layer::BLUEPRINT && currentLayer != Layer::UNDERGROUND)
       {
-        SDL_SetTextureColorMod(m_SpriteData[currentLayer].texture, 255, 255, 255);
+        color.a = 80;
       }
 
-      SDL_SetTextureAlphaMod(m_SpriteData[currentLayer].texture, 255);
+      quad.destRect.x -= offset.x;
+      quad.destRect.y -= offset.y;
+      batcher.draw(quad.texture, quad.bounds, quad.srcRect, quad.destRect, color);
     }
   }
 }
 
+bool Sprite::getQuad(Layer layer, SpriteQuad &quad) const
+{
+  const SpriteData &spriteData = m_SpriteData[layer];
+
+  if (!spriteData.texture)
+  {
+    return false;
+  }
+
+  quad.texture = spriteData.texture;
+  quad.bounds = {0, 0, 0, 0};
+
+  if (spriteData.atlasRegion.isValid())
+  {
+    quad.texture = ResourcesManager::instance().getTileAtlas().getPage(spriteData.atlasRegion.page);
+    quad.bounds = spriteData.atlasRegion.rect;
+  }
+  else
+  {
+    SDL_QueryTexture(spriteData.texture, nullptr, nullptr, &quad.bounds.w, &quad.bounds.h);
+  }
+
+  // sprites without a clip rect show the whole spritesheet
+  quad.srcRect = (spriteData.clipRect.w != 0) ? spriteData.clipRect : SDL_Rect{0, 0, quad.bounds.w, quad.bounds.h};
+  quad.destRect = spriteData.destRect;
+  return true;
+}
+
 void Sprite::refresh(const Layer &layer)
 {
   if (m_currentZoomLevel != Camera::instance().zoomLevel() || m_needsRefresh)
   {
+    m_currentZoomLevel = Camera::instance().zoomLevel();
+    // the geometry of tile spritesheets is shared by all sprites and only computed once per zoom level. The table might
+    // not have been scaled yet if the sprite is refreshed before the map (e.g. when a texture is set), in this case the
+    // sprite computes its geometry itself.
+    const SpriteGeometryTable &geometryTable = TileManager::instance().getSpriteGeometry();
+    const bool useGeometryTable = geometryTable.getZoomLevel() == m_currentZoomLevel;
+
     for (auto currentLayer : allLayersOrdered)
     {
-      if (m_SpriteData[currentLayer].texture)
+      SpriteData &spriteData = m_SpriteData[currentLayer];
+
+      if (!spriteData.texture || (layer != NONE && currentLayer != layer))
       {
-        if (layer != NONE && currentLayer != layer)
-        {
-          continue;
-        }
-        m_currentZoomLevel = Camera::instance().zoomLevel();
-        int spriteSheetHeight = 0;
-        SDL_QueryTexture(m_SpriteData[currentLayer].texture, nullptr, nullptr, nullptr, &spriteSheetHeight);
-        // we need to offset the cliprect.y coodinate, because we've moved the "originpoint" for drawing the sprite to the screen on the bottom.
-        // the sprites need to start at the bottom, so the cliprect must too.
-        m_SpriteData[currentLayer].clipRect.y = spriteSheetHeight - m_SpriteData[currentLayer].clipRect.h;
-
-        if (m_SpriteData[currentLayer].clipRect.w != 0)
-        {
-          m_SpriteData[currentLayer].destRect.w =
-              static_cast<int>(std::round(static_cast<double>(m_SpriteData[currentLayer].clipRect.w) * m_currentZoomLevel));
-          m_SpriteData[currentLayer].destRect.h =
-              static_cast<int>(std::round(static_cast<double>(m_SpriteData[currentLayer].clipRect.h) * m_currentZoomLevel));
-        }
-        else
-        {
-          SDL_QueryTexture(m_SpriteData[currentLayer].texture, nullptr, nullptr, &m_SpriteData[currentLayer].destRect.w,
-                           &m_SpriteData[currentLayer].destRect.h);
-
-          m_SpriteData[currentLayer].destRect.w =
-              static_cast<int>(std::round(static_cast<double>(m_SpriteData[currentLayer].clipRect.w) * m_currentZoomLevel));
-          m_SpriteData[currentLayer].destRect.h =
-              static_cast<int>(std::round(static_cast<double>(m_SpriteData[currentLayer].clipRect.h) * m_currentZoomLevel));
-        }
+        continue;
+      }
+
+      if (useGeometryTable && spriteData.geometryId != SpriteGeometryTable::NO_GEOMETRY)
+      {
+        const SpriteGeometry &geometry = geometryTable.get(spriteData.geometryId);
+        spriteData.clipRect.y = geometry.clipY;
+        spriteData.destRect.w = geometry.width;
+        spriteData.destRect.h = geometry.height;
+      }
+      else
+      {
+        computeGeometry(spriteData);
       }
     }
   }
 
-  // convert this tiles isometric coordinates to screen coordinates (with camera offset / zoomlevel taken into account.
-  m_screenCoordinates = convertIsoToScreenCoordinates(isoCoordinates);
+  // convert this tiles isometric coordinates to world coordinates (zoomlevel taken into account). The camera offset is applied
+  // while rendering, so moving the camera doesn't require a refresh.
+  m_screenCoordinates = convertIsoToScreenCoordinates(isoCoordinates, true);
 
   for (auto &it : m_SpriteData)
   {
@@ -121,11 +140,30 @@ void Sprite::refresh(const Layer &layer)
   m_needsRefresh = false;
 }
 
-void Sprite::setTexture(SDL_Texture *texture, Layer layer)
+void Sprite::computeGeometry(SpriteData &spriteData) const
+{
+  int spriteSheetHeight = 0;
+  SDL_QueryTexture(spriteData.texture, nullptr, nullptr, nullptr, &spriteSheetHeight);
+  // we need to offset the cliprect.y coodinate, because we've moved the "originpoint" for drawing the sprite to the screen on the bottom.
+  // the sprites need to start at the bottom, so the cliprect must too.
+  spriteData.clipRect.y = spriteSheetHeight - spriteData.clipRect.h;
+
+  if (spriteData.clipRect.w == 0)
+  {
+    SDL_QueryTexture(spriteData.texture, nullptr, nullptr, &spriteData.destRect.w, &spriteData.destRect.h);
+  }
+  spriteData.destRect.w = static_cast<int>(std::round(static_cast<double>(spriteData.clipRect.w) * m_currentZoomLevel));
+  spriteData.destRect.h = static_cast<int>(std::round(static_cast<double>(spriteData.clipRect.h) * m_currentZoomLevel));
+}
+
+void Sprite::setTexture(SDL_Texture *texture, Layer layer, const AtlasRegion &atlasRegion,
+                        SpriteGeometryTable::GeometryId geometryId)
 {
   if (!texture)
     throw UIError(TRACE_INFO "Called Sprite::setTexture() with a non valid texture");
   m_SpriteData[layer].texture = texture;
+  m_SpriteData[layer].atlasRegion = atlasRegion;
+  m_SpriteData[layer].geometryId = geometryId;
   m_needsRefresh = true;
   refresh(layer);
 }
@@ -133,6 +171,41 @@ void Sprite::setTexture(SDL_Texture *texture, Layer layer)
 void Sprite::setClipRect(SDL_Rect clipRect, const Layer layer) { m_SpriteData[layer].clipRect = clipRect; }
 void Sprite::setDestRect(SDL_Rect destRect, Layer layer) { m_SpriteData[layer].destRect = destRect; }
 
+SDL_Rect Sprite::getDestRect(Layer layer) const { return toScreenRect(m_SpriteData[layer].destRect); }
+
+SDL_Rect Sprite::toScreenRect(SDL_Rect worldRect)
+{
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+  worldRect.x -= cameraOffset.x;
+  worldRect.y -= cameraOffset.y;
+  return worldRect;
+}
+
+SDL_Rect Sprite::getWorldBoundingBox(unsigned int layerMask) const
+{
+  SDL_Rect boundingBox{0, 0, 0, 0};
+
+  for (unsigned int layer = 0; layer < LAYERS_COUNT; ++layer)
+  {
+    const SpriteData &spriteData = m_SpriteData[layer];
+
+    if (!(layerMask & (1U << layer)) || spriteData.texture == nullptr || SDL_RectEmpty(&spriteData.destRect))
+    {
+      continue;
+    }
+    if (SDL_RectEmpty(&boundingBox))
+    {
+      boundingBox = spriteData.destRect;
+    }
+    else
+    {
+      SDL_UnionRect(&boundingBox, &spriteData.destRect, &boundingBox);
+    }
+  }
+
+  return boundingBox;
+}
+
 SDL_Rect Sprite::getActiveClipRect()
 {
   if (MapLayers::isLayerActive(Layer::BUILDINGS) && m_SpriteData[Layer::BUILDINGS].clipRect.w != 0 &&
@@ -156,11 +229,11 @@ SDL_Rect Sprite::getActiveDestRect()
   if (MapLayers::isLayerActive(Layer::BUILDINGS) && m_SpriteData[Layer::BUILDINGS].destRect.w != 0 &&
       m_SpriteData[Layer::BUILDINGS].destRect.h != 0)
   {
-    return m_SpriteData[Layer::BUILDINGS].destRect;
+    return toScreenRect(m_SpriteData[Layer::BUILDINGS].destRect);
   }
   else if (MapLayers::isLayerActive(Layer::TERRAIN))
   {
-    return m_SpriteData[Layer::TERRAIN].destRect;
+    return toScreenRect(m_SpriteData[Layer::TERRAIN].destRect);
   }
   return {0, 0, 0, 0};
 }
@@ -170,4 +243,6 @@ void Sprite::clearSprite(Layer layer)
   m_SpriteData[layer].clipRect = {0, 0, 0, 0};
   m_SpriteData[layer].destRect = {0, 0, 0, 0};
   m_SpriteData[layer].texture = nullptr;
+  m_SpriteData[layer].atlasRegion = AtlasRegion{};
+  m_SpriteData[layer].geometryId = SpriteGeometryTable::NO_GEOMETRY;
 }
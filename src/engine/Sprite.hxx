@@ -2,10 +2,14 @@
 #define SPRITE_HXX_
 
 #include <SDL.h>
-#include <vector>
+#include <array>
 
 #include "basics/point.hxx"
 #include "common/enums.hxx"
+#include "render/SpriteGeometry.hxx"
+#include "render/TextureAtlas.hxx"
+
+class SpriteBatcher;
 
 struct SpriteData
 {
@@ -13,6 +17,22 @@ struct SpriteData
   SDL_Rect clipRect{0, 0, 0, 0};
   SDL_Rect destRect{0, 0, 0, 0};
   unsigned char alpha = 255;
+  /// region of the spritesheet in the tile texture atlas, invalid if the sprite is drawn from its own texture
+  AtlasRegion atlasRegion;
+  /// geometry of the spritesheet in the TileManager's sprite geometry table, if the texture is a tile spritesheet
+  SpriteGeometryTable::GeometryId geometryId = SpriteGeometryTable::NO_GEOMETRY;
+};
+
+/// A layer of a sprite as it is passed to the SpriteBatcher
+struct SpriteQuad
+{
+  SDL_Texture *texture = nullptr;
+  /// part of the texture that holds the spritesheet
+  SDL_Rect bounds{0, 0, 0, 0};
+  /// source rect relative to the bounds
+  SDL_Rect srcRect{0, 0, 0, 0};
+  /// destination rect in world coordinates
+  SDL_Rect destRect{0, 0, 0, 0};
 };
 
 struct SpriteRGBColor
@@ -35,10 +55,36 @@ public:
   explicit Sprite(Point isoCoordinates);
   virtual ~Sprite() = default;
 
-  void render() const;
+  /** @brief Add all active layers of the sprite to a batch
+   * @param batcher the batch the sprite's quads are added to
+   */
+  void render(SpriteBatcher &batcher) const;
+
+  /** @brief Add some of the active layers of the sprite to a batch
+   * @param batcher the batch the sprite's quads are added to
+   * @param offset the offset that is subtracted from the world coordinates of the sprite (e.g. the camera offset)
+   * @param layerMask bitmask of the layers that should be drawn
+   * @param highlight draw the sprite with its highlight color
+   */
+  void render(SpriteBatcher &batcher, const SDL_Point &offset, unsigned int layerMask, bool highlight) const;
+
+  /** @brief Get the texture and rects that are used to draw a layer
+   * @param layer the layer to draw
+   * @param quad is set to the quad of the layer
+   * @return false if the layer has no texture
+   */
+  bool getQuad(Layer layer, SpriteQuad &quad) const;
   void refresh(const Layer &layer = Layer::NONE);
 
-  void setTexture(SDL_Texture *m_texture, Layer layer = Layer::TERRAIN);
+  /** @brief Set the texture of a layer
+   * @param texture the spritesheet
+   * @param layer the layer to set the texture for
+   * @param atlasRegion the spritesheet's region in the tile texture atlas. If it's invalid the texture is drawn directly
+   * @param geometryId the spritesheet's geometry in the TileManager's sprite geometry table. Without it the geometry is
+   * computed by the sprite itself
+   */
+  void setTexture(SDL_Texture *texture, Layer layer = Layer::TERRAIN, const AtlasRegion &atlasRegion = AtlasRegion{},
+                  SpriteGeometryTable::GeometryId geometryId = SpriteGeometryTable::NO_GEOMETRY);
   void setClipRect(SDL_Rect clipRect, Layer layer = Layer::TERRAIN);
   void setDestRect(SDL_Rect clipRect, Layer layer = Layer::TERRAIN);
 
@@ -48,22 +94,37 @@ public:
   bool highlightSprite = false;
   SpriteRGBColor highlightColor = SpriteHighlightColor::GRAY;
 
-  SDL_Rect getDestRect(Layer layer = Layer::TERRAIN) { return m_SpriteData[layer].destRect; };
+  /// get the destination rect of a layer in screen coordinates
+  SDL_Rect getDestRect(Layer layer = Layer::TERRAIN) const;
   SDL_Rect getClipRect(Layer layer = Layer::TERRAIN) { return m_SpriteData[layer].clipRect; };
   SDL_Rect getActiveClipRect();
   SDL_Rect getActiveDestRect();
   void setSpriteTranparencyFactor(const Layer &layer, unsigned char alpha) { m_SpriteData[layer].alpha = alpha; }
+  unsigned char getSpriteTransparencyFactor(Layer layer) const { return m_SpriteData[layer].alpha; }
   bool isLayerUsed(Layer layer);
 
+  /** @brief get the bounding box of all layers of this sprite
+   * @param layerMask bitmask of the layers that should be taken into account
+   * @return the bounding box in world coordinates (screen coordinates without the camera offset)
+   */
+  SDL_Rect getWorldBoundingBox(unsigned int layerMask = ~0U) const;
+
   Point isoCoordinates{0, 0, 0, 0};
 
 private:
+  /// convert a rect in world coordinates to screen coordinates by applying the camera offset
+  static SDL_Rect toScreenRect(SDL_Rect worldRect);
+
+  /// compute the clip rect offset and the scaled size of a layer without the sprite geometry table
+  void computeGeometry(SpriteData &spriteData) const;
+
+  /// position of the sprite in world coordinates, the destination rects are stored in world coordinates too
   SDL_Point m_screenCoordinates{0, 0};
 
   bool m_needsRefresh = false;
   double m_currentZoomLevel = 0;
 
-  std::vector<SpriteData> m_SpriteData;
+  std::array<SpriteData, LAYERS_COUNT> m_SpriteData;
 };
 
 #endif
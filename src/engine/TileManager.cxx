@@ -9,6 +9,7 @@
 #include "../services/Randomizer.hxx"
 
 #include <bitset>
+#include <limits>
 
 using json = nlohmann::json;
 
@@ -21,32 +22,44 @@ SDL_Texture *TileManager::getTexture(const std::string &tileID) const
 
 TileData *TileManager::getTileData(const std::string &id) noexcept
 {
-  if (m_tileData.count(id))
-    return &m_tileData[id];
-  return nullptr;
+  const auto it = m_tileData.find(id);
+  return (it != m_tileData.end()) ? &it->second : nullptr;
 }
 
-std::vector<std::string> TileManager::getAllTileIDsForZone(ZoneType zone, ZoneDensity zoneDensity, TileSize tileSize)
+TileId TileManager::getTileId(const std::string &tileID) const
 {
-  std::vector<std::string> results;
-  for (auto &tileData : m_tileData)
-  {
-    if (std::find(tileData.second.zoneTypes.begin(), tileData.second.zoneTypes.end(), +zone) != tileData.second.zoneTypes.end() &&
-        (zone == +ZoneType::AGRICULTURAL || std::find(tileData.second.zoneDensity.begin(), tileData.second.zoneDensity.end(),
-                                                      +zoneDensity) != tileData.second.zoneDensity.end()) &&
-        tileData.second.RequiredTiles.height == tileSize.height && tileData.second.RequiredTiles.width == tileSize.width &&
-        tileData.second.tileType != +TileType::ZONE)
+  const auto it = m_tileIds.find(tileID);
+  return (it != m_tileIds.end()) ? it->second : EMPTY_TILE_ID;
+}
+
+std::vector<TileId> TileManager::getAllTileIDsForZone(ZoneType zone, ZoneDensity zoneDensity, TileSize tileSize)
+{
+  std::vector<TileId> results;
+  for (size_t tileId = 1; tileId < m_tileDataByTileId.size(); ++tileId)
+  {
+    const TileData &tileData = *m_tileDataByTileId[tileId];
+
+    if (std::find(tileData.zoneTypes.begin(), tileData.zoneTypes.end(), +zone) != tileData.zoneTypes.end() &&
+        (zone == +ZoneType::AGRICULTURAL ||
+         std::find(tileData.zoneDensity.begin(), tileData.zoneDensity.end(), +zoneDensity) != tileData.zoneDensity.end()) &&
+        tileData.RequiredTiles.height == tileSize.height && tileData.RequiredTiles.width == tileSize.width &&
+        tileData.tileType != +TileType::ZONE)
     {
-      results.push_back(tileData.first);
+      results.push_back(static_cast<TileId>(tileId));
     }
   }
   return results;
 }
 
-std::vector<Point> TileManager::getTargetCoordsOfTileID(const Point &targetCoordinates, const std::string &tileID)
+TileFootprint TileManager::getTargetCoordsOfTileID(const Point &targetCoordinates, const std::string &tileID)
 {
-  std::vector<Point> occupiedCoords;
-  TileData *tileData = getTileData(tileID);
+  return getTargetCoordsOfTileID(targetCoordinates, getTileId(tileID));
+}
+
+TileFootprint TileManager::getTargetCoordsOfTileID(const Point &targetCoordinates, TileId tileId)
+{
+  TileFootprint occupiedCoords;
+  TileData *tileData = getTileData(tileId);
 
   if (!tileData)
   {
@@ -65,14 +78,14 @@ std::vector<Point> TileManager::getTargetCoordsOfTileID(const Point &targetCoord
         occupiedCoords.clear();
         return occupiedCoords;
       }
-      occupiedCoords.emplace_back(coords);
+      occupiedCoords.push_back(coords);
     }
   }
   return occupiedCoords;
 }
 
-std::optional<std::string> TileManager::getRandomTileIDForZoneWithRandomSize(ZoneType zone, ZoneDensity zoneDensity,
-                                                                             TileSize maxTileSize)
+std::optional<TileId> TileManager::getRandomTileIDForZoneWithRandomSize(ZoneType zone, ZoneDensity zoneDensity,
+                                                                        TileSize maxTileSize)
 
 {
   std::vector<TileSize> elligibleTileSizes;
@@ -103,42 +116,7 @@ std::optional<std::string> TileManager::getRandomTileIDForZoneWithRandomSize(Zon
   return *randomizer.choose(tileIDsForThisZone.begin(), tileIDsForThisZone.end());
 }
 
-Layer TileManager::getTileLayer(const std::string &tileID) const
-{
-  Layer layer = Layer::TERRAIN;
-  TileData *tileData = TileManager::instance().getTileData(tileID);
-  if (tileData)
-  {
-    switch (tileData->tileType)
-    {
-    case TileType::TERRAIN:
-      layer = Layer::TERRAIN;
-      break;
-    case TileType::BLUEPRINT:
-      layer = Layer::BLUEPRINT;
-      break;
-    case TileType::WATER:
-      layer = Layer::WATER;
-      break;
-    case TileType::UNDERGROUND:
-      layer = Layer::UNDERGROUND;
-      break;
-    case TileType::GROUNDDECORATION:
-      layer = Layer::GROUND_DECORATION;
-      break;
-    case TileType::ZONE:
-      layer = Layer::ZONE;
-      break;
-    case TileType::ROAD:
-      layer = Layer::ROAD;
-      break;
-    default:
-      layer = Layer::BUILDINGS;
-      break;
-    }
-  }
-  return layer;
-}
+Layer TileManager::getTileLayer(const std::string &tileID) const { return getTileLayer(getTileId(tileID)); }
 
 size_t TileManager::calculateSlopeOrientation(unsigned char bitMaskElevation)
 {
@@ -356,13 +334,209 @@ void TileManager::init()
 
   size_t idx = 0;
 
+  // handle 0 is reserved for empty layers
+  m_tileIds.clear();
+  m_tileIDStrings.assign(1, "");
+  m_tileDataByTileId.assign(1, nullptr);
+  m_tileLayers.assign(1, Layer::TERRAIN);
+  m_autoTiles.assign(1, false);
+  m_textures.assign(1, nullptr);
+  m_shoreTextures.assign(1, nullptr);
+  m_hitMasks.assign(1, nullptr);
+  m_shoreHitMasks.assign(1, nullptr);
+  m_overviewColors.assign(1, SDL_Color{0, 0, 0, SDL_ALPHA_TRANSPARENT});
+
   for (const auto &element : tileDataJSON.items())
   {
     std::string id;
     id = element.value().value("id", "");
     addJSONObjectToTileData(tileDataJSON, idx, id);
+    registerTileId(id);
     idx++;
   }
+
+  // the alpha masks of the buildings are computed from the surfaces, which are released when the atlas is packed
+  m_footprintCoverage.assign(m_tileIDStrings.size(), {});
+  for (size_t tileId = 1; tileId < m_tileIDStrings.size(); ++tileId)
+  {
+    addFootprintCoverage(static_cast<TileId>(tileId));
+  }
+
+  // the atlas can only be packed once all spritesheets are loaded
+  ResourcesManager::instance().buildTileAtlas();
+  const TextureAtlas &tileAtlas = ResourcesManager::instance().getTileAtlas();
+
+  m_atlasRegions.assign(m_tileIDStrings.size(), AtlasRegion{});
+  m_shoreAtlasRegions.assign(m_tileIDStrings.size(), AtlasRegion{});
+  for (size_t tileId = 1; tileId < m_tileIDStrings.size(); ++tileId)
+  {
+    m_atlasRegions[tileId] = tileAtlas.getRegion(m_tileIDStrings[tileId]);
+    m_shoreAtlasRegions[tileId] = tileAtlas.getRegion(m_tileIDStrings[tileId] + "_shore");
+  }
+
+  // the table is scaled for the camera's zoom level by the map
+  m_spriteGeometry.clear();
+  m_spriteGeometryIds.assign(m_tileIDStrings.size() * tileMapCount, SpriteGeometryTable::NO_GEOMETRY);
+  for (size_t tileId = 1; tileId < m_tileIDStrings.size(); ++tileId)
+  {
+    const TileData *tileData = m_tileDataByTileId[tileId];
+    if (tileData)
+    {
+      addSpriteGeometry(static_cast<TileId>(tileId), TileMap::DEFAULT, m_textures[tileId], tileData->tiles);
+      addSpriteGeometry(static_cast<TileId>(tileId), TileMap::SLOPES, m_textures[tileId], tileData->slopeTiles);
+      addSpriteGeometry(static_cast<TileId>(tileId), TileMap::SHORE, m_shoreTextures[tileId], tileData->shoreTiles);
+    }
+  }
+}
+
+void TileManager::addSpriteGeometry(TileId tileId, TileMap tileMap, SDL_Texture *texture, const TileSetData &tileSet)
+{
+  if (!texture || tileSet.fileName.empty() || tileSet.clippingWidth <= 0 || tileSet.clippingHeight <= 0)
+  {
+    return;
+  }
+
+  int sheetHeight = 0;
+  SDL_QueryTexture(texture, nullptr, nullptr, nullptr, &sheetHeight);
+  m_spriteGeometryIds[tileId * tileMapCount + tileMap] =
+      m_spriteGeometry.add(tileSet.clippingWidth, tileSet.clippingHeight, sheetHeight);
+}
+
+void TileManager::addFootprintCoverage(TileId tileId)
+{
+  const TileData *tileData = m_tileDataByTileId[tileId];
+  if (m_tileLayers[tileId] != Layer::BUILDINGS || !tileData || tileData->tiles.fileName.empty() ||
+      tileData->tiles.clippingWidth <= 0)
+  {
+    return;
+  }
+
+  SDL_Surface *surface = ResourcesManager::instance().getTileSurface(m_tileIDStrings[tileId]);
+  if (!surface)
+  {
+    return;
+  }
+
+  // only fully opaque pixels hide what's below them
+  const HitMask opaqueMask(surface, SDL_ALPHA_OPAQUE);
+  const int clippingWidth = tileData->tiles.clippingWidth;
+  const int clippingHeight = tileData->tiles.clippingHeight;
+  std::vector<FootprintOcclusion::Coverage> frames(static_cast<size_t>(surface->w / clippingWidth));
+  bool coversAnyNode = false;
+
+  for (size_t frame = 0; frame < frames.size(); ++frame)
+  {
+    // frames are aligned at the bottom of the spritesheet
+    const SDL_Rect frameRect{static_cast<int>(frame) * clippingWidth, surface->h - clippingHeight, clippingWidth,
+                             clippingHeight};
+    frames[frame] = FootprintOcclusion::computeCoverage(opaqueMask, frameRect, tileData->RequiredTiles.width,
+                                                        tileData->RequiredTiles.height);
+    coversAnyNode = coversAnyNode || frames[frame].any();
+  }
+
+  if (coversAnyNode)
+  {
+    m_footprintCoverage[tileId] = std::move(frames);
+  }
+}
+
+const FootprintOcclusion::Coverage *TileManager::getFootprintCoverage(TileId tileId, int clipX) const
+{
+  const std::vector<FootprintOcclusion::Coverage> &frames = m_footprintCoverage[tileId];
+  const TileData *tileData = m_tileDataByTileId[tileId];
+  if (frames.empty() || !tileData || clipX < 0)
+  {
+    return nullptr;
+  }
+
+  const size_t frame = static_cast<size_t>(clipX / tileData->tiles.clippingWidth);
+  return (frame < frames.size() && frames[frame].any()) ? &frames[frame] : nullptr;
+}
+
+void TileManager::registerTileId(const std::string &id)
+{
+  if (id.empty())
+  { // entries without an id can never be placed, they keep the empty handle
+    return;
+  }
+
+  if (m_tileIDStrings.size() > std::numeric_limits<TileId>::max())
+    throw ConfigurationError(TRACE_INFO "Too many tileIDs in TileData.json, the maximum is " +
+                             std::to_string(std::numeric_limits<TileId>::max()));
+
+  TileData &tileData = m_tileData[id];
+  // tileIDs that are defined twice keep their handle, but take over the new data
+  auto [it, inserted] = m_tileIds.emplace(id, static_cast<TileId>(m_tileIDStrings.size()));
+  const TileId tileId = it->second;
+
+  if (inserted)
+  {
+    m_tileIDStrings.push_back(id);
+    m_tileDataByTileId.push_back(nullptr);
+    m_tileLayers.push_back(Layer::TERRAIN);
+    m_autoTiles.push_back(false);
+    m_textures.push_back(nullptr);
+    m_shoreTextures.push_back(nullptr);
+    m_hitMasks.push_back(nullptr);
+    m_shoreHitMasks.push_back(nullptr);
+    m_overviewColors.push_back(SDL_Color{0, 0, 0, SDL_ALPHA_TRANSPARENT});
+  }
+
+  m_tileDataByTileId[tileId] = &tileData;
+
+  switch (tileData.tileType)
+  {
+  case TileType::TERRAIN:
+    m_tileLayers[tileId] = Layer::TERRAIN;
+    break;
+  case TileType::BLUEPRINT:
+    m_tileLayers[tileId] = Layer::BLUEPRINT;
+    break;
+  case TileType::WATER:
+    m_tileLayers[tileId] = Layer::WATER;
+    break;
+  case TileType::UNDERGROUND:
+    m_tileLayers[tileId] = Layer::UNDERGROUND;
+    break;
+  case TileType::GROUNDDECORATION:
+    m_tileLayers[tileId] = Layer::GROUND_DECORATION;
+    break;
+  case TileType::ZONE:
+    m_tileLayers[tileId] = Layer::ZONE;
+    break;
+  case TileType::ROAD:
+    m_tileLayers[tileId] = Layer::ROAD;
+    break;
+  default:
+    m_tileLayers[tileId] = Layer::BUILDINGS;
+    break;
+  }
+
+  switch (tileData.tileType)
+  {
+  case +TileType::ROAD:
+  case +TileType::AUTOTILE:
+  case +TileType::UNDERGROUND:
+  case +TileType::POWERLINE:
+    m_autoTiles[tileId] = true;
+    break;
+  default:
+    m_autoTiles[tileId] = false;
+    break;
+  }
+
+  // slope tiles share the texture id of the default tiles, so the textures are looked up after everything is loaded
+  if (!tileData.tiles.fileName.empty() || !tileData.slopeTiles.fileName.empty())
+  {
+    m_textures[tileId] = ResourcesManager::instance().getTileTexture(id);
+    m_hitMasks[tileId] = &ResourcesManager::instance().getTileHitMask(id);
+    m_overviewColors[tileId] = ResourcesManager::instance().getTileColor(id);
+  }
+  if (!tileData.shoreTiles.fileName.empty())
+  {
+    m_shoreTextures[tileId] = ResourcesManager::instance().getTileTexture(id + "_shore");
+    m_shoreHitMasks[tileId] = &ResourcesManager::instance().getTileHitMask(id + "_shore");
+  }
 }
 
 void TileManager::addJSONObjectToTileData(const nlohmann::json &tileDataJSON, size_t idx, const std::string &id)
@@ -465,6 +639,13 @@ void TileManager::addJSONObjectToTileData(const nlohmann::json &tileDataJSON, si
   {
     m_tileData[id].RequiredTiles.width = tileDataJSON[idx]["RequiredTiles"].value("width", 1);
     m_tileData[id].RequiredTiles.height = tileDataJSON[idx]["RequiredTiles"].value("height", 1);
+
+    if (m_tileData[id].RequiredTiles.width < 1 || m_tileData[id].RequiredTiles.width > MAX_TILE_FOOTPRINT ||
+        m_tileData[id].RequiredTiles.height < 1 || m_tileData[id].RequiredTiles.height > MAX_TILE_FOOTPRINT)
+    {
+      throw ConfigurationError(TRACE_INFO "In TileData.json in field with ID " + id +
+                               " the RequiredTiles must be between 1 and " + std::to_string(MAX_TILE_FOOTPRINT) + " nodes");
+    }
   }
   else
   {
@@ -537,20 +718,4 @@ void TileManager::addJSONObjectToTileData(const nlohmann::json &tileDataJSON, si
   }
 }
 
-bool TileManager::isTileIDAutoTile(const std::string &tileID)
-{
-  TileData *tileData = getTileData(tileID);
-  if (tileData)
-    switch (tileData->tileType)
-    {
-    case +TileType::ROAD:
-    case +TileType::AUTOTILE:
-    case +TileType::UNDERGROUND:
-    case +TileType::POWERLINE:
-      return true;
-    default:
-      return false;
-    }
-
-  return false;
-}
+bool TileManager::isTileIDAutoTile(const std::string &tileID) { return isTileIDAutoTile(getTileId(tileID)); }
@@ -5,13 +5,33 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <vector>
 #include <optional> // required  for windows
 
 #include "tileData.hxx"
 #include "json.hxx"
 #include "Singleton.hxx"
+#include "FixedVector.hxx"
 #include "../common/enums.hxx"
 #include "basics/point.hxx"
+#include "render/FootprintOcclusion.hxx"
+#include "render/HitMask.hxx"
+#include "render/SpriteGeometry.hxx"
+#include "render/TextureAtlas.hxx"
+
+/// Compact handle of a tileID. Handles are assigned by the TileManager when the tile data is loaded.
+using TileId = uint16_t;
+
+/// Handle for an empty layer or an unknown tileID
+constexpr TileId EMPTY_TILE_ID = 0;
+
+/// Maximum width and height of a tile in nodes (RequiredTiles)
+constexpr unsigned int MAX_TILE_FOOTPRINT = 16;
+static_assert(MAX_TILE_FOOTPRINT == FootprintOcclusion::maxFootprintSize,
+              "the footprint occlusion must be able to store every node of a footprint");
+
+/// Nodes that are occupied by a tile, stored without allocating
+using TileFootprint = FixedVector<Point, MAX_TILE_FOOTPRINT * MAX_TILE_FOOTPRINT>;
 
 enum TileMap : size_t
 {
@@ -81,18 +101,111 @@ public:
    */
   SDL_Texture *getTexture(const std::string &tileID) const;
 
+  /** @brief Get the Texture for a tile handle
+   * @param tileId - handle of the tileID
+   * @param tileMap - get the texture for default, slope or shore tiles
+   * @return An SDL Texture we can render or nullptr if there is none
+   */
+  SDL_Texture *getTexture(TileId tileId, TileMap tileMap = TileMap::DEFAULT) const
+  {
+    return (tileMap == TileMap::SHORE) ? m_shoreTextures[tileId] : m_textures[tileId];
+  };
+
+  /** @brief Get the mask of the non-transparent pixels of a tile's spritesheet
+   * @param tileId - handle of the tileID
+   * @param tileMap - get the mask for default, slope or shore tiles
+   * @return The hit mask or nullptr if the tile has no spritesheet
+   */
+  const HitMask *getHitMask(TileId tileId, TileMap tileMap = TileMap::DEFAULT) const
+  {
+    return (tileMap == TileMap::SHORE) ? m_shoreHitMasks[tileId] : m_hitMasks[tileId];
+  };
+
+  /** @brief Get the color a tile is shown with in the map overview
+   * @param tileId - handle of the tileID
+   * @return The average color of the tile's spritesheet, transparent if the tile has no spritesheet
+   */
+  SDL_Color getOverviewColor(TileId tileId) const { return m_overviewColors[tileId]; };
+
+  /** @brief Get the region of the tile's spritesheet within the tile texture atlas
+   * @param tileId - handle of the tileID
+   * @param tileMap - get the region for default, slope or shore tiles
+   * @return The atlas region, which is invalid if the spritesheet is not part of the atlas
+   */
+  const AtlasRegion &getAtlasRegion(TileId tileId, TileMap tileMap = TileMap::DEFAULT) const
+  {
+    return (tileMap == TileMap::SHORE) ? m_shoreAtlasRegions[tileId] : m_atlasRegions[tileId];
+  };
+
+  /** @brief Get the geometry of a tile's spritesheet
+   * @param tileId - handle of the tileID
+   * @param tileMap - get the geometry for default, slope or shore tiles
+   * @return The id in the sprite geometry table or SpriteGeometryTable::NO_GEOMETRY if the tile has no such spritesheet
+   */
+  SpriteGeometryTable::GeometryId getSpriteGeometryId(TileId tileId, TileMap tileMap = TileMap::DEFAULT) const
+  {
+    return m_spriteGeometryIds[tileId * tileMapCount + tileMap];
+  };
+
+  /** @brief Get the footprint nodes a frame of a building covers completely
+   * The lower layers of covered nodes don't need to be drawn while the building is drawn opaque.
+   * @param tileId - handle of the tileID
+   * @param clipX - x coordinate of the frame in the spritesheet
+   * @return The covered nodes or nullptr if the frame doesn't cover any node
+   */
+  const FootprintOcclusion::Coverage *getFootprintCoverage(TileId tileId, int clipX) const;
+
+  /// Get the geometry of all tile spritesheets at the current zoom level
+  const SpriteGeometryTable &getSpriteGeometry() const { return m_spriteGeometry; };
+
+  /** @brief Scale the geometry of all tile spritesheets for a zoom level
+   * Must not be called while sprites are refreshed.
+   * @param zoomLevel - the zoom level of the camera
+   */
+  void setSpriteZoomLevel(double zoomLevel) { m_spriteGeometry.setZoomLevel(zoomLevel); };
+
+  /** @brief Get the handle of a tileID
+   * Strings should only be used at the JSON and UI boundary, everything else should work with handles.
+   * @param tileID - TileID
+   * @return The handle of the tileID or EMPTY_TILE_ID if the tileID is unknown
+   */
+  TileId getTileId(const std::string &tileID) const;
+
+  /** @brief Get the tileID string for a handle
+   * @param tileId - handle of the tileID
+   * @return The tileID or an empty string for EMPTY_TILE_ID
+   */
+  const std::string &getTileIDString(TileId tileId) const { return m_tileIDStrings[tileId]; };
+
+  /** @brief Get the tileID strings of all handles
+   * @return The tileIDs, indexed by their handle
+   */
+  const std::vector<std::string> &getTileIDStrings() const { return m_tileIDStrings; };
+
   /** @brief Get the TileData struct for this tileID with all informations associated with it
   * @param id - TileID
   * @return A pointer to the TileData Struct
   */
   TileData *getTileData(const std::string &id) noexcept;
 
+  /** @brief Get the TileData struct for a tile handle
+  * @param tileId - handle of the tileID
+  * @return A pointer to the TileData Struct or nullptr for EMPTY_TILE_ID
+  */
+  TileData *getTileData(TileId tileId) const noexcept { return m_tileDataByTileId[tileId]; };
+
   /** @brief Get the Layer that is associated with a tileID. The Tile will be placed on this layer
   * @param tileID the tileID to get the Layer for
   * @return The layer this tileID has to be placed on
   */
   Layer getTileLayer(const std::string &tileID) const;
 
+  /** @brief Get the Layer that is associated with a tile handle.
+  * @param tileId handle of the tileID
+  * @return The layer this tileID has to be placed on
+  */
+  Layer getTileLayer(TileId tileId) const { return m_tileLayers[tileId]; };
+
   /** @brief Calculates the TileOrintation for elevated tiles to pick the correct slope Sprite
   * @param bitMaskElevation a bitmask of neighboring tiles and their elevation
   * @return Elevation bitmask
@@ -112,23 +225,31 @@ public:
   * @param tileSize - Get buildings with a certain tile size
   * @return All tileIDs that match the zone and tileSize
   */
-  std::vector<std::string> getAllTileIDsForZone(ZoneType zone, ZoneDensity zoneDensity, TileSize tileSize = {1, 1});
+  std::vector<TileId> getAllTileIDsForZone(ZoneType zone, ZoneDensity zoneDensity, TileSize tileSize = {1, 1});
 
   /** @brief Pick a single random tileID for a zone with a random tilesize within the supplied max Size
   * @param zone - The Zone we want tileIDs for
   * @param maxTileSize - maximum tileSize we want 
   * @return A random tileID matching the supplied parameters
   */
-  std::optional<std::string> getRandomTileIDForZoneWithRandomSize(ZoneType zone, ZoneDensity zoneDensity,
-                                                                  TileSize maxTileSize = {1, 1});
+  std::optional<TileId> getRandomTileIDForZoneWithRandomSize(ZoneType zone, ZoneDensity zoneDensity,
+                                                             TileSize maxTileSize = {1, 1});
 
   /** @brief Return a vector of Points on a target node (origin corner) that would be occupied 
   * by a given tileID if the placement is valid
   * @param targetCoordinates - the origin node where the tile should be placed
   * @param tileID - the tileID to place
-  * @return vector of points that will be occupied by this tileID, empty if placement is not allowed
+  * @return points that will be occupied by this tileID, empty if placement is not allowed
+  */
+  TileFootprint getTargetCoordsOfTileID(const Point &targetCoordinates, const std::string &tileID);
+
+  /** @brief Return a vector of Points on a target node (origin corner) that would be occupied 
+  * by a given tile handle if the placement is valid
+  * @param targetCoordinates - the origin node where the tile should be placed
+  * @param tileId - handle of the tileID to place
+  * @return points that will be occupied by this tileID, empty if placement is not allowed
   */
-  std::vector<Point> getTargetCoordsOfTileID(const Point &targetCoordinates, const std::string &tileID);
+  TileFootprint getTargetCoordsOfTileID(const Point &targetCoordinates, TileId tileId);
 
   /** @brief check if given TileID can autotile (meaning there 
    * are textures that look differently according to the position of tiles to each other).
@@ -136,6 +257,11 @@ public:
    */
   bool isTileIDAutoTile(const std::string &tileID);
 
+  /** @brief check if given tile handle can autotile
+   * @return bool whether Tile Data item can be autotiled.
+   */
+  bool isTileIDAutoTile(TileId tileId) const { return m_autoTiles[tileId]; };
+
   /** @brief Parse the tileData JSON and set up the tileManager
   * 
   */
@@ -147,7 +273,47 @@ private:
 
   std::unordered_map<std::string, TileData> m_tileData;
   std::unordered_set<TileSize> m_tileSizeCombinations;
+
+  // lookup tables indexed by TileId, index 0 is EMPTY_TILE_ID
+  std::unordered_map<std::string, TileId> m_tileIds;
+  std::vector<std::string> m_tileIDStrings;
+  std::vector<TileData *> m_tileDataByTileId;
+  std::vector<Layer> m_tileLayers;
+  std::vector<bool> m_autoTiles;
+  std::vector<SDL_Texture *> m_textures;
+  std::vector<SDL_Texture *> m_shoreTextures;
+  std::vector<AtlasRegion> m_atlasRegions;
+  std::vector<AtlasRegion> m_shoreAtlasRegions;
+  std::vector<const HitMask *> m_hitMasks;
+  std::vector<const HitMask *> m_shoreHitMasks;
+  std::vector<SDL_Color> m_overviewColors;
+  static constexpr size_t tileMapCount = TileMap::SHORE + 1;
+  /// geometry ids of all tile maps of a tile handle, at tileId * tileMapCount + tileMap
+  std::vector<SpriteGeometryTable::GeometryId> m_spriteGeometryIds;
+  SpriteGeometryTable m_spriteGeometry;
+  /// covered footprint nodes of every frame of a building's spritesheet, empty if no frame covers any node
+  std::vector<std::vector<FootprintOcclusion::Coverage>> m_footprintCoverage;
+
   void addJSONObjectToTileData(const nlohmann::json &tileDataJSON, size_t idx, const std::string &id);
+
+  /** @brief Assign a handle to a tileID that has been added to the tile data
+   * @param id - TileID
+   */
+  void registerTileId(const std::string &id);
+
+  /** @brief Add the geometry of a tile's spritesheet to the sprite geometry table
+   * @param tileId - handle of the tileID
+   * @param tileMap - the tile map the spritesheet is used for
+   * @param texture - the texture of the spritesheet
+   * @param tileSet - the frames of the spritesheet
+   */
+  void addSpriteGeometry(TileId tileId, TileMap tileMap, SDL_Texture *texture, const TileSetData &tileSet);
+
+  /** @brief Find the footprint nodes each frame of a building covers
+   * Must be called before the spritesheets are packed into the atlas, their surfaces are released afterwards.
+   * @param tileId - handle of the tileID
+   */
+  void addFootprintCoverage(TileId tileId);
 };
 
 #endif
@@ -12,6 +12,23 @@ WindowManager::WindowManager()
   Uint32 windowFlags = 0;
   Uint32 rendererFlags = 0;
 
+  if (Settings::instance().headless)
+  {
+    // the software renderer can draw into a surface, so neither a display nor a GPU is needed
+    m_surface = SDL_CreateRGBSurfaceWithFormat(0, Settings::instance().screenWidth, Settings::instance().screenHeight, 32,
+                                               SDL_PIXELFORMAT_RGBA32);
+    if (!m_surface)
+      throw UIError(TRACE_INFO "Failed to create off-screen surface: " + string{SDL_GetError()});
+
+    m_renderer = SDL_CreateSoftwareRenderer(m_surface);
+    if (!m_renderer)
+      throw UIError(TRACE_INFO "Failed to create software renderer: " + string{SDL_GetError()});
+
+    Settings::instance().currentScreenWidth = Settings::instance().screenWidth;
+    Settings::instance().currentScreenHeight = Settings::instance().screenHeight;
+    return;
+  }
+
 #ifdef __ANDROID__
   // Android is always fullscreen.. We also need to set screenWidth / screenHeight to the max. resolution in Fullscreen
   windowFlags = SDL_WINDOW_FULLSCREEN;
@@ -59,7 +76,14 @@ WindowManager::WindowManager()
 WindowManager::~WindowManager()
 {
   SDL_DestroyRenderer(m_renderer);
-  SDL_DestroyWindow(m_window);
+  if (m_window)
+  {
+    SDL_DestroyWindow(m_window);
+  }
+  if (m_surface)
+  {
+    SDL_FreeSurface(m_surface);
+  }
 }
 
 void WindowManager::toggleFullScreen() const
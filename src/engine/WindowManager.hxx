@@ -43,6 +43,12 @@ public:
   */
   SDL_Window *getWindow() const { return m_window; };
 
+  /** \brief check if there's no window
+  * In headless mode the software renderer draws into an off-screen surface, no display is needed.
+  * \return true if the game renders without a window
+  */
+  bool isHeadless() const { return m_window == nullptr; };
+
   std::vector<SDL_DisplayMode *> getSupportedScreenResolutions() { return m_resolutions; };
 
   void setScreenResolution(int mode);
@@ -68,8 +74,9 @@ private:
   std::string m_title = "Cytopia";                                                ///< title of the window
   const std::string m_windowIcon = "resources/images/app_icons/cytopia_icon.png"; ///< the window's icon
 
-  SDL_Window *m_window = nullptr;     ///< pointer to the SDL_Window
+  SDL_Window *m_window = nullptr;     ///< pointer to the SDL_Window, null in headless mode
   SDL_Renderer *m_renderer = nullptr; ///< pointer to the SDL_Renderer
+  SDL_Surface *m_surface = nullptr;   ///< the off-screen surface that is rendered to in headless mode
 
   std::vector<SDL_DisplayMode *> m_resolutions;
 
@@ -3,6 +3,8 @@
 #include "Settings.hxx"
 #include "../Engine.hxx"
 
+#include <algorithm>
+
 void Camera::increaseZoomLevel()
 {
   if (m_ZoomLevel < 4.0)
@@ -27,6 +29,12 @@ void Camera::decreaseZoomLevel()
   }
 }
 
+void Camera::setZoomLevel(double zoomLevel)
+{
+  m_ZoomLevel = std::clamp(zoomLevel, 0.5, 4.0);
+  centerScreenOnPoint(m_CenterIsoCoordinates);
+}
+
 void Camera::setPinchDistance(float pinchDistance, int isoX, int isoY)
 {
   m_PinchDistance += pinchDistance;
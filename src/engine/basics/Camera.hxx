@@ -31,6 +31,12 @@ public:
    */
   void decreaseZoomLevel();
 
+  /**
+   * @brief Sets the zoom level of the camera and keeps the center of the screen
+   * @param zoomLevel the new zoom level, clamped to the zoom levels the camera supports
+   */
+  void setZoomLevel(double zoomLevel);
+
   /**
    * @brief Sets the pinch distance for Android
    * @param pinchDistance the pinch distance
@@ -5,7 +5,6 @@
 static std::vector<Point> getLine;
 static std::vector<Point> getStraightLine;
 static std::vector<Point> getArea;
-static std::vector<Point> getNeighbors;
 
 std::vector<Point> PointFunctions::getLine(Point isoCoordinatesStart, Point isoCoordinatesEnd)
 {
@@ -174,27 +173,24 @@ std::vector<Point> PointFunctions::getArea(const Point &isoCoordinatesStart, con
   return rectangle;
 }
 
-std::vector<Point> PointFunctions::getNeighbors(const Point &isoCoordinates, const bool includeCentralNode, int distance)
+Neighborhood PointFunctions::getNeighbors(const Point &isoCoordinates, const bool includeCentralNode)
 {
-  std::vector<Point> neighbors;
+  Neighborhood neighbors;
 
-  for (int xOffset = -distance; xOffset <= distance; ++xOffset)
+  for (const auto &offset : neighborOffsets)
   {
-    for (int yOffset = -distance; yOffset <= distance; ++yOffset)
+    if (!includeCentralNode && offset.position == NeighbourNodesPosition::CENTER)
     {
-      if (!includeCentralNode && (xOffset == 0) && (yOffset == 0))
-      {
-        continue;
-      }
+      continue;
+    }
 
-      Point neighbor;
-      neighbor.x = isoCoordinates.x + xOffset;
-      neighbor.y = isoCoordinates.y + yOffset;
+    Point neighbor;
+    neighbor.x = isoCoordinates.x + offset.x;
+    neighbor.y = isoCoordinates.y + offset.y;
 
-      if (neighbor.isWithinMapBoundaries())
-      {
-        neighbors.push_back(neighbor);
-      }
+    if (neighbor.isWithinMapBoundaries())
+    {
+      neighbors.push_back(neighbor);
     }
   }
 
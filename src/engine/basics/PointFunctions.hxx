@@ -3,12 +3,36 @@
 
 #include "point.hxx"
 #include "../../util/LOG.hxx"
+#include "../../util/FixedVector.hxx"
 #include "betterEnums.hxx"
+#include <array>
 #include <vector>
 
 BETTER_ENUM(NeighbourNodesPosition, unsigned char, BOTTOM_LEFT = 1U << 6, LEFT = 1U << 2, TOP_LEFT = 1U << 4, BOTTOM = 1U << 1,
             CENTER = 0U, TOP = 1U, BOTTOM_RIGHT = 1U << 7, RIGHT = 1U << 3, TOP_RIGHT = 1U << 5);
 
+/// Offset of a neighbor to the central node and its bit in the neighbor bitmasks
+struct NeighborOffset
+{
+  int x;
+  int y;
+  unsigned char position;
+};
+
+/// Offsets of the 3x3 neighborhood, x is the outer and y the inner loop. The central node is in the middle.
+constexpr std::array<NeighborOffset, 9> neighborOffsets{{{-1, -1, NeighbourNodesPosition::BOTTOM_LEFT},
+                                                         {-1, 0, NeighbourNodesPosition::LEFT},
+                                                         {-1, 1, NeighbourNodesPosition::TOP_LEFT},
+                                                         {0, -1, NeighbourNodesPosition::BOTTOM},
+                                                         {0, 0, NeighbourNodesPosition::CENTER},
+                                                         {0, 1, NeighbourNodesPosition::TOP},
+                                                         {1, -1, NeighbourNodesPosition::BOTTOM_RIGHT},
+                                                         {1, 0, NeighbourNodesPosition::RIGHT},
+                                                         {1, 1, NeighbourNodesPosition::TOP_RIGHT}}};
+
+/// Coordinates of a node and its neighbors, stored without allocating
+using Neighborhood = FixedVector<Point, neighborOffsets.size()>;
+
 class PointFunctions
 {
 public:
@@ -39,9 +63,9 @@ public:
   /** \brief Get all neighboring coordinate from provided map node isocoordinate.
   * @param isoCoordinates iso coordinates.
   * @param includeCentralNode if set to true include the central node in the result.
-  * @return std::vector<Point>() - All neighboring node coordinates.
+  * @return Neighborhood - All neighboring node coordinates within the map, in the order of neighborOffsets.
   */
-  static std::vector<Point> getNeighbors(const Point &isoCoordinates, const bool includeCentralNode, int distance = 1);
+  static Neighborhood getNeighbors(const Point &isoCoordinates, const bool includeCentralNode);
 
   /** \brief Get the position of the neighboring node to the originpoint (center of the neighborgroup).
   * @param neighboringPoint the neighboring point
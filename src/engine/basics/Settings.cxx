@@ -20,6 +20,9 @@ void Settings::readFile()
     throw ConfigurationError(TRACE_INFO "Error parsing JSON File " + string{SETTINGS_FILE_NAME});
 
   SettingsData data = _settingsJSONObject;
+  // the command line options aren't part of the settings file, reloading it keeps them
+  data.headless = headless;
+  data.forceSoftwareRasterizer = forceSoftwareRasterizer;
   *this = data;
 
   // init the actual resolution with the desired resolution
@@ -80,6 +80,36 @@ struct SettingsData
    */
   int fullScreenMode;
 
+  /**
+   * @brief Render the terrain, water and ground decoration of each map chunk into a cached texture
+   * The cached textures are drawn below all other layers, so buildings behind high terrain are no longer hidden by it.
+   */
+  bool cacheStaticTerrain;
+
+  /**
+   * @brief Below this zoom level the map is drawn from a low detail overview image instead of the sprites
+   * 0 disables the overview.
+   */
+  float overviewZoomLevel;
+
+  /**
+   * @brief Number of frames per second the game loop aims for
+   * 0 starts each frame as soon as the last one is done, with VSYNC the display then sets the pace.
+   */
+  int targetFPS;
+
+  /**
+   * @brief Interval between autosaves in seconds, 0 disables autosaving
+   * Autosaves only append the changes since the last one to a journal, so they can run often.
+   */
+  int autosaveInterval;
+
+  /**
+   * @brief Draw the map with the SoftwareRasterizer instead of the renderer
+   * Meant for machines without a GPU, where SDL's software renderer is slow. The static terrain isn't cached then.
+   */
+  bool softwareRasterizer;
+
   /**
    * @brief The volume of music as flot between [0, 1]
    */
@@ -118,6 +148,11 @@ struct SettingsData
    */
   std::string buildMenuPosition;
 
+  /**
+   * @brief Show a minimap of the active terrain, zone and road layers in the top right corner of the screen
+   */
+  bool showMinimap;
+
   /**
    * @brief this is used for biomedata
    * @todo Remove this later when terraingen is using biomes
@@ -185,6 +220,21 @@ struct SettingsData
    * 
    */
   bool writeErrorLogFile;
+
+  /**
+   * @brief Render into an off-screen surface with the software renderer instead of a window
+   * Set by the --headless command line option, it isn't saved to the settings file.
+   */
+  bool headless = false;
+
+  /**
+   * @brief Draw the map with the SoftwareRasterizer, whatever the softwareRasterizer setting is
+   * Set by the --software-rasterizer command line option, it isn't saved to the settings file.
+   */
+  bool forceSoftwareRasterizer = false;
+
+  /// Whether the map is drawn with the SoftwareRasterizer, by the setting or the command line option
+  bool useSoftwareRasterizer() const { return softwareRasterizer || forceSoftwareRasterizer; }
 };
 
 /**
@@ -0,0 +1,134 @@
+#include "ZlibStream.hxx"
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+namespace
+{
+/// size of the buffers on both sides of zlib
+constexpr size_t bufferSize = 65536;
+
+[[noreturn]] void throwZlibError(const z_stream &zstream, const std::string &action)
+{
+  if (zstream.msg)
+    throw CompressionError(TRACE_INFO "Zlib failed to " + action + ": " + string{zstream.msg});
+  throw CompressionError(TRACE_INFO "Zlib failed to " + action);
+}
+} // namespace
+
+DeflateStreamBuf::DeflateStreamBuf(std::ostream &sink, int level)
+    : m_sink(sink), m_input(bufferSize), m_output(bufferSize)
+{
+  if (deflateInit(&m_zstream, level) != Z_OK)
+  {
+    throwZlibError(m_zstream, "initialize the stream");
+  }
+  setp(m_input.data(), m_input.data() + m_input.size());
+}
+
+DeflateStreamBuf::~DeflateStreamBuf() { deflateEnd(&m_zstream); }
+
+void DeflateStreamBuf::finish()
+{
+  if (!m_isFinished)
+  {
+    deflateBuffer(Z_FINISH);
+    m_isFinished = true;
+  }
+}
+
+DeflateStreamBuf::int_type DeflateStreamBuf::overflow(int_type character)
+{
+  if (m_isFinished)
+  {
+    return traits_type::eof();
+  }
+
+  deflateBuffer(Z_NO_FLUSH);
+  if (!traits_type::eq_int_type(character, traits_type::eof()))
+  {
+    *pptr() = traits_type::to_char_type(character);
+    pbump(1);
+  }
+  return traits_type::not_eof(character);
+}
+
+int DeflateStreamBuf::sync()
+{
+  // flushing zlib would make the output worse, pending data is compressed by the next overflow or finish()
+  return 0;
+}
+
+void DeflateStreamBuf::deflateBuffer(int flush)
+{
+  m_zstream.next_in = reinterpret_cast<Bytef *>(pbase());
+  m_zstream.avail_in = static_cast<uInt>(pptr() - pbase());
+
+  int deflateResult = Z_OK;
+  do
+  {
+    m_zstream.next_out = reinterpret_cast<Bytef *>(m_output.data());
+    m_zstream.avail_out = static_cast<uInt>(m_output.size());
+
+    deflateResult = deflate(&m_zstream, flush);
+    if (deflateResult == Z_STREAM_ERROR)
+    {
+      throwZlibError(m_zstream, "compress the data");
+    }
+
+    const size_t compressedSize = m_output.size() - m_zstream.avail_out;
+    if (!m_sink.write(m_output.data(), static_cast<std::streamsize>(compressedSize)))
+    {
+      throw CompressionError(TRACE_INFO "Could not write compressed data");
+    }
+  } while (m_zstream.avail_out == 0 || (flush == Z_FINISH && deflateResult != Z_STREAM_END));
+
+  setp(m_input.data(), m_input.data() + m_input.size());
+}
+
+InflateStreamBuf::InflateStreamBuf(std::istream &source)
+    : m_source(source), m_input(bufferSize), m_output(bufferSize)
+{
+  if (inflateInit(&m_zstream) != Z_OK)
+  {
+    throwZlibError(m_zstream, "initialize the stream");
+  }
+  setg(m_output.data(), m_output.data(), m_output.data());
+}
+
+InflateStreamBuf::~InflateStreamBuf() { inflateEnd(&m_zstream); }
+
+InflateStreamBuf::int_type InflateStreamBuf::underflow()
+{
+  m_zstream.next_out = reinterpret_cast<Bytef *>(m_output.data());
+  m_zstream.avail_out = static_cast<uInt>(m_output.size());
+
+  // inflate may consume input without producing output, so keep going until there is some
+  while (!m_isFinished && m_zstream.avail_out == m_output.size())
+  {
+    if (m_zstream.avail_in == 0)
+    {
+      m_source.read(m_input.data(), static_cast<std::streamsize>(m_input.size()));
+      m_zstream.next_in = reinterpret_cast<Bytef *>(m_input.data());
+      m_zstream.avail_in = static_cast<uInt>(m_source.gcount());
+      if (m_zstream.avail_in == 0)
+      {
+        throw CompressionError(TRACE_INFO "Error while decompressing file: the data is truncated");
+      }
+    }
+
+    const int inflateResult = inflate(&m_zstream, Z_NO_FLUSH);
+    if (inflateResult == Z_STREAM_END)
+    {
+      m_isFinished = true;
+    }
+    else if (inflateResult != Z_OK)
+    {
+      throwZlibError(m_zstream, "decompress the data");
+    }
+  }
+
+  const size_t decompressedSize = m_output.size() - m_zstream.avail_out;
+  setg(m_output.data(), m_output.data(), m_output.data() + decompressedSize);
+  return decompressedSize > 0 ? traits_type::to_int_type(m_output.front()) : traits_type::eof();
+}
@@ -0,0 +1,78 @@
+#ifndef ZLIBSTREAM_HXX_
+#define ZLIBSTREAM_HXX_
+
+#include <zlib.h>
+
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+/** @brief Compresses everything written to it into another stream
+ * Data is compressed in blocks as it's written, so only the buffers of zlib are held in memory.
+ * Wrap it in a std::ostream to write to it and call finish() when done.
+ */
+class DeflateStreamBuf : public std::streambuf
+{
+public:
+  /**
+   * @param sink the stream the compressed data is written to
+   * @param level the zlib compression level
+   * @throws CompressionError if zlib can't be initialized
+   */
+  explicit DeflateStreamBuf(std::ostream &sink, int level = Z_DEFAULT_COMPRESSION);
+  ~DeflateStreamBuf() override;
+
+  DeflateStreamBuf(const DeflateStreamBuf &) = delete;
+  DeflateStreamBuf &operator=(const DeflateStreamBuf &) = delete;
+
+  /** @brief Compress the remaining data and end the zlib stream
+   * @throws CompressionError if the data can't be compressed or written
+   */
+  void finish();
+
+protected:
+  int_type overflow(int_type character) override;
+  int sync() override;
+
+private:
+  /// Compress the put area and write the output to the sink
+  void deflateBuffer(int flush);
+
+  std::ostream &m_sink;
+  z_stream m_zstream{};
+  std::vector<char> m_input;
+  std::vector<char> m_output;
+  bool m_isFinished = false;
+};
+
+/** @brief Decompresses a zlib stream while it's read
+ * Data is read from the source and decompressed in blocks, so only the buffers of zlib are held in memory.
+ * Wrap it in a std::istream to read from it. Anything after the end of the zlib stream is ignored.
+ */
+class InflateStreamBuf : public std::streambuf
+{
+public:
+  /**
+   * @param source the stream the compressed data is read from
+   * @throws CompressionError if zlib can't be initialized
+   */
+  explicit InflateStreamBuf(std::istream &source);
+  ~InflateStreamBuf() override;
+
+  InflateStreamBuf(const InflateStreamBuf &) = delete;
+  InflateStreamBuf &operator=(const InflateStreamBuf &) = delete;
+
+protected:
+  /// @throws CompressionError if the compressed data is damaged or truncated
+  int_type underflow() override;
+
+private:
+  std::istream &m_source;
+  z_stream m_zstream{};
+  std::vector<char> m_input;
+  std::vector<char> m_output;
+  bool m_isFinished = false;
+};
+
+#endif
@@ -26,7 +26,8 @@ inline void from_json(const json &j, Point &point)
 // JSON deserializer for Point class
 inline void from_json(const json &j, MapNodeData &mapNodeData)
 {
-  mapNodeData.tileID = j.at("tileID").get<std::string>();
+  // savegames store the tileID strings, the handles are only valid for the currently loaded tile data
+  mapNodeData.tileId = TileManager::instance().getTileId(j.at("tileID").get<std::string>());
   mapNodeData.tileIndex = j.at("tileIndex").get<std::int32_t>();
   mapNodeData.origCornerPoint = j.at("origCornerPoint").get<Point>();
 }
@@ -39,11 +40,16 @@ inline void from_json(const json &j, SettingsData &s)
   s.vSync = j["Graphics"].value("VSYNC", false);
   s.fullScreen = j["Graphics"].value("FullScreen", false);
   s.fullScreenMode = j["Graphics"].value("FullScreenMode", 0);
+  s.cacheStaticTerrain = j["Graphics"].value("CacheStaticTerrain", false);
+  s.overviewZoomLevel = j["Graphics"].value("OverviewZoomLevel", 0.0f);
+  s.targetFPS = j["Graphics"].value("TargetFPS", 0);
+  s.softwareRasterizer = j["Graphics"].value("SoftwareRasterizer", false);
   s.mapSize = j["Game"].value("MapSize", 64);
   s.biome = j["Game"].value("Biome", "GrassLands");
   s.maxElevationHeight = j["Game"].value("MaxElevationHeight", 32);
   s.showBuildingsInBlueprint = j["Game"].value("ShowBuildingsInBlueprint", false);
   s.zoneLayerTransparency = j["Game"].value("ZoneLayerTransparency", 0.5f);
+  s.autosaveInterval = j["Game"].value("AutosaveInterval", 60);
   s.uiDataJSONFile = j["ConfigFiles"].value("UIDataJSONFile", "resources/data/TileData.json");
   s.tileDataJSONFile = j["ConfigFiles"].value("TileDataJSONFile", "resources/data/UIData.json");
   s.uiLayoutJSONFile = j["ConfigFiles"].value("UILayoutJSONFile", "resources/data/UILayout.json");
@@ -59,6 +65,7 @@ inline void from_json(const json &j, SettingsData &s)
   s.fontFileName = j["User Interface"].value("FontFilename", "resources/fonts/arcadeclassics.ttf");
   s.subMenuButtonWidth = j["User Interface"].value("SubMenuButtonWidth", 32);
   s.subMenuButtonHeight = j["User Interface"].value("SubMenuButtonHeight", 32);
+  s.showMinimap = j["User Interface"].value("ShowMinimap", false);
   s.writeErrorLogFile = j["Debug"].value("WriteErrorLogToFile", false);
 }
 
@@ -214,8 +221,9 @@ inline void to_json(json &j, const Point &point)
 // JSON serializer for MapNodeData struct
 inline void to_json(json &j, const MapNodeData &mapNodeData)
 {
-  j = json{
-      {"tileID", mapNodeData.tileID}, {"tileIndex", mapNodeData.tileIndex}, {"origCornerPoint", mapNodeData.origCornerPoint}};
+  j = json{{"tileID", TileManager::instance().getTileIDString(mapNodeData.tileId)},
+           {"tileIndex", mapNodeData.tileIndex},
+           {"origCornerPoint", mapNodeData.origCornerPoint}};
 }
 
 // JSON serializer for MapNode class
@@ -233,6 +241,10 @@ inline void to_json(json &j, const SettingsData &s)
            {std::string("VSYNC"), s.vSync},
            {std::string("FullScreen"), s.fullScreen},
            {std::string("FullScreenMode"), s.fullScreenMode},
+           {std::string("CacheStaticTerrain"), s.cacheStaticTerrain},
+           {std::string("OverviewZoomLevel"), s.overviewZoomLevel},
+           {std::string("TargetFPS"), s.targetFPS},
+           {std::string("SoftwareRasterizer"), s.softwareRasterizer},
            {std::string("Resolution"),
             {{std::string("Screen_Width"), s.screenWidth}, {std::string("Screen_Height"), s.screenHeight}}},
        }},
@@ -241,12 +253,14 @@ inline void to_json(json &j, const SettingsData &s)
         {std::string("Biome"), s.biome},
         {std::string("MaxElevationHeight"), s.maxElevationHeight},
         {std::string("ZoneLayerTransparency"), s.zoneLayerTransparency},
+        {std::string("AutosaveInterval"), s.autosaveInterval},
         {std::string("ShowBuildingsInBlueprint"), s.showBuildingsInBlueprint}}},
       {std::string("User Interface"),
        {{std::string("BuildMenuPosition"), s.buildMenuPosition},
         {std::string("FontFilename"), s.fontFileName.get()},
         {std::string("SubMenuButtonWidth"), s.subMenuButtonWidth},
         {std::string("SubMenuButtonHeight"), s.subMenuButtonHeight},
+        {std::string("ShowMinimap"), s.showMinimap},
         {std::string("Language"), s.gameLanguage}}},
       {std::string("ConfigFiles"),
        {{std::string("UIDataJSONFile"), s.uiDataJSONFile.get()},
@@ -0,0 +1,272 @@
+#include "BinarySaveGame.hxx"
+
+#include <zlib.h>
+
+#include <algorithm>
+
+#include "SaveGameIO.hxx"
+
+namespace BinarySaveGame
+{
+
+using namespace SaveGameIO;
+
+namespace
+{
+constexpr char magic[] = {'C', 'Y', 'T', 'O', 'S', 'A', 'V', 'E'};
+
+/// size of a node in the columns of a chunk
+constexpr size_t bytesPerNode = sizeof(uint8_t) + LAYERS_COUNT * (sizeof(uint16_t) + sizeof(uint16_t) + sizeof(int32_t));
+
+/// size of the header in front of the compressed columns of a chunk
+constexpr size_t chunkHeaderSize = 4 * sizeof(uint32_t);
+
+ChunkLocation readChunkHeader(const Header &header, const char *data, size_t chunkNumber)
+{
+  BufferReader chunkHeader(data, chunkHeaderSize);
+  ChunkLocation location;
+  location.firstNode = chunkHeader.read<uint32_t>();
+  location.nodeCount = chunkHeader.read<uint32_t>();
+  location.compressedSize = chunkHeader.read<uint32_t>();
+  location.checksum = chunkHeader.read<uint32_t>();
+
+  const uint64_t nodeCountTotal = static_cast<uint64_t>(header.columns) * header.rows;
+  if (location.firstNode > nodeCountTotal || location.nodeCount > nodeCountTotal - location.firstNode ||
+      location.compressedSize > compressBound(static_cast<uLong>(location.nodeCount * bytesPerNode)))
+  {
+    throw ConfigurationError(TRACE_INFO "Binary savegame chunk " + std::to_string(chunkNumber) + " is damaged");
+  }
+  return location;
+}
+
+/// Check the compressed columns of a chunk against its checksum
+void checkChunkData(const ChunkLocation &location, const unsigned char *compressed, size_t chunkNumber)
+{
+  if (crc32(0L, compressed, static_cast<uInt>(location.compressedSize)) != location.checksum)
+  {
+    throw ConfigurationError(TRACE_INFO "Checksum mismatch in binary savegame chunk " + std::to_string(chunkNumber));
+  }
+}
+
+/** @brief Check and decompress the columns of a chunk
+ * @param payload buffer for the decompressed columns, it's reused by the caller
+ */
+void decodeChunk(const ChunkLocation &location, const unsigned char *compressed, size_t chunkNumber,
+                 std::string &payload, Chunk &chunk)
+{
+  checkChunkData(location, compressed, chunkNumber);
+
+  uLongf payloadSize = static_cast<uLongf>(location.nodeCount * bytesPerNode);
+  payload.resize(payloadSize);
+  if (uncompress(reinterpret_cast<Bytef *>(&payload[0]), &payloadSize, compressed, location.compressedSize) != Z_OK ||
+      payloadSize != location.nodeCount * bytesPerNode)
+  {
+    throw ConfigurationError(TRACE_INFO "Could not decompress binary savegame chunk " + std::to_string(chunkNumber));
+  }
+
+  chunk.firstNode = static_cast<int>(location.firstNode);
+  chunk.resize(static_cast<int>(location.nodeCount));
+  BufferReader columns(payload.data(), payload.size());
+  columns.readColumn(chunk.heights);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    columns.readColumn(chunk.tileRefs[layer]);
+    columns.readColumn(chunk.tileIndices[layer]);
+    columns.readColumn(chunk.origCornerIndices[layer]);
+  }
+}
+
+/// A streambuf that reads from memory without copying it
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+  MemoryStreamBuf(const char *data, size_t size)
+  {
+    char *begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+  }
+
+  /// Number of bytes that have been read
+  size_t position() const { return static_cast<size_t>(gptr() - eback()); }
+};
+} // namespace
+
+void Chunk::resize(int count)
+{
+  nodeCount = count;
+  heights.resize(count);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    tileRefs[layer].resize(count);
+    tileIndices[layer].resize(count);
+    origCornerIndices[layer].resize(count);
+  }
+}
+
+bool isBinarySaveGame(std::istream &stream)
+{
+  const std::istream::pos_type position = stream.tellg();
+  char fileMagic[sizeof(magic)] = {};
+  const bool isBinary = stream.read(fileMagic, sizeof(fileMagic)) && std::equal(fileMagic, fileMagic + sizeof(magic), magic);
+
+  stream.clear();
+  stream.seekg(position);
+  return isBinary;
+}
+
+Writer::Writer(std::ostream &stream, const Header &header, const std::vector<std::string> &tileIDs) : m_stream(stream)
+{
+  std::string buffer(magic, sizeof(magic));
+  appendValue(buffer, formatVersion);
+  appendValue(buffer, header.saveGameVersion);
+  appendValue(buffer, header.columns);
+  appendValue(buffer, header.rows);
+  appendValue(buffer, static_cast<uint32_t>(LAYERS_COUNT));
+  appendValue(buffer, header.chunkCount);
+  appendValue(buffer, static_cast<uint32_t>(tileIDs.size()));
+  for (const std::string &tileID : tileIDs)
+  {
+    const auto length = static_cast<uint16_t>(std::min<size_t>(tileID.size(), UINT16_MAX));
+    appendValue(buffer, length);
+    buffer.append(tileID, 0, length);
+  }
+
+  if (!m_stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size())))
+  {
+    throw CompressionError(TRACE_INFO "Could not write savegame header");
+  }
+}
+
+void Writer::writeChunk(const Chunk &chunk)
+{
+  m_payload.clear();
+  m_payload.reserve(chunk.nodeCount * bytesPerNode);
+  appendColumn(m_payload, chunk.heights);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    appendColumn(m_payload, chunk.tileRefs[layer]);
+    appendColumn(m_payload, chunk.tileIndices[layer]);
+    appendColumn(m_payload, chunk.origCornerIndices[layer]);
+  }
+
+  uLongf compressedSize = compressBound(static_cast<uLong>(m_payload.size()));
+  m_compressed.resize(compressedSize);
+  if (compress2(m_compressed.data(), &compressedSize, reinterpret_cast<const Bytef *>(m_payload.data()),
+                static_cast<uLong>(m_payload.size()), Z_DEFAULT_COMPRESSION) != Z_OK)
+  {
+    throw CompressionError(TRACE_INFO "Could not compress savegame chunk");
+  }
+
+  std::string chunkHeader;
+  appendValue(chunkHeader, static_cast<uint32_t>(chunk.firstNode));
+  appendValue(chunkHeader, static_cast<uint32_t>(chunk.nodeCount));
+  appendValue(chunkHeader, static_cast<uint32_t>(compressedSize));
+  appendValue(chunkHeader, static_cast<uint32_t>(crc32(0L, m_compressed.data(), static_cast<uInt>(compressedSize))));
+
+  if (!m_stream.write(chunkHeader.data(), static_cast<std::streamsize>(chunkHeader.size())) ||
+      !m_stream.write(reinterpret_cast<const char *>(m_compressed.data()), static_cast<std::streamsize>(compressedSize)))
+  {
+    throw CompressionError(TRACE_INFO "Could not write savegame chunk");
+  }
+}
+
+Reader::Reader(std::istream &stream) : m_stream(stream)
+{
+  constexpr size_t headerSize = sizeof(magic) + 7 * sizeof(uint32_t);
+  readBytes(m_stream, m_payload, headerSize);
+  if (!std::equal(magic, magic + sizeof(magic), m_payload.begin()))
+  {
+    throw ConfigurationError(TRACE_INFO "Not a binary savegame");
+  }
+
+  BufferReader header(m_payload.data() + sizeof(magic), headerSize - sizeof(magic));
+  const auto fileFormatVersion = header.read<uint32_t>();
+  if (fileFormatVersion != formatVersion)
+  {
+    throw ConfigurationError(TRACE_INFO "Binary savegame format version " + std::to_string(fileFormatVersion) +
+                             " is not supported");
+  }
+  m_header.saveGameVersion = header.read<uint32_t>();
+  m_header.columns = header.read<int32_t>();
+  m_header.rows = header.read<int32_t>();
+  const auto layerCount = header.read<uint32_t>();
+  m_header.chunkCount = header.read<uint32_t>();
+  const auto tileIDCount = header.read<uint32_t>();
+
+  if (layerCount != LAYERS_COUNT || m_header.columns <= 0 || m_header.rows <= 0 || tileIDCount > UINT16_MAX + 1U)
+  {
+    throw ConfigurationError(TRACE_INFO "Binary savegame header is damaged");
+  }
+
+  m_tileIDs.resize(tileIDCount);
+  std::string length;
+  for (std::string &tileID : m_tileIDs)
+  {
+    readBytes(m_stream, length, sizeof(uint16_t));
+    readBytes(m_stream, tileID, BufferReader(length.data(), length.size()).read<uint16_t>());
+  }
+}
+
+bool Reader::readChunk(Chunk &chunk)
+{
+  if (m_chunksRead == m_header.chunkCount)
+  {
+    return false;
+  }
+
+  readBytes(m_stream, m_payload, chunkHeaderSize);
+  const ChunkLocation location = readChunkHeader(m_header, m_payload.data(), m_chunksRead);
+  readBytes(m_stream, m_compressed, location.compressedSize);
+  decodeChunk(location, m_compressed.data(), m_chunksRead, m_payload, chunk);
+
+  ++m_chunksRead;
+  return true;
+}
+
+MemoryReader::MemoryReader(const char *data, size_t size) : m_data(data)
+{
+  MemoryStreamBuf streamBuffer(data, size);
+  std::istream stream(&streamBuffer);
+  Reader reader(stream);
+  m_header = reader.getHeader();
+  m_tileIDs = reader.getTileIDs();
+
+  // the chunks are located by hopping from one chunk header to the next, their data isn't touched
+  size_t offset = streamBuffer.position();
+  int nextNode = 0;
+  m_chunks.reserve(m_header.chunkCount);
+  for (uint32_t chunkNumber = 0; chunkNumber < m_header.chunkCount; ++chunkNumber)
+  {
+    if (size - offset < chunkHeaderSize)
+    {
+      throw ConfigurationError(TRACE_INFO "Savegame is truncated");
+    }
+
+    ChunkLocation location = readChunkHeader(m_header, data + offset, chunkNumber);
+    location.offset = offset + chunkHeaderSize;
+    // chunks are decoded in parallel, so they must not overlap
+    if (location.firstNode != static_cast<uint32_t>(nextNode) || size - location.offset < location.compressedSize)
+    {
+      throw ConfigurationError(TRACE_INFO "Binary savegame chunk " + std::to_string(chunkNumber) + " is damaged");
+    }
+
+    nextNode += static_cast<int>(location.nodeCount);
+    offset = location.offset + location.compressedSize;
+    m_chunks.push_back(location);
+  }
+}
+
+void MemoryReader::checkChunk(size_t chunkNumber) const
+{
+  const ChunkLocation &location = m_chunks.at(chunkNumber);
+  checkChunkData(location, reinterpret_cast<const unsigned char *>(m_data + location.offset), chunkNumber);
+}
+
+void MemoryReader::readChunk(size_t chunkNumber, Chunk &chunk) const
+{
+  const ChunkLocation &location = m_chunks.at(chunkNumber);
+  std::string payload;
+  decodeChunk(location, reinterpret_cast<const unsigned char *>(m_data + location.offset), chunkNumber, payload, chunk);
+}
+
+} // namespace BinarySaveGame
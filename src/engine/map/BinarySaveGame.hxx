@@ -0,0 +1,176 @@
+#ifndef BINARYSAVEGAME_HXX_
+#define BINARYSAVEGAME_HXX_
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../common/enums.hxx"
+
+/** @brief Binary savegame format
+ * A savegame starts with a header and a table of all tile ID strings, followed by chunks of consecutive map nodes.
+ * Within a chunk every attribute is stored as a fixed-width column: first the heights of all nodes, then per layer the
+ * tiles (as index into the string table), the tile indices and the origin corner nodes. The columns of a chunk are
+ * compressed with zlib and carry a CRC-32 checksum, so a damaged file is detected instead of loaded.
+ * All numbers are little endian.
+ * @see Map#saveMapToFile
+ */
+namespace BinarySaveGame
+{
+
+/// Version of the binary layout. The contents of a map are versioned by SAVEGAME_VERSION
+constexpr uint32_t formatVersion = 1;
+
+/// Number of map nodes in a chunk, except for the last one
+constexpr int nodesPerChunk = 8192;
+
+/// General information about a savegame
+struct Header
+{
+  uint32_t saveGameVersion = 0;
+  int32_t columns = 0;
+  int32_t rows = 0;
+  uint32_t chunkCount = 0;
+};
+
+/// The columns of a range of consecutive map nodes
+struct Chunk
+{
+  /// index of the first node
+  int firstNode = 0;
+  int nodeCount = 0;
+  std::vector<uint8_t> heights;
+  /// index into the tile ID string table
+  std::array<std::vector<uint16_t>, LAYERS_COUNT> tileRefs;
+  std::array<std::vector<uint16_t>, LAYERS_COUNT> tileIndices;
+  /// node index of the origin corner, or -1 if there is none
+  std::array<std::vector<int32_t>, LAYERS_COUNT> origCornerIndices;
+
+  /// Resize all columns to a number of nodes
+  void resize(int count);
+};
+
+/// Where the compressed columns of a chunk are in a savegame and how to check them
+struct ChunkLocation
+{
+  uint32_t firstNode = 0;
+  uint32_t nodeCount = 0;
+  uint32_t compressedSize = 0;
+  uint32_t checksum = 0;
+  /// offset of the compressed columns from the start of the savegame
+  size_t offset = 0;
+};
+
+/** @brief Check if a stream contains a binary savegame
+ * The position of the stream doesn't change.
+ */
+bool isBinarySaveGame(std::istream &stream);
+
+/** @brief Writes a binary savegame chunk by chunk
+ * Only one chunk is held in memory at a time.
+ */
+class Writer
+{
+public:
+  /** @brief Write the header and the string table
+   * @param stream the stream to write to, opened in binary mode
+   * @param header general information about the savegame. chunkCount chunks have to be written
+   * @param tileIDs the string table, tile references of the chunks point into it
+   * @throws CompressionError if the stream can't be written
+   */
+  Writer(std::ostream &stream, const Header &header, const std::vector<std::string> &tileIDs);
+
+  /** @brief Compress a chunk and write it
+   * @throws CompressionError if the chunk can't be compressed or written
+   */
+  void writeChunk(const Chunk &chunk);
+
+private:
+  std::ostream &m_stream;
+  std::string m_payload;
+  std::vector<unsigned char> m_compressed;
+};
+
+/** @brief Reads a binary savegame chunk by chunk
+ * Only one chunk is held in memory at a time.
+ */
+class Reader
+{
+public:
+  /** @brief Read the header and the string table
+   * @param stream the stream to read from, opened in binary mode
+   * @throws ConfigurationError if the stream doesn't contain a binary savegame of a known format version
+   */
+  explicit Reader(std::istream &stream);
+
+  const Header &getHeader() const { return m_header; };
+
+  /// The string table the tile references of the chunks point into
+  const std::vector<std::string> &getTileIDs() const { return m_tileIDs; };
+
+  /** @brief Read the next chunk
+   * @param chunk the chunk to read into, its columns are reused
+   * @returns false if all chunks have been read
+   * @throws ConfigurationError if the chunk is damaged
+   */
+  bool readChunk(Chunk &chunk);
+
+private:
+  std::istream &m_stream;
+  Header m_header;
+  std::vector<std::string> m_tileIDs;
+  uint32_t m_chunksRead = 0;
+  std::string m_payload;
+  std::vector<unsigned char> m_compressed;
+};
+
+/** @brief Reads a binary savegame that is in memory completely
+ * The chunk headers are the index of the savegame: the chunks are located once by hopping from one header to the next,
+ * without touching their data. After that the chunks can be decoded in any order and by several threads at once.
+ */
+class MemoryReader
+{
+public:
+  /** @brief Read the header and the string table and locate all chunks
+   * @param data the savegame, it has to outlive the reader
+   * @param size size of the savegame in bytes
+   * @throws ConfigurationError if the data isn't a binary savegame of a known format version or it's truncated
+   */
+  MemoryReader(const char *data, size_t size);
+
+  const Header &getHeader() const { return m_header; };
+
+  /// The string table the tile references of the chunks point into
+  const std::vector<std::string> &getTileIDs() const { return m_tileIDs; };
+
+  size_t getChunkCount() const { return m_chunks.size(); };
+
+  /// Get the nodes a chunk covers and where its data is, without decoding it
+  const ChunkLocation &getChunkLocation(size_t chunkNumber) const { return m_chunks[chunkNumber]; };
+
+  /** @brief Check the checksum of a chunk without decoding it, can be called from several threads at once
+   * @throws ConfigurationError if the chunk is damaged
+   */
+  void checkChunk(size_t chunkNumber) const;
+
+  /** @brief Decode a chunk, can be called from several threads at once
+   * The chunks cover consecutive nodes without overlapping.
+   * @param chunkNumber the number of the chunk in the savegame
+   * @param chunk the chunk to read into, its columns are reused
+   * @throws ConfigurationError if the chunk is damaged
+   */
+  void readChunk(size_t chunkNumber, Chunk &chunk) const;
+
+private:
+  const char *m_data;
+  Header m_header;
+  std::vector<std::string> m_tileIDs;
+  std::vector<ChunkLocation> m_chunks;
+};
+
+} // namespace BinarySaveGame
+
+#endif
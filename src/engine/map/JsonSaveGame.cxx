@@ -0,0 +1,330 @@
+#include "JsonSaveGame.hxx"
+
+#include <charconv>
+#include <unordered_map>
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+#include "json.hxx"
+
+using json = nlohmann::json;
+
+namespace JsonSaveGame
+{
+
+namespace
+{
+/// the SAX handler has a member called string, which hides the one TRACE_INFO uses
+[[noreturn]] void throwSaveGameError(const std::string &reason)
+{
+  throw ConfigurationError(TRACE_INFO "Could not load the savegame, " + reason);
+}
+
+/// Receives the events of the SAX parser and collects the nodes of the savegame from them
+class SaveGameHandler : public nlohmann::json_sax<json>
+{
+public:
+  SaveGameHandler(const HeaderCallback &onHeader, const NodeCallback &onNode)
+      : m_onHeader(onHeader), m_onNode(onNode), m_tileIDs{""}, m_tileRefs{{"", 0}} {};
+
+  bool null() override { return true; };
+  bool boolean(bool) override { return true; };
+  bool number_integer(number_integer_t value) override { return number(value); };
+  bool number_unsigned(number_unsigned_t value) override { return number(static_cast<int64_t>(value)); };
+  bool number_float(number_float_t, const string_t &) override { return true; };
+
+  bool string(string_t &value) override
+  {
+    if (top() == Context::LAYER && m_key == "tileID")
+    {
+      m_layer->tileRef = tileRef(value);
+    }
+    return true;
+  }
+
+  bool key(string_t &value) override
+  {
+    m_key = value;
+    return true;
+  }
+
+  bool start_object(std::size_t) override
+  {
+    const Context parent = top();
+    if (m_stack.empty())
+    {
+      m_stack.push_back(Context::ROOT);
+    }
+    else if (parent == Context::NODES)
+    {
+      m_node = Node();
+      m_layerCount = 0;
+      m_stack.push_back(Context::NODE);
+    }
+    else if (parent == Context::NODE && m_key == "coordinates")
+    {
+      m_point = &m_node.coordinates;
+      m_stack.push_back(Context::POINT);
+    }
+    else if (parent == Context::LAYERS)
+    {
+      // layers the map doesn't know are ignored
+      m_layer = (m_layerCount < LAYERS_COUNT) ? &m_node.layers[m_layerCount] : &m_ignoredLayer;
+      m_stack.push_back(Context::LAYER);
+    }
+    else if (parent == Context::LAYER && m_key == "origCornerPoint")
+    {
+      m_point = &m_layer->origCornerPoint;
+      m_stack.push_back(Context::POINT);
+    }
+    else
+    {
+      m_stack.push_back(Context::SKIP);
+    }
+    return true;
+  }
+
+  bool end_object() override
+  {
+    const Context context = top();
+    m_stack.pop_back();
+
+    if (context == Context::NODE)
+    {
+      if (m_isHeaderSent)
+      {
+        m_onNode(m_node, m_tileIDs);
+      }
+      else
+      {
+        m_pendingNodes.push_back(m_node);
+      }
+    }
+    else if (context == Context::LAYER)
+    {
+      ++m_layerCount;
+    }
+    else if (context == Context::ROOT)
+    {
+      sendHeader();
+      for (const Node &node : m_pendingNodes)
+      {
+        m_onNode(node, m_tileIDs);
+      }
+      m_pendingNodes.clear();
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t) override
+  {
+    const Context parent = top();
+    if (parent == Context::ROOT && m_key == "mapNode")
+    {
+      // with the size of the map known, the nodes can be passed on right away
+      if (m_header.columns > 0 && m_header.rows > 0)
+      {
+        sendHeader();
+      }
+      m_stack.push_back(Context::NODES);
+    }
+    else if (parent == Context::NODE && m_key == "mapNodeData")
+    {
+      m_stack.push_back(Context::LAYERS);
+    }
+    else
+    {
+      m_stack.push_back(Context::SKIP);
+    }
+    return true;
+  }
+
+  bool end_array() override
+  {
+    m_stack.pop_back();
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &exception) override
+  {
+    throwSaveGameError(std::string(exception.what()));
+  }
+
+private:
+  enum class Context
+  {
+    NONE,
+    ROOT,
+    NODES,
+    NODE,
+    LAYERS,
+    LAYER,
+    POINT,
+    SKIP
+  };
+
+  Context top() const { return m_stack.empty() ? Context::NONE : m_stack.back(); };
+
+  bool number(int64_t value)
+  {
+    const Context context = top();
+    if (context == Context::ROOT)
+    {
+      if (m_key == "Savegame version")
+        m_header.saveGameVersion = static_cast<size_t>(value);
+      else if (m_key == "columns")
+        m_header.columns = static_cast<int>(value);
+      else if (m_key == "rows")
+        m_header.rows = static_cast<int>(value);
+    }
+    else if (context == Context::LAYER && m_key == "tileIndex")
+    {
+      m_layer->tileIndex = static_cast<int32_t>(value);
+    }
+    else if (context == Context::POINT)
+    {
+      if (m_key == "x")
+        m_point->x = static_cast<int>(value);
+      else if (m_key == "y")
+        m_point->y = static_cast<int>(value);
+      else if (m_key == "z")
+        m_point->z = static_cast<int>(value);
+      else if (m_key == "height")
+        m_point->height = static_cast<int>(value);
+    }
+    return true;
+  }
+
+  uint16_t tileRef(const std::string &tileID)
+  {
+    const auto it = m_tileRefs.find(tileID);
+    if (it != m_tileRefs.end())
+    {
+      return it->second;
+    }
+    if (m_tileIDs.size() > UINT16_MAX)
+    {
+      throwSaveGameError("it uses too many different tiles");
+    }
+
+    const auto ref = static_cast<uint16_t>(m_tileIDs.size());
+    m_tileIDs.push_back(tileID);
+    m_tileRefs.emplace(tileID, ref);
+    return ref;
+  }
+
+  void sendHeader()
+  {
+    if (m_isHeaderSent)
+    {
+      return;
+    }
+    if (m_header.columns <= 0 || m_header.rows <= 0)
+    {
+      throwSaveGameError("it doesn't contain the size of the map");
+    }
+    m_onHeader(m_header);
+    m_isHeaderSent = true;
+  }
+
+  const HeaderCallback &m_onHeader;
+  const NodeCallback &m_onNode;
+  std::vector<Context> m_stack;
+  std::string m_key;
+  Header m_header;
+  bool m_isHeaderSent = false;
+  Node m_node;
+  size_t m_layerCount = 0;
+  NodeLayer *m_layer = nullptr;
+  NodeLayer m_ignoredLayer;
+  Point *m_point = nullptr;
+  std::vector<std::string> m_tileIDs;
+  std::unordered_map<std::string, uint16_t> m_tileRefs;
+  std::vector<Node> m_pendingNodes;
+};
+} // namespace
+
+Writer::Writer(std::ostream &stream, const Header &header, const std::vector<std::string> &tileIDs)
+    : m_stream(stream), m_tileIDs(tileIDs)
+{
+  m_stream << "{\"Savegame version\":";
+  writeNumber(static_cast<int64_t>(header.saveGameVersion));
+  m_stream << ",\"columns\":";
+  writeNumber(header.columns);
+  m_stream << ",\"rows\":";
+  writeNumber(header.rows);
+  m_stream << ",\"mapNode\":[";
+}
+
+void Writer::writeNode(const Node &node)
+{
+  m_stream << (m_isFirstNode ? "{\"coordinates\":" : ",{\"coordinates\":");
+  m_isFirstNode = false;
+  writePoint(node.coordinates);
+
+  m_stream << ",\"mapNodeData\":[";
+  for (size_t layer = 0; layer < node.layers.size(); ++layer)
+  {
+    const NodeLayer &nodeLayer = node.layers[layer];
+    m_stream << (layer == 0 ? "{\"origCornerPoint\":" : ",{\"origCornerPoint\":");
+    writePoint(nodeLayer.origCornerPoint);
+    m_stream << ",\"tileID\":";
+    writeString(m_tileIDs[nodeLayer.tileRef]);
+    m_stream << ",\"tileIndex\":";
+    writeNumber(nodeLayer.tileIndex);
+    m_stream << '}';
+  }
+  m_stream << "]}";
+}
+
+void Writer::finish() { m_stream << "]}"; }
+
+void Writer::writePoint(const Point &point)
+{
+  m_stream << "{\"height\":";
+  writeNumber(point.height);
+  m_stream << ",\"x\":";
+  writeNumber(point.x);
+  m_stream << ",\"y\":";
+  writeNumber(point.y);
+  m_stream << ",\"z\":";
+  writeNumber(point.z);
+  m_stream << '}';
+}
+
+void Writer::writeString(const std::string &text)
+{
+  m_stream << '"';
+  for (const char character : text)
+  {
+    if (character == '"' || character == '\\')
+    {
+      m_stream << '\\' << character;
+    }
+    else if (static_cast<unsigned char>(character) < 0x20)
+    {
+      constexpr char hexDigits[] = "0123456789abcdef";
+      m_stream << "\\u00" << hexDigits[character >> 4] << hexDigits[character & 0xF];
+    }
+    else
+    {
+      m_stream << character;
+    }
+  }
+  m_stream << '"';
+}
+
+void Writer::writeNumber(int64_t number)
+{
+  char digits[24];
+  const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+  m_stream.write(digits, result.ptr - digits);
+}
+
+void read(std::istream &stream, const HeaderCallback &onHeader, const NodeCallback &onNode)
+{
+  SaveGameHandler handler(onHeader, onNode);
+  json::sax_parse(stream, &handler);
+}
+
+} // namespace JsonSaveGame
@@ -0,0 +1,97 @@
+#ifndef JSONSAVEGAME_HXX_
+#define JSONSAVEGAME_HXX_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../basics/point.hxx"
+#include "../common/enums.hxx"
+
+/** @brief Json savegame format
+ * The savegame is a json object with the keys "Savegame version", "columns", "rows" and "mapNode", an array with an
+ * object for each node. Savegames are written and read node by node, without building a json document, so the memory
+ * they need doesn't grow with the size of the map.
+ * @see Map#saveMapToFile
+ */
+namespace JsonSaveGame
+{
+
+/// General information about a savegame
+struct Header
+{
+  size_t saveGameVersion = 0;
+  int columns = -1;
+  int rows = -1;
+};
+
+/// The tile of a node in a single layer
+struct NodeLayer
+{
+  /// index into the tile ID string table
+  uint16_t tileRef = 0;
+  int32_t tileIndex = 0;
+  Point origCornerPoint = Point::INVALID();
+};
+
+/// The data of a single map node
+struct Node
+{
+  Point coordinates;
+  std::array<NodeLayer, LAYERS_COUNT> layers;
+};
+
+/** @brief Writes a json savegame node by node
+ * The keys are written in the order the Reader can pass the nodes on without buffering them.
+ */
+class Writer
+{
+public:
+  /** @brief Write the header and open the node array
+   * @param stream the stream to write to
+   * @param header general information about the savegame
+   * @param tileIDs the string table, the tile references of the nodes point into it
+   */
+  Writer(std::ostream &stream, const Header &header, const std::vector<std::string> &tileIDs);
+
+  void writeNode(const Node &node);
+
+  /// Close the node array and the savegame object
+  void finish();
+
+private:
+  void writePoint(const Point &point);
+  void writeString(const std::string &text);
+  void writeNumber(int64_t number);
+
+  std::ostream &m_stream;
+  const std::vector<std::string> &m_tileIDs;
+  bool m_isFirstNode = true;
+};
+
+/// Called with the header of a savegame, before any of its nodes
+using HeaderCallback = std::function<void(const Header &header)>;
+
+/** @brief Called with every node of a savegame
+ * The tile references point into the string table passed along, which grows while the savegame is read. Its first
+ * string is always the empty one, so layers missing in the savegame stay empty.
+ */
+using NodeCallback = std::function<void(const Node &node, const std::vector<std::string> &tileIDs)>;
+
+/** @brief Read a json savegame with a SAX parser and pass on its nodes as they're parsed
+ * In savegames written by the Writer the header precedes the nodes. Savegames written from a json document have sorted
+ * keys, so "rows" follows the nodes. Those nodes are held back until the header is complete.
+ * @param stream the stream to read from
+ * @param onHeader called once, before the first node
+ * @param onNode called for every node
+ * @throws ConfigurationError if the savegame can't be parsed or misses its header
+ */
+void read(std::istream &stream, const HeaderCallback &onHeader, const NodeCallback &onNode);
+
+} // namespace JsonSaveGame
+
+#endif
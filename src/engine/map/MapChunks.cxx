@@ -0,0 +1,139 @@
+#include "MapChunks.hxx"
+
+#include "MapGrid.hxx"
+#include "../basics/Camera.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+/// sprite sizes and positions are rounded per zoom level, so scaled bounds can be off by a few pixels
+static constexpr int boundsMargin = 4;
+
+MapChunks::MapChunks(int columns, int rows)
+    : m_chunksX((rows + chunkSize - 1) / chunkSize), m_chunksY((columns + chunkSize - 1) / chunkSize)
+{
+  m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+
+  for (int chunkX = 0; chunkX < m_chunksX; ++chunkX)
+  {
+    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY)
+    {
+      MapChunk &chunk = m_chunks[chunkX * m_chunksY + chunkY];
+      chunk.firstX = chunkX * chunkSize;
+      chunk.firstY = chunkY * chunkSize;
+      chunk.lastX = std::min(chunk.firstX + chunkSize, rows) - 1;
+      chunk.lastY = std::min(chunk.firstY + chunkSize, columns) - 1;
+    }
+  }
+}
+
+void MapChunks::markDirty(const Point &isoCoordinates)
+{
+  MapChunk &chunk = m_chunks[chunkIdx(isoCoordinates.x, isoCoordinates.y)];
+  chunk.dirty = true;
+  chunk.revision++;
+  m_hasDirtyChunks = true;
+}
+
+void MapChunks::setRowsLoading(int firstRow, int lastRow, bool loading)
+{
+  const int firstChunkX = std::max(firstRow, 0) / chunkSize;
+  const int lastChunkX = std::min(lastRow / chunkSize, m_chunksX - 1);
+  for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX)
+  {
+    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY)
+    {
+      MapChunk &chunk = m_chunks[chunkX * m_chunksY + chunkY];
+      if (chunk.loading && !loading)
+      {
+        chunk.dirty = true;
+        chunk.revision++;
+        m_hasDirtyChunks = true;
+      }
+      chunk.loading = loading;
+    }
+  }
+}
+
+void MapChunks::refreshDirtyChunks(MapGrid &grid)
+{
+  if (!m_hasDirtyChunks)
+  {
+    return;
+  }
+
+  const double zoomLevel = Camera::instance().zoomLevel();
+  for (auto &chunk : m_chunks)
+  {
+    if (chunk.dirty && !chunk.loading)
+    {
+      refreshChunk(chunk, grid, zoomLevel);
+    }
+  }
+  m_hasDirtyChunks = false;
+}
+
+void MapChunks::cull(MapGrid &grid, const SDL_Rect &screenRect, double zoomLevel)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Cull chunks", MP_YELLOW);
+#endif
+
+  for (auto &chunk : m_chunks)
+  {
+    const SDL_Rect zoomedBounds{static_cast<int>(std::floor(chunk.bounds.x * zoomLevel)) - boundsMargin,
+                                static_cast<int>(std::floor(chunk.bounds.y * zoomLevel)) - boundsMargin,
+                                static_cast<int>(std::ceil(chunk.bounds.w * zoomLevel)) + 2 * boundsMargin,
+                                static_cast<int>(std::ceil(chunk.bounds.h * zoomLevel)) + 2 * boundsMargin};
+
+    chunk.visible = !chunk.loading && (chunk.bounds.w > 0) && (chunk.bounds.h > 0) &&
+                    SDL_HasIntersection(&zoomedBounds, &screenRect);
+
+    if (chunk.visible && chunk.zoomLevel != zoomLevel)
+    {
+      refreshChunk(chunk, grid, zoomLevel);
+    }
+  }
+}
+
+void MapChunks::refreshChunk(MapChunk &chunk, MapGrid &grid, double zoomLevel)
+{
+  SDL_Rect bounds{0, 0, 0, 0};
+
+  for (int x = chunk.firstX; x <= chunk.lastX; ++x)
+  {
+    for (int y = chunk.firstY; y <= chunk.lastY; ++y)
+    {
+      Sprite &sprite = grid.sprite(grid.nodeIdx(x, y));
+      sprite.refresh();
+
+      const SDL_Rect spriteBounds = sprite.getWorldBoundingBox();
+      if (SDL_RectEmpty(&spriteBounds))
+      {
+        continue;
+      }
+      if (SDL_RectEmpty(&bounds))
+      {
+        bounds = spriteBounds;
+      }
+      else
+      {
+        SDL_UnionRect(&bounds, &spriteBounds, &bounds);
+      }
+    }
+  }
+
+  // store the bounds at zoom level 1, so they can be used for culling at any zoom level
+  const int left = static_cast<int>(std::floor(bounds.x / zoomLevel));
+  const int top = static_cast<int>(std::floor(bounds.y / zoomLevel));
+  const int right = static_cast<int>(std::ceil((bounds.x + bounds.w) / zoomLevel));
+  const int bottom = static_cast<int>(std::ceil((bounds.y + bounds.h) / zoomLevel));
+  chunk.bounds = {left, top, right - left, bottom - top};
+
+  chunk.zoomLevel = zoomLevel;
+  chunk.dirty = false;
+}
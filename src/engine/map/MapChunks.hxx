@@ -0,0 +1,110 @@
+#ifndef MAPCHUNKS_HXX_
+#define MAPCHUNKS_HXX_
+
+#include <SDL.h>
+#include <vector>
+
+#include "../basics/point.hxx"
+
+class MapGrid;
+
+/** @brief A square block of map nodes that is culled and refreshed as a whole
+ */
+struct MapChunk
+{
+  /// node coordinates of the chunk, the last coordinates are inclusive
+  int firstX = 0;
+  int firstY = 0;
+  int lastX = 0;
+  int lastY = 0;
+
+  /// bounding box of all sprites of the chunk in world coordinates (screen coordinates without camera offset) at zoom level 1
+  SDL_Rect bounds{0, 0, 0, 0};
+
+  /// zoom level the sprites of this chunk have been refreshed for
+  double zoomLevel = 0;
+
+  /// the content or height of a node in this chunk changed since the last refresh
+  bool dirty = true;
+
+  /// result of the last culling pass
+  bool visible = false;
+
+  /// the nodes of this chunk are still loaded from a savegame on other threads, so its sprites must not be touched
+  bool loading = false;
+
+  /// incremented whenever a node of this chunk changes, so caches of the chunk can tell if they are outdated
+  unsigned int revision = 0;
+};
+
+/** @brief Partitions the map into chunks of chunkSize x chunkSize nodes
+ * Each chunk tracks whether its nodes changed and the screen space its sprites cover, so the map only needs to refresh the
+ * sprites of chunks that changed and can skip all chunks that are outside of the screen.
+ */
+class MapChunks
+{
+public:
+  /// Number of nodes per chunk in each direction
+  static constexpr int chunkSize = 32;
+
+  /** @brief Create the chunks for a map. All chunks start dirty.
+   * @param columns number of columns of the map
+   * @param rows number of rows of the map
+   */
+  MapChunks(int columns, int rows);
+
+  /// Number of chunks in x direction
+  int chunksX() const { return m_chunksX; };
+  /// Number of chunks in y direction
+  int chunksY() const { return m_chunksY; };
+
+  /// Index of the chunk that contains the node at the given iso coordinates
+  int chunkIdx(int x, int y) const { return (x / chunkSize) * m_chunksY + (y / chunkSize); };
+
+  MapChunk &chunk(int index) { return m_chunks[index]; };
+  const MapChunk &chunk(int index) const { return m_chunks[index]; };
+
+  /// Check if the chunk at the given chunk coordinates passed the last culling pass
+  bool isChunkVisible(int chunkX, int chunkY) const { return m_chunks[chunkX * m_chunksY + chunkY].visible; };
+
+  /** @brief Mark the chunk that contains a node as dirty
+   * @param isoCoordinates coordinates of the node that changed
+   */
+  void markDirty(const Point &isoCoordinates);
+
+  /** @brief Mark the chunks that cover some rows as loading or loaded
+   * Chunks that are loading are neither refreshed nor culled, chunks that have been loaded are refreshed next time.
+   * @param firstRow first row (x coordinate) of the nodes
+   * @param lastRow last row of the nodes, inclusive
+   * @param loading whether the nodes of the rows are being loaded
+   */
+  void setRowsLoading(int firstRow, int lastRow, bool loading);
+
+  /// Check if there are chunks that need to be refreshed
+  bool hasDirtyChunks() const { return m_hasDirtyChunks; };
+
+  /** @brief Refresh the sprites of all dirty chunks and recalculate their bounds, chunks that are loading are skipped
+   * @param grid the grid that holds the sprites
+   */
+  void refreshDirtyChunks(MapGrid &grid);
+
+  /** @brief Determine which chunks intersect the screen
+   * Visible chunks whose sprites have been refreshed for another zoom level are refreshed too. Chunks that are loading
+   * are never visible.
+   * @param grid the grid that holds the sprites
+   * @param screenRect the screen in world coordinates
+   * @param zoomLevel current zoom level
+   */
+  void cull(MapGrid &grid, const SDL_Rect &screenRect, double zoomLevel);
+
+private:
+  /// Refresh the sprites of a single chunk and recalculate its bounds
+  void refreshChunk(MapChunk &chunk, MapGrid &grid, double zoomLevel);
+
+  int m_chunksX;
+  int m_chunksY;
+  bool m_hasDirtyChunks = true;
+  std::vector<MapChunk> m_chunks;
+};
+
+#endif
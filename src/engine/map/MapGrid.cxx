@@ -0,0 +1,93 @@
+#include "MapGrid.hxx"
+
+#include "LOG.hxx"
+
+static_assert(LAYERS_COUNT <= 16, "MapGrid stores the render flags of all layers in a 16 bit mask");
+
+MapGrid::MapGrid(int columns, int rows) : m_columns(columns), m_rows(rows)
+{
+  const size_t nodes = static_cast<size_t>(nodeCount());
+
+  m_height.resize(nodes, 0);
+  m_elevationBitmask.resize(nodes, 0);
+  m_elevationOrientation.resize(nodes, TileSlopes::DEFAULT_ORIENTATION);
+  m_renderFlags.resize(nodes, UINT16_MAX);
+  m_previousTileID.resize(nodes, EMPTY_TILE_ID);
+
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    m_tileID[layer].resize(nodes, EMPTY_TILE_ID);
+    m_tileIndex[layer].resize(nodes, 0);
+    m_tileMap[layer].resize(nodes, TileMap::DEFAULT);
+    m_autotileOrientation[layer].resize(nodes, TileOrientation::TILE_DEFAULT_ORIENTATION);
+    m_autotileBitmask[layer].resize(nodes, 0);
+    m_origCornerIndex[layer].resize(nodes);
+
+    // by default every tile is its own origin
+    for (int index = 0; index < nodeCount(); ++index)
+    {
+      m_origCornerIndex[layer][index] = index;
+    }
+  }
+
+  m_sprites.reserve(nodes);
+  for (int index = 0; index < nodeCount(); ++index)
+  {
+    m_sprites.emplace_back(coordinates(index));
+  }
+}
+
+Point MapGrid::coordinates(int index) const { return coordinates(index, m_columns, m_rows, m_height[index]); }
+
+Point MapGrid::coordinates(int index, int columns, int rows, int height)
+{
+  const int x = index / columns;
+  const int y = index % columns;
+  // z-index follows the drawing order: it starts at the topmost node and goes to the right
+  const int z = (columns - 1 - y) * rows + x + 1;
+
+  return {x, y, z, height};
+}
+
+void MapGrid::setShouldRender(Layer layer, int index, bool shouldRender)
+{
+  if (shouldRender)
+  {
+    m_renderFlags[index] |= (1U << layer);
+  }
+  else
+  {
+    m_renderFlags[index] &= ~(1U << layer);
+  }
+}
+
+void MapGrid::clearLayer(Layer layer, int index)
+{
+  m_tileID[layer][index] = EMPTY_TILE_ID;
+  m_tileIndex[layer][index] = 0;
+  m_tileMap[layer][index] = TileMap::DEFAULT;
+  m_autotileOrientation[layer][index] = TileOrientation::TILE_DEFAULT_ORIENTATION;
+  m_origCornerIndex[layer][index] = index;
+}
+
+size_t MapGrid::bytesPerNode() const
+{
+  size_t bytes = sizeof(uint8_t) * 3 + sizeof(uint16_t) + sizeof(TileId) + sizeof(Sprite);
+
+  bytes += LAYERS_COUNT * (sizeof(TileId) + sizeof(uint16_t) + sizeof(uint8_t) * 3 + sizeof(int32_t));
+
+  return bytes;
+}
+
+void MapGrid::logMemoryFootprint() const
+{
+  LOG(LOG_DEBUG) << "MapGrid with " << nodeCount() << " nodes uses " << bytesPerNode() << " bytes per node ("
+                 << (bytesPerNode() * nodeCount()) / 1024 << " KiB total)";
+  LOG(LOG_DEBUG) << "  heights, bitmasks and render flags: " << sizeof(uint8_t) * 3 + sizeof(uint16_t) << " bytes";
+  LOG(LOG_DEBUG) << "  previous tile IDs: " << sizeof(TileId) << " bytes";
+  LOG(LOG_DEBUG) << "  sprites: " << sizeof(Sprite) << " bytes";
+  LOG(LOG_DEBUG) << "  tile IDs: " << LAYERS_COUNT * sizeof(TileId) << " bytes";
+  LOG(LOG_DEBUG) << "  tile indices, tile maps and autotiling: " << LAYERS_COUNT * (sizeof(uint16_t) + sizeof(uint8_t) * 3)
+                 << " bytes";
+  LOG(LOG_DEBUG) << "  origin corner indices: " << LAYERS_COUNT * sizeof(int32_t) << " bytes";
+}
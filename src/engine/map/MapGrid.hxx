@@ -0,0 +1,133 @@
+#ifndef MAPGRID_HXX_
+#define MAPGRID_HXX_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../Sprite.hxx"
+#include "../TileManager.hxx"
+#include "../basics/point.hxx"
+#include "../common/enums.hxx"
+
+/** @brief Layered grid storage for all map nodes
+ * Every attribute of a map node lives in its own dense array that is addressed by the node index (x * columns + y).
+ * Attributes that exist once per layer keep one array per layer. Passes that only touch a single attribute (e.g. heights
+ * or the tiles of one layer) therefore stay cache friendly and the map does not need any per-node heap allocations.
+ * @see MapNode for a lightweight view on a single node of the grid.
+ */
+class MapGrid
+{
+public:
+  /** @brief Create a grid with all nodes set to their default values
+   * @param columns number of columns of the map
+   * @param rows number of rows of the map
+   */
+  MapGrid(int columns, int rows);
+
+  MapGrid(const MapGrid &) = delete;
+  MapGrid &operator=(const MapGrid &) = delete;
+
+  int columns() const { return m_columns; };
+  int rows() const { return m_rows; };
+
+  /// Total number of nodes in the grid
+  int nodeCount() const { return m_columns * m_rows; };
+
+  /** @brief Calculate the node index from iso coordinates.
+   * @param x x coordinate.
+   * @param y y coordinate.
+   * @return index of the node in all attribute arrays.
+   */
+  inline int nodeIdx(const int x, const int y) const { return x * m_columns + y; }
+
+  /** @brief Get the iso coordinates (including height and z-index) of a node
+   * @param index the node index
+   */
+  Point coordinates(int index) const;
+
+  /** @brief Get the iso coordinates of a node in a grid of any size
+   * @param index the node index
+   * @param columns number of columns of the grid
+   * @param rows number of rows of the grid
+   * @param height height of the node
+   */
+  static Point coordinates(int index, int columns, int rows, int height);
+
+  // per node attributes
+  uint8_t &height(int index) { return m_height[index]; };
+  uint8_t height(int index) const { return m_height[index]; };
+  uint8_t &elevationBitmask(int index) { return m_elevationBitmask[index]; };
+  uint8_t elevationBitmask(int index) const { return m_elevationBitmask[index]; };
+  uint8_t &elevationOrientation(int index) { return m_elevationOrientation[index]; };
+  uint8_t elevationOrientation(int index) const { return m_elevationOrientation[index]; };
+  TileId &previousTileId(int index) { return m_previousTileID[index]; };
+  TileId previousTileId(int index) const { return m_previousTileID[index]; };
+  Sprite &sprite(int index) { return m_sprites[index]; };
+  const Sprite &sprite(int index) const { return m_sprites[index]; };
+
+  /** @brief check if the tile of a layer should be rendered
+   * Multi-node buildings only render on their origin node.
+   */
+  bool shouldRender(Layer layer, int index) const { return m_renderFlags[index] & (1U << layer); };
+  void setShouldRender(Layer layer, int index, bool shouldRender);
+
+  // per layer attributes
+  TileId &tileId(Layer layer, int index) { return m_tileID[layer][index]; };
+  TileId tileId(Layer layer, int index) const { return m_tileID[layer][index]; };
+  uint16_t &tileIndex(Layer layer, int index) { return m_tileIndex[layer][index]; };
+  uint16_t tileIndex(Layer layer, int index) const { return m_tileIndex[layer][index]; };
+  uint8_t &tileMap(Layer layer, int index) { return m_tileMap[layer][index]; };
+  uint8_t tileMap(Layer layer, int index) const { return m_tileMap[layer][index]; };
+  uint8_t &autotileOrientation(Layer layer, int index) { return m_autotileOrientation[layer][index]; };
+  uint8_t autotileOrientation(Layer layer, int index) const { return m_autotileOrientation[layer][index]; };
+  uint8_t &autotileBitmask(Layer layer, int index) { return m_autotileBitmask[layer][index]; };
+  uint8_t autotileBitmask(Layer layer, int index) const { return m_autotileBitmask[layer][index]; };
+
+  /** @brief Node index of the origin node of a (multi-node) tile
+   * @return the node index of the origin node or -1 if there is none.
+   */
+  int32_t &origCornerIndex(Layer layer, int index) { return m_origCornerIndex[layer][index]; };
+  int32_t origCornerIndex(Layer layer, int index) const { return m_origCornerIndex[layer][index]; };
+
+  // whole attribute arrays, indexed by node index, e.g. for copying them into a savegame
+  const std::vector<uint8_t> &heights() const { return m_height; };
+  const std::vector<TileId> &tileIds(Layer layer) const { return m_tileID[layer]; };
+  const std::vector<uint16_t> &tileIndices(Layer layer) const { return m_tileIndex[layer]; };
+  const std::vector<int32_t> &origCornerIndices(Layer layer) const { return m_origCornerIndex[layer]; };
+
+  /** @brief Reset all per-layer attributes of a node for a single layer
+   */
+  void clearLayer(Layer layer, int index);
+
+  /** @brief Get the amount of memory the grid uses per node.
+   * @return bytes per node for all attribute arrays.
+   */
+  size_t bytesPerNode() const;
+
+  /** @brief Log the per-attribute memory footprint of the grid
+   */
+  void logMemoryFootprint() const;
+
+private:
+  template <typename T> using LayerArray = std::array<std::vector<T>, LAYERS_COUNT>;
+
+  int m_columns;
+  int m_rows;
+
+  std::vector<uint8_t> m_height;
+  std::vector<uint8_t> m_elevationBitmask;
+  std::vector<uint8_t> m_elevationOrientation;
+  std::vector<uint16_t> m_renderFlags;
+  std::vector<TileId> m_previousTileID;
+  std::vector<Sprite> m_sprites;
+
+  LayerArray<TileId> m_tileID;
+  LayerArray<uint16_t> m_tileIndex;
+  LayerArray<uint8_t> m_tileMap;
+  LayerArray<uint8_t> m_autotileOrientation;
+  LayerArray<uint8_t> m_autotileBitmask;
+  LayerArray<int32_t> m_origCornerIndex;
+};
+
+#endif
@@ -33,6 +33,12 @@ public:
 */
   static inline bool isLayerActive(unsigned int layer) { return (m_activeLayers & (1U << layer)); };
 
+  /** \brief Get all layers that are being drawn
+* @return bitmask of the active layers
+* @see Layer
+*/
+  static inline unsigned int getActiveLayers() { return m_activeLayers; };
+
   /** \brief Toggle Drawing Layer
 * Toggle Drawing Layer (use bitwise XOR to toggle layer)
 * @param bitmapped uint32_t from enum "Layer"
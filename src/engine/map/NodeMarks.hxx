@@ -0,0 +1,54 @@
+#ifndef NODEMARKS_HXX_
+#define NODEMARKS_HXX_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/** @brief A set of map node indices that can be emptied in constant time
+ * Every node has a stamp, a node is marked if its stamp equals the current epoch. Starting a new epoch unmarks all nodes
+ * at once, so the buffer can be reused for every pass over the map without clearing it.
+ */
+class NodeMarks
+{
+public:
+  /** @brief Resize the set to the number of nodes of the map, which unmarks all nodes
+   * @param nodeCount number of nodes of the map
+   */
+  void resize(size_t nodeCount)
+  {
+    m_stamps.assign(nodeCount, 0);
+    m_epoch = 1;
+  }
+
+  /// Unmark all nodes
+  void nextEpoch()
+  {
+    if (++m_epoch == 0)
+    { // the stamps of old epochs could be mistaken for the new epoch after an overflow
+      std::fill(m_stamps.begin(), m_stamps.end(), 0);
+      m_epoch = 1;
+    }
+  }
+
+  bool isMarked(int index) const { return m_stamps[index] == m_epoch; }
+  void mark(int index) { m_stamps[index] = m_epoch; }
+  void unmark(int index) { m_stamps[index] = 0; }
+
+  /** @brief Mark a node
+   * @return true if the node has not been marked before
+   */
+  bool tryMark(int index)
+  {
+    const bool wasMarked = isMarked(index);
+    mark(index);
+    return !wasMarked;
+  }
+
+private:
+  std::vector<uint32_t> m_stamps;
+  /// epoch 0 is never used, so unmarked nodes can be stamped with it
+  uint32_t m_epoch = 1;
+};
+
+#endif
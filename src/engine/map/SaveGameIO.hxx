@@ -0,0 +1,81 @@
+#ifndef SAVEGAMEIO_HXX_
+#define SAVEGAMEIO_HXX_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+/// Little endian encoding shared by the binary savegame files
+namespace SaveGameIO
+{
+
+template <typename T> void appendValue(std::string &buffer, T value)
+{
+  const auto bits = static_cast<std::make_unsigned_t<T>>(value);
+  for (size_t byte = 0; byte < sizeof(T); ++byte)
+  {
+    buffer.push_back(static_cast<char>((bits >> (8 * byte)) & 0xFF));
+  }
+}
+
+template <typename T> void appendColumn(std::string &buffer, const std::vector<T> &column)
+{
+  for (const T value : column)
+  {
+    appendValue(buffer, value);
+  }
+}
+
+/// Reads little endian values from a buffer, reading past its end throws
+class BufferReader
+{
+public:
+  BufferReader(const char *data, size_t size) : m_data(data), m_size(size){};
+
+  template <typename T> T read()
+  {
+    if (m_size - m_position < sizeof(T))
+    {
+      throw ConfigurationError(TRACE_INFO "Savegame is truncated");
+    }
+
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t byte = 0; byte < sizeof(T); ++byte)
+    {
+      bits |= static_cast<std::make_unsigned_t<T>>(static_cast<unsigned char>(m_data[m_position++])) << (8 * byte);
+    }
+    return static_cast<T>(bits);
+  }
+
+  template <typename T> void readColumn(std::vector<T> &column)
+  {
+    for (T &value : column)
+    {
+      value = read<T>();
+    }
+  }
+
+private:
+  const char *m_data;
+  size_t m_size;
+  size_t m_position = 0;
+};
+
+/// Read a fixed number of bytes from a stream into a buffer
+template <typename Buffer> void readBytes(std::istream &stream, Buffer &buffer, size_t size)
+{
+  buffer.resize(size);
+  if (size > 0 && !stream.read(reinterpret_cast<char *>(&buffer[0]), static_cast<std::streamsize>(size)))
+  {
+    throw ConfigurationError(TRACE_INFO "Savegame is truncated");
+  }
+}
+
+} // namespace SaveGameIO
+
+#endif
@@ -0,0 +1,232 @@
+#include "SaveGameJournal.hxx"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "SaveGameIO.hxx"
+
+namespace SaveGameJournal
+{
+
+using namespace SaveGameIO;
+
+namespace
+{
+constexpr char magic[] = {'C', 'Y', 'T', 'O', 'J', 'R', 'N', 'L'};
+
+/// size of a node in the columns of a batch
+constexpr size_t bytesPerNode =
+    sizeof(int32_t) + sizeof(uint8_t) + LAYERS_COUNT * (sizeof(uint16_t) + sizeof(uint16_t) + sizeof(int32_t));
+} // namespace
+
+void Batch::resize(size_t count)
+{
+  nodeIndices.resize(count);
+  heights.resize(count);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    tileRefs[layer].resize(count);
+    tileIndices[layer].resize(count);
+    origCornerIndices[layer].resize(count);
+  }
+}
+
+void Batch::addNode(const MapGrid &grid, int index)
+{
+  nodeIndices.push_back(index);
+  heights.push_back(grid.height(index));
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    const Layer currentLayer = static_cast<Layer>(layer);
+    tileRefs[layer].push_back(grid.tileId(currentLayer, index));
+    tileIndices[layer].push_back(grid.tileIndex(currentLayer, index));
+    origCornerIndices[layer].push_back(grid.origCornerIndex(currentLayer, index));
+  }
+}
+
+void Batch::addNode(const Batch &batch, size_t position)
+{
+  nodeIndices.push_back(batch.nodeIndices[position]);
+  heights.push_back(batch.heights[position]);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    tileRefs[layer].push_back(batch.tileRefs[layer][position]);
+    tileIndices[layer].push_back(batch.tileIndices[layer][position]);
+    origCornerIndices[layer].push_back(batch.origCornerIndices[layer][position]);
+  }
+}
+
+std::string journalPath(const std::string &saveGamePath) { return saveGamePath + ".journal"; }
+
+uint32_t fileChecksum(const std::string &filePath)
+{
+  std::ifstream stream(filePath, std::ios_base::in | std::ios_base::binary);
+  if (!stream)
+  {
+    throw ConfigurationError(TRACE_INFO "Can't open file " + filePath);
+  }
+
+  std::vector<char> buffer(65536);
+  uLong checksum = crc32(0L, Z_NULL, 0);
+  while (stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || stream.gcount() > 0)
+  {
+    checksum = crc32(checksum, reinterpret_cast<const Bytef *>(buffer.data()), static_cast<uInt>(stream.gcount()));
+  }
+
+  if (stream.bad())
+  {
+    throw ConfigurationError(TRACE_INFO "Could not read file " + filePath);
+  }
+  return static_cast<uint32_t>(checksum);
+}
+
+void create(const std::string &filePath, const Header &header, const std::vector<std::string> &tileIDs)
+{
+  std::string buffer(magic, sizeof(magic));
+  appendValue(buffer, formatVersion);
+  appendValue(buffer, header.baseChecksum);
+  appendValue(buffer, header.columns);
+  appendValue(buffer, header.rows);
+  appendValue(buffer, static_cast<uint32_t>(LAYERS_COUNT));
+  appendValue(buffer, static_cast<uint32_t>(tileIDs.size()));
+  for (const std::string &tileID : tileIDs)
+  {
+    const auto length = static_cast<uint16_t>(std::min<size_t>(tileID.size(), UINT16_MAX));
+    appendValue(buffer, length);
+    buffer.append(tileID, 0, length);
+  }
+
+  std::ofstream stream(filePath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  stream.close();
+  if (!stream)
+  {
+    throw CompressionError(TRACE_INFO "Could not write journal " + filePath);
+  }
+}
+
+void append(const std::string &filePath, const Batch &batch)
+{
+  std::string payload;
+  payload.reserve(batch.size() * bytesPerNode);
+  appendColumn(payload, batch.nodeIndices);
+  appendColumn(payload, batch.heights);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    appendColumn(payload, batch.tileRefs[layer]);
+    appendColumn(payload, batch.tileIndices[layer]);
+    appendColumn(payload, batch.origCornerIndices[layer]);
+  }
+
+  uLongf compressedSize = compressBound(static_cast<uLong>(payload.size()));
+  std::vector<unsigned char> compressed(compressedSize);
+  if (compress2(compressed.data(), &compressedSize, reinterpret_cast<const Bytef *>(payload.data()),
+                static_cast<uLong>(payload.size()), Z_DEFAULT_COMPRESSION) != Z_OK)
+  {
+    throw CompressionError(TRACE_INFO "Could not compress journal batch");
+  }
+
+  std::string batchHeader;
+  appendValue(batchHeader, static_cast<uint32_t>(batch.size()));
+  appendValue(batchHeader, static_cast<uint32_t>(compressedSize));
+  appendValue(batchHeader, static_cast<uint32_t>(crc32(0L, compressed.data(), static_cast<uInt>(compressedSize))));
+
+  std::ofstream stream(filePath, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+  stream.write(batchHeader.data(), static_cast<std::streamsize>(batchHeader.size()));
+  stream.write(reinterpret_cast<const char *>(compressed.data()), static_cast<std::streamsize>(compressedSize));
+  stream.close();
+  if (!stream)
+  {
+    throw CompressionError(TRACE_INFO "Could not append to journal " + filePath);
+  }
+}
+
+Reader::Reader(std::istream &stream) : m_stream(stream)
+{
+  constexpr size_t headerSize = sizeof(magic) + 6 * sizeof(uint32_t);
+  readBytes(m_stream, m_payload, headerSize);
+  if (!std::equal(magic, magic + sizeof(magic), m_payload.begin()))
+  {
+    throw ConfigurationError(TRACE_INFO "Not a savegame journal");
+  }
+
+  BufferReader header(m_payload.data() + sizeof(magic), headerSize - sizeof(magic));
+  const auto fileFormatVersion = header.read<uint32_t>();
+  if (fileFormatVersion != formatVersion)
+  {
+    throw ConfigurationError(TRACE_INFO "Savegame journal format version " + std::to_string(fileFormatVersion) +
+                             " is not supported");
+  }
+  m_header.baseChecksum = header.read<uint32_t>();
+  m_header.columns = header.read<int32_t>();
+  m_header.rows = header.read<int32_t>();
+  const auto layerCount = header.read<uint32_t>();
+  const auto tileIDCount = header.read<uint32_t>();
+
+  if (layerCount != LAYERS_COUNT || m_header.columns <= 0 || m_header.rows <= 0 || tileIDCount > UINT16_MAX + 1U)
+  {
+    throw ConfigurationError(TRACE_INFO "Savegame journal header is damaged");
+  }
+
+  m_tileIDs.resize(tileIDCount);
+  std::string length;
+  for (std::string &tileID : m_tileIDs)
+  {
+    readBytes(m_stream, length, sizeof(uint16_t));
+    readBytes(m_stream, tileID, BufferReader(length.data(), length.size()).read<uint16_t>());
+  }
+}
+
+bool Reader::readBatch(Batch &batch)
+{
+  // a journal ends after any complete batch
+  if (m_stream.peek() == std::istream::traits_type::eof())
+  {
+    return false;
+  }
+
+  readBytes(m_stream, m_payload, 3 * sizeof(uint32_t));
+  BufferReader batchHeader(m_payload.data(), m_payload.size());
+  const auto nodeCount = batchHeader.read<uint32_t>();
+  const auto compressedSize = batchHeader.read<uint32_t>();
+  const auto checksum = batchHeader.read<uint32_t>();
+
+  const uint64_t nodeCountTotal = static_cast<uint64_t>(m_header.columns) * m_header.rows;
+  if (nodeCount > nodeCountTotal || compressedSize > compressBound(static_cast<uLong>(nodeCount * bytesPerNode)))
+  {
+    throw ConfigurationError(TRACE_INFO "Savegame journal batch " + std::to_string(m_batchesRead) + " is damaged");
+  }
+
+  readBytes(m_stream, m_compressed, compressedSize);
+  if (crc32(0L, m_compressed.data(), static_cast<uInt>(compressedSize)) != checksum)
+  {
+    throw ConfigurationError(TRACE_INFO "Checksum mismatch in savegame journal batch " + std::to_string(m_batchesRead));
+  }
+
+  uLongf payloadSize = static_cast<uLongf>(nodeCount * bytesPerNode);
+  m_payload.resize(payloadSize);
+  if (nodeCount > 0 &&
+      (uncompress(reinterpret_cast<Bytef *>(&m_payload[0]), &payloadSize, m_compressed.data(), compressedSize) != Z_OK ||
+       payloadSize != nodeCount * bytesPerNode))
+  {
+    throw ConfigurationError(TRACE_INFO "Could not decompress savegame journal batch " + std::to_string(m_batchesRead));
+  }
+
+  batch.resize(nodeCount);
+  BufferReader columns(m_payload.data(), m_payload.size());
+  columns.readColumn(batch.nodeIndices);
+  columns.readColumn(batch.heights);
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    columns.readColumn(batch.tileRefs[layer]);
+    columns.readColumn(batch.tileIndices[layer]);
+    columns.readColumn(batch.origCornerIndices[layer]);
+  }
+
+  ++m_batchesRead;
+  return true;
+}
+
+} // namespace SaveGameJournal
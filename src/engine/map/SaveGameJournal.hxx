@@ -0,0 +1,125 @@
+#ifndef SAVEGAMEJOURNAL_HXX_
+#define SAVEGAMEJOURNAL_HXX_
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "MapGrid.hxx"
+
+/** @brief Append-only journal of map changes on top of a binary savegame
+ * Autosaves only append the nodes that changed since the last autosave to the journal next to the savegame, instead of
+ * writing the whole map again. A journal starts with a header that holds the CRC-32 checksum of the savegame it belongs
+ * to and a table of all tile ID strings, followed by batches. Every batch stores the saved attributes of a set of nodes
+ * as columns, like the chunks of a BinarySaveGame: the node indices, the heights and per layer the tiles, tile indices
+ * and origin corner nodes. A batch is compressed with zlib and carries a CRC-32 checksum.
+ * Loading a savegame replays the batches of its journal in order. Batches store the state of the nodes instead of the
+ * operations that changed them, so replaying doesn't depend on random tile choices or on the order nodes settle in.
+ * All numbers are little endian.
+ * @see Map#loadMapFromFile
+ * @see Engine#autoSaveGame
+ */
+namespace SaveGameJournal
+{
+
+/// Version of the journal layout
+constexpr uint32_t formatVersion = 1;
+
+/** @brief The journal is folded into a new savegame once it holds more than 1 / compactionDivisor of the map's nodes
+ * Then replaying the journal would take about as long as loading the savegame.
+ */
+constexpr int compactionDivisor = 4;
+
+/// General information about a journal
+struct Header
+{
+  /// CRC-32 checksum of the savegame the journal belongs to
+  uint32_t baseChecksum = 0;
+  int32_t columns = 0;
+  int32_t rows = 0;
+};
+
+/// The saved attributes of a set of map nodes
+struct Batch
+{
+  std::vector<int32_t> nodeIndices;
+  std::vector<uint8_t> heights;
+  /// index into the tile ID string table
+  std::array<std::vector<uint16_t>, LAYERS_COUNT> tileRefs;
+  std::array<std::vector<uint16_t>, LAYERS_COUNT> tileIndices;
+  /// node index of the origin corner, or -1 if there is none
+  std::array<std::vector<int32_t>, LAYERS_COUNT> origCornerIndices;
+
+  size_t size() const { return nodeIndices.size(); };
+
+  /// Resize all columns to a number of nodes
+  void resize(size_t count);
+
+  /** @brief Add the current state of a node
+   * The tile handles of the grid are used as tile references.
+   */
+  void addNode(const MapGrid &grid, int index);
+
+  /// Add a node of another batch
+  void addNode(const Batch &batch, size_t position);
+};
+
+/// Get the path of the journal of a savegame
+std::string journalPath(const std::string &saveGamePath);
+
+/** @brief Calculate the CRC-32 checksum of a file
+ * @throws ConfigurationError if the file can't be read
+ */
+uint32_t fileChecksum(const std::string &filePath);
+
+/** @brief Start a new, empty journal, replacing an existing one
+ * @param filePath full path of the journal
+ * @param header general information about the journal
+ * @param tileIDs the string table, tile references of the batches point into it
+ * @throws CompressionError if the journal can't be written
+ */
+void create(const std::string &filePath, const Header &header, const std::vector<std::string> &tileIDs);
+
+/** @brief Compress a batch and append it to a journal
+ * A batch that is only partially written, e.g. because the game crashed, is detected when the journal is read.
+ * @throws CompressionError if the batch can't be compressed or written
+ */
+void append(const std::string &filePath, const Batch &batch);
+
+/** @brief Reads a journal batch by batch
+ */
+class Reader
+{
+public:
+  /** @brief Read the header and the string table
+   * @param stream the stream to read from, opened in binary mode
+   * @throws ConfigurationError if the stream doesn't contain a journal of a known format version
+   */
+  explicit Reader(std::istream &stream);
+
+  const Header &getHeader() const { return m_header; };
+
+  /// The string table the tile references of the batches point into
+  const std::vector<std::string> &getTileIDs() const { return m_tileIDs; };
+
+  /** @brief Read the next batch
+   * @param batch the batch to read into, its columns are reused
+   * @returns false if all batches have been read
+   * @throws ConfigurationError if the batch is damaged or truncated
+   */
+  bool readBatch(Batch &batch);
+
+private:
+  std::istream &m_stream;
+  Header m_header;
+  std::vector<std::string> m_tileIDs;
+  uint32_t m_batchesRead = 0;
+  std::string m_payload;
+  std::vector<unsigned char> m_compressed;
+};
+
+} // namespace SaveGameJournal
+
+#endif
@@ -0,0 +1,129 @@
+#include "SaveGameLoader.hxx"
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+#include "ParallelFor.hxx"
+
+SaveGameLoader::SaveGameLoader(const std::string &filePath)
+    : m_file(filePath), m_reader(m_file.data(), m_file.size())
+{
+  int nextNode = 0;
+  m_chunkEnds.reserve(m_reader.getChunkCount());
+  for (size_t chunkNumber = 0; chunkNumber < m_reader.getChunkCount(); ++chunkNumber)
+  {
+    nextNode += static_cast<int>(m_reader.getChunkLocation(chunkNumber).nodeCount);
+    m_chunkEnds.push_back(nextNode);
+  }
+
+  // every node has to belong to a chunk, otherwise nobody would wait for it
+  const BinarySaveGame::Header &header = m_reader.getHeader();
+  if (static_cast<int64_t>(nextNode) != static_cast<int64_t>(header.columns) * header.rows)
+  {
+    throw ConfigurationError(TRACE_INFO "Binary savegame " + filePath + " doesn't cover the whole map");
+  }
+
+  // a damaged chunk has to fail the load before the map replaces the current one, otherwise the next autosave would
+  // overwrite the savegame with a map that has holes. Every chunk is worth a thread
+  parallelFor(
+      0, m_reader.getChunkCount(), [this](size_t chunkNumber) { m_reader.checkChunk(chunkNumber); }, 1);
+}
+
+SaveGameLoader::~SaveGameLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+
+  for (auto &worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+size_t SaveGameLoader::getChunkOfNode(int nodeIndex) const
+{
+  // empty chunks end where the previous chunk ends, so the first chunk that ends after the node covers it
+  return static_cast<size_t>(std::upper_bound(m_chunkEnds.begin(), m_chunkEnds.end(), nodeIndex) - m_chunkEnds.begin());
+}
+
+void SaveGameLoader::start(std::vector<size_t> order, ApplyChunk applyChunk)
+{
+  m_order = std::move(order);
+  m_applyChunk = std::move(applyChunk);
+  m_chunkStates.assign(getChunkCount(), ChunkState::PENDING);
+
+  // one core is left to the game thread, which decodes the chunks it needs itself
+  const size_t workerCount =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 2U) - 1, m_order.size());
+  m_workers.reserve(workerCount);
+  try
+  {
+    for (size_t worker = 0; worker < workerCount; ++worker)
+    {
+      m_workers.emplace_back(&SaveGameLoader::runWorker, this);
+    }
+  }
+  catch (const std::system_error &)
+  {
+    // no more threads can be started, the chunks the workers don't decode are decoded when they're waited for
+  }
+}
+
+void SaveGameLoader::waitForChunk(size_t chunkNumber)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if (m_chunkStates[chunkNumber] == ChunkState::PENDING)
+  {
+    m_chunkStates[chunkNumber] = ChunkState::DECODING;
+    lock.unlock();
+    decodeChunk(chunkNumber);
+    lock.lock();
+    m_chunkStates[chunkNumber] = ChunkState::DECODED;
+    m_chunkDecoded.notify_all();
+    return;
+  }
+
+  m_chunkDecoded.wait(lock, [this, chunkNumber]() { return m_chunkStates[chunkNumber] == ChunkState::DECODED; });
+}
+
+void SaveGameLoader::runWorker()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_isStopping && m_nextChunk < m_order.size())
+  {
+    const size_t chunkNumber = m_order[m_nextChunk++];
+    // the chunk has been needed earlier than its turn
+    if (m_chunkStates[chunkNumber] != ChunkState::PENDING)
+    {
+      continue;
+    }
+
+    m_chunkStates[chunkNumber] = ChunkState::DECODING;
+    lock.unlock();
+    decodeChunk(chunkNumber);
+    lock.lock();
+    m_chunkStates[chunkNumber] = ChunkState::DECODED;
+    m_chunkDecoded.notify_all();
+  }
+}
+
+void SaveGameLoader::decodeChunk(size_t chunkNumber)
+{
+  // the checksums have been checked when the savegame has been opened, so this only happens if it has been written
+  // with damaged nodes. The game is already running then, so loading can't fail anymore
+  try
+  {
+    BinarySaveGame::Chunk chunk;
+    m_reader.readChunk(chunkNumber, chunk);
+    m_applyChunk(chunk);
+  }
+  catch (const std::exception &error)
+  {
+    LOG(LOG_ERROR) << "Skipping chunk " << chunkNumber << " of the savegame, its nodes stay empty: " << error.what();
+  }
+}
@@ -0,0 +1,100 @@
+#ifndef SAVEGAMELOADER_HXX_
+#define SAVEGAMELOADER_HXX_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BinarySaveGame.hxx"
+#include "MappedFile.hxx"
+
+/** @brief Decodes the chunks of a binary savegame on worker threads while the game goes on
+ * The savegame is memory-mapped, opening it only checks the checksums of the chunks and decoding a chunk only touches
+ * its own data. The workers decode the chunks in the order they're given, e.g. the chunks that
+ * are closest to the camera first. A thread that needs the nodes of a chunk waits for it with waitForChunk, a chunk no
+ * worker has started yet is decoded by the waiting thread itself.
+ * A savegame with a damaged chunk can't be opened. A chunk whose nodes turn out to be invalid is logged and skipped,
+ * its nodes stay empty.
+ * @see Map#loadMapFromFile
+ */
+class SaveGameLoader
+{
+public:
+  /** @brief Writes the nodes of a decoded chunk
+   * It's called on the worker threads, for several chunks at once. It must only write the nodes of its chunk and can
+   * throw an exception derived from std::exception if the chunk is damaged.
+   */
+  using ApplyChunk = std::function<void(const BinarySaveGame::Chunk &chunk)>;
+
+  /** @brief Map a savegame and locate its chunks
+   * @param filePath full path of the savegame
+   * The checksums of all chunks are checked, which reads the whole file once.
+   * @throws ConfigurationError if the file isn't a binary savegame of a known format version, it's truncated or a chunk
+   *         is damaged
+   */
+  explicit SaveGameLoader(const std::string &filePath);
+  ~SaveGameLoader();
+
+  SaveGameLoader(const SaveGameLoader &) = delete;
+  SaveGameLoader &operator=(const SaveGameLoader &) = delete;
+
+  const BinarySaveGame::Header &getHeader() const { return m_reader.getHeader(); };
+
+  /// The string table the tile references of the chunks point into
+  const std::vector<std::string> &getTileIDs() const { return m_reader.getTileIDs(); };
+
+  size_t getChunkCount() const { return m_reader.getChunkCount(); };
+
+  /// Get the nodes a chunk covers
+  const BinarySaveGame::ChunkLocation &getChunkLocation(size_t chunkNumber) const
+  {
+    return m_reader.getChunkLocation(chunkNumber);
+  };
+
+  /// Get the number of the chunk that covers a node
+  size_t getChunkOfNode(int nodeIndex) const;
+
+  /** @brief Start decoding the chunks on worker threads
+   * @param order the numbers of all chunks, in the order they're decoded
+   * @param applyChunk writes the nodes of a decoded chunk
+   */
+  void start(std::vector<size_t> order, ApplyChunk applyChunk);
+
+  /** @brief Wait until a chunk has been decoded and its nodes have been written
+   * The nodes the chunk has written are visible to the calling thread afterwards.
+   */
+  void waitForChunk(size_t chunkNumber);
+
+private:
+  enum class ChunkState
+  {
+    PENDING,
+    DECODING,
+    DECODED
+  };
+
+  void runWorker();
+
+  /// Decode a chunk and apply it, a damaged chunk is only logged
+  void decodeChunk(size_t chunkNumber);
+
+  MappedFile m_file;
+  BinarySaveGame::MemoryReader m_reader;
+  /// index after the last node of every chunk
+  std::vector<int> m_chunkEnds;
+  ApplyChunk m_applyChunk;
+  std::vector<size_t> m_order;
+
+  std::mutex m_mutex;
+  std::condition_variable m_chunkDecoded;
+  std::vector<ChunkState> m_chunkStates;
+  /// position in m_order of the next chunk a worker takes
+  size_t m_nextChunk = 0;
+  bool m_isStopping = false;
+  std::vector<std::thread> m_workers;
+};
+
+#endif
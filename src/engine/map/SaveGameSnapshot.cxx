@@ -0,0 +1,134 @@
+#include "SaveGameSnapshot.hxx"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "BinarySaveGame.hxx"
+#include "JsonSaveGame.hxx"
+#include "../basics/ZlibStream.hxx"
+#include "../common/Constants.hxx"
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+SaveGameSnapshot::SaveGameSnapshot(const MapGrid &grid, const std::vector<std::string> &tileIDs)
+    : m_columns(grid.columns()), m_rows(grid.rows()), m_heights(grid.heights()), m_tileIDs(tileIDs)
+{
+  for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+  {
+    const Layer currentLayer = static_cast<Layer>(layer);
+    m_tileIds[layer] = grid.tileIds(currentLayer);
+    m_tileIndices[layer] = grid.tileIndices(currentLayer);
+    m_origCornerIndices[layer] = grid.origCornerIndices(currentLayer);
+  }
+}
+
+void SaveGameSnapshot::saveToFile(const std::string &filePath, SaveGameFormat format) const
+{
+  const std::string temporaryPath = filePath + ".tmp";
+  {
+    std::ofstream stream(temporaryPath, std::ios_base::out | std::ios_base::binary);
+
+    if (!stream)
+    {
+      throw ConfigurationError(TRACE_INFO "Could not write to file " + temporaryPath);
+    }
+
+    if (format == SaveGameFormat::BINARY)
+    {
+      writeBinary(stream);
+    }
+    else
+    {
+      DeflateStreamBuf deflateBuffer(stream);
+      std::ostream compressedStream(&deflateBuffer);
+      writeJson(compressedStream);
+      compressedStream.flush();
+      deflateBuffer.finish();
+    }
+
+    stream.close();
+    if (!stream)
+    {
+      std::remove(temporaryPath.c_str());
+      throw ConfigurationError(TRACE_INFO "Could not write to file " + temporaryPath);
+    }
+  }
+
+  // rename replaces the old savegame at once on POSIX systems, Windows doesn't replace existing files with it
+  if (std::rename(temporaryPath.c_str(), filePath.c_str()) != 0 &&
+      (std::remove(filePath.c_str()) != 0 || std::rename(temporaryPath.c_str(), filePath.c_str()) != 0))
+  {
+    throw ConfigurationError(TRACE_INFO "Could not replace the savegame " + filePath);
+  }
+
+#ifdef DEBUG
+  if (format == SaveGameFormat::JSON)
+  {
+    // Write uncompressed savegame for easier debugging
+    std::ofstream debugStream(filePath + ".txt");
+    writeJson(debugStream);
+  }
+#endif
+}
+
+void SaveGameSnapshot::writeBinary(std::ostream &stream) const
+{
+  const int nodeCount = m_columns * m_rows;
+
+  BinarySaveGame::Header header;
+  header.saveGameVersion = SAVEGAME_VERSION;
+  header.columns = m_columns;
+  header.rows = m_rows;
+  header.chunkCount = (nodeCount + BinarySaveGame::nodesPerChunk - 1) / BinarySaveGame::nodesPerChunk;
+
+  // tile handles index the string table directly
+  BinarySaveGame::Writer writer(stream, header, m_tileIDs);
+  BinarySaveGame::Chunk chunk;
+
+  for (int firstNode = 0; firstNode < nodeCount; firstNode += BinarySaveGame::nodesPerChunk)
+  {
+    chunk.firstNode = firstNode;
+    chunk.resize(std::min(BinarySaveGame::nodesPerChunk, nodeCount - firstNode));
+
+    const auto copyColumn = [&chunk, firstNode](const auto &source, auto &destination)
+    { std::copy_n(source.begin() + firstNode, chunk.nodeCount, destination.begin()); };
+
+    copyColumn(m_heights, chunk.heights);
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      copyColumn(m_tileIds[layer], chunk.tileRefs[layer]);
+      copyColumn(m_tileIndices[layer], chunk.tileIndices[layer]);
+      copyColumn(m_origCornerIndices[layer], chunk.origCornerIndices[layer]);
+    }
+
+    writer.writeChunk(chunk);
+  }
+}
+
+void SaveGameSnapshot::writeJson(std::ostream &stream) const
+{
+  const JsonSaveGame::Header header{SAVEGAME_VERSION, m_columns, m_rows};
+  // tile handles index the string table directly
+  JsonSaveGame::Writer writer(stream, header, m_tileIDs);
+  JsonSaveGame::Node node;
+
+  for (int index = 0; index < m_columns * m_rows; ++index)
+  {
+    node.coordinates = MapGrid::coordinates(index, m_columns, m_rows, m_heights[index]);
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      const int32_t origCornerIndex = m_origCornerIndices[layer][index];
+
+      JsonSaveGame::NodeLayer &nodeLayer = node.layers[layer];
+      nodeLayer.tileRef = m_tileIds[layer][index];
+      nodeLayer.tileIndex = m_tileIndices[layer][index];
+      nodeLayer.origCornerPoint = (origCornerIndex >= 0)
+                                      ? MapGrid::coordinates(origCornerIndex, m_columns, m_rows, m_heights[origCornerIndex])
+                                      : Point::INVALID();
+    }
+    writer.writeNode(node);
+  }
+
+  writer.finish();
+}
@@ -0,0 +1,68 @@
+#ifndef SAVEGAMESNAPSHOT_HXX_
+#define SAVEGAMESNAPSHOT_HXX_
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "MapGrid.hxx"
+
+/// File formats a map can be saved in
+enum class SaveGameFormat
+{
+  /// chunked binary columns, fast to write and read
+  BINARY,
+  /// the zlib compressed json dump, for exporting maps and for older savegames
+  JSON
+};
+
+/** @brief Copy of everything a savegame stores about a map
+ * Only the compact attribute arrays of the MapGrid that are saved are copied: the heights and per layer the tile
+ * handles, tile indices and origin corners. Copying them takes a fraction of a frame even for big maps, after that the
+ * snapshot can be serialized on another thread while the map keeps changing.
+ * @see SaveGameService
+ */
+class SaveGameSnapshot
+{
+public:
+  /** @brief Copy the saved attributes of a grid
+   * @param grid the grid of the map
+   * @param tileIDs the tile ID strings, indexed by the tile handles of the grid
+   */
+  SaveGameSnapshot(const MapGrid &grid, const std::vector<std::string> &tileIDs);
+
+  int columns() const { return m_columns; };
+  int rows() const { return m_rows; };
+
+  /// The tile ID strings, indexed by tile handle
+  const std::vector<std::string> &getTileIDs() const { return m_tileIDs; };
+
+  /** @brief Write the savegame to a file
+   * The savegame is written to a temporary file first, which then replaces the file. A savegame that fails to save
+   * doesn't damage the last one.
+   * @param filePath full path of the file
+   * @param format the file format
+   * @throws ConfigurationError if the file can't be written
+   */
+  void saveToFile(const std::string &filePath, SaveGameFormat format) const;
+
+  /// Write the savegame in the BinarySaveGame format, chunk by chunk
+  void writeBinary(std::ostream &stream) const;
+
+  /// Write the savegame as uncompressed json, node by node
+  void writeJson(std::ostream &stream) const;
+
+private:
+  int m_columns;
+  int m_rows;
+  std::vector<uint8_t> m_heights;
+  std::array<std::vector<TileId>, LAYERS_COUNT> m_tileIds;
+  std::array<std::vector<uint16_t>, LAYERS_COUNT> m_tileIndices;
+  std::array<std::vector<int32_t>, LAYERS_COUNT> m_origCornerIndices;
+  /// the tile ID strings, indexed by tile handle
+  std::vector<std::string> m_tileIDs;
+};
+
+#endif
@@ -16,7 +16,7 @@
 
 using json = nlohmann::json;
 
-void TerrainGenerator::generateTerrain(std::vector<MapNode> &mapNodes, std::vector<MapNode *> &mapNodesInDrawingOrder)
+void TerrainGenerator::generateTerrain(std::vector<MapNode> &mapNodes)
 {
   loadTerrainDataFromJSON();
 
@@ -81,82 +81,65 @@ void TerrainGenerator::generateTerrain(std::vector<MapNode> &mapNodes, std::vect
   highFrequencyNoise.SetSeed(m_terrainSettings.seed + 42);
   highFrequencyNoise.SetFrequency(1);
 
-  const int mapSize = m_terrainSettings.mapSize;
-  const size_t vectorSize = static_cast<size_t>(mapSize * mapSize);
-  mapNodes.reserve(vectorSize);
-
   // For now, the biome string is read from settings.json for debugging
   std::string currentBiome = Settings::instance().biome;
 
-  // nodes need to be created at the correct vector "coordinates", or else the Z-Order will be broken
-  for (int x = 0; x < mapSize; x++)
+  // nodes are ordered by their node index, so the terrain is generated column by column
+  for (MapNode &mapNode : mapNodes)
   {
-    for (int y = 0; y < mapSize; y++)
+    const Point coordinates = mapNode.getCoordinates();
+    const int x = coordinates.x;
+    const int y = coordinates.y;
+    double rawHeight = terrainHeight.GetValue(x * 32, y * 32, 0.5);
+    int height = static_cast<int>(rawHeight);
+
+    if (height < m_terrainSettings.seaLevel)
+    {
+      height = m_terrainSettings.seaLevel;
+      mapNode.initialize(height, m_biomeInformation[currentBiome].water[0]);
+    }
+    else
     {
-      const int z = 0; // it's not possible to calculate the correct z-index, so set it later in a for loop
-      double rawHeight = terrainHeight.GetValue(x * 32, y * 32, 0.5);
-      int height = static_cast<int>(rawHeight);
+      const double foliageDensity = foliageDensityPerlin.GetValue(x * 32, y * 32, height / 32.0);
+      bool placed = false;
 
-      if (height < m_terrainSettings.seaLevel)
-      {
-        height = m_terrainSettings.seaLevel;
-        mapNodes.emplace_back(MapNode{Point{x, y, z, height}, m_biomeInformation[currentBiome].water[0]});
-      }
-      else
+      if (foliageDensity > 0.0 && height > m_terrainSettings.seaLevel)
       {
-        const double foliageDensity = foliageDensityPerlin.GetValue(x * 32, y * 32, height / 32.0);
-        bool placed = false;
+        int tileIndex = static_cast<int>(std::abs(round(highFrequencyNoise.GetValue(x * 32, y * 32, height / 32.0) * 200.0)));
 
-        if (foliageDensity > 0.0 && height > m_terrainSettings.seaLevel)
+        if (foliageDensity < 0.1)
         {
-          int tileIndex = static_cast<int>(std::abs(round(highFrequencyNoise.GetValue(x * 32, y * 32, height / 32.0) * 200.0)));
-
-          if (foliageDensity < 0.1)
-          {
-            if (tileIndex < 20)
-            {
-              tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesLight.size());
-              mapNodes.emplace_back(MapNode{Point{x, y, z, height}, m_biomeInformation[currentBiome].terrain[0],
-                                            m_biomeInformation[currentBiome].treesLight[tileIndex]});
-              placed = true;
-            }
-          }
-          else if (foliageDensity < 0.25)
+          if (tileIndex < 20)
           {
-            if (tileIndex < 50)
-            {
-              tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesMedium.size());
-              mapNodes.emplace_back(MapNode{Point{x, y, z, height}, m_biomeInformation[currentBiome].terrain[0],
-                                            m_biomeInformation[currentBiome].treesMedium[tileIndex]});
-              placed = true;
-            }
+            tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesLight.size());
+            mapNode.initialize(height, m_biomeInformation[currentBiome].terrain[0],
+                               m_biomeInformation[currentBiome].treesLight[tileIndex]);
+            placed = true;
           }
-          else if (foliageDensity < 1.0 && tileIndex < 95)
+        }
+        else if (foliageDensity < 0.25)
+        {
+          if (tileIndex < 50)
           {
-            tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesDense.size());
-
-            mapNodes.emplace_back(MapNode{Point{x, y, z, height}, m_biomeInformation[currentBiome].terrain[0],
-                                          m_biomeInformation[currentBiome].treesDense[tileIndex]});
+            tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesMedium.size());
+            mapNode.initialize(height, m_biomeInformation[currentBiome].terrain[0],
+                               m_biomeInformation[currentBiome].treesMedium[tileIndex]);
             placed = true;
           }
         }
-        if (placed == false)
+        else if (foliageDensity < 1.0 && tileIndex < 95)
         {
-          mapNodes.emplace_back(MapNode{Point{x, y, z, height}, m_biomeInformation[currentBiome].terrain[0]});
+          tileIndex = tileIndex % static_cast<int>(m_biomeInformation[currentBiome].treesDense.size());
+
+          mapNode.initialize(height, m_biomeInformation[currentBiome].terrain[0],
+                             m_biomeInformation[currentBiome].treesDense[tileIndex]);
+          placed = true;
         }
       }
-    }
-  }
-
-  int z = 0;
-  // set the z-Index for the mapNodes. It is not used, but it's better to have the correct z-index set
-  for (int y = mapSize - 1; y >= 0; y--)
-  {
-    for (int x = 0; x < mapSize; x++)
-    {
-      z++;
-      mapNodes[x * mapSize + y].setZIndex(z);
-      mapNodesInDrawingOrder.push_back(&mapNodes[x * mapSize + y]);
+      if (placed == false)
+      {
+        mapNode.initialize(height, m_biomeInformation[currentBiome].terrain[0]);
+      }
     }
   }
 }
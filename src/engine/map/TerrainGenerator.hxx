@@ -49,7 +49,11 @@ public:
   TerrainGenerator() = default;
   ~TerrainGenerator() = default;
 
-  void generateTerrain(std::vector<MapNode> &mapNodes, std::vector<MapNode *> &mapNodesInDrawingOrder);
+  /** @brief Generate terrain for all map nodes
+   * Sets the height, terrain and foliage of every node.
+   * @param mapNodes the nodes of the map, ordered by their node index
+   */
+  void generateTerrain(std::vector<MapNode> &mapNodes);
 
   void loadTerrainDataFromJSON();
 
@@ -0,0 +1,74 @@
+#ifndef VISIBLERANGE_HXX_
+#define VISIBLERANGE_HXX_
+
+#include <algorithm>
+
+/** @brief Bounds of the screen in diagonal map coordinates
+ * A node (x, y) is within the bounds if left <= x + y <= right and bottom <= y - x <= top.
+ * On an isometric map these bounds form a diamond in iso coordinates.
+ */
+struct ScreenDiamond
+{
+  int left;
+  int right;
+  int top;
+  int bottom;
+};
+
+namespace VisibleRange
+{
+/// Division by 2 that rounds towards negative infinity
+constexpr int floorHalf(int value) { return (value - (value < 0)) / 2; }
+
+/// Division by 2 that rounds towards positive infinity
+constexpr int ceilHalf(int value) { return -floorHalf(-value); }
+
+/** @brief Call a function for every row of a grid that intersects the screen bounds
+ * Instead of testing every node of the grid, the range of each row is calculated from the bounds, so the cost only depends
+ * on the number of rows that are on screen and not on the size of the map.
+ * The rows are visited in drawing order: y descending.
+ * @param columns number of columns of the map
+ * @param rows number of rows of the map
+ * @param bounds the screen bounds
+ * @param callback function that is called with the y coordinate and the first and last (inclusive) x coordinate of each row
+ */
+template <typename Callback> void forEachRow(int columns, int rows, const ScreenDiamond &bounds, Callback &&callback)
+{
+  // rows outside of this range can not intersect the bounds: their x range would be empty
+  const int yFirst = std::min(columns - 1, floorHalf(bounds.right + bounds.top));
+  const int yLast = std::max(0, ceilHalf(bounds.left + bounds.bottom));
+
+  for (int y = yFirst; y >= yLast; --y)
+  {
+    const int xFirst = std::max({0, bounds.left - y, y - bounds.top});
+    const int xLast = std::min({rows - 1, bounds.right - y, y - bounds.bottom});
+
+    if (xFirst <= xLast)
+    {
+      callback(y, xFirst, xLast);
+    }
+  }
+}
+
+/** @brief Call a function for every node of a grid that lies within the screen bounds
+ * The nodes are visited in drawing order: y descending, and within each row x ascending.
+ * @param columns number of columns of the map
+ * @param rows number of rows of the map
+ * @param bounds the screen bounds
+ * @param callback function that is called with the x and y coordinate of each visible node
+ * @see forEachRow
+ */
+template <typename Callback> void forEachNode(int columns, int rows, const ScreenDiamond &bounds, Callback &&callback)
+{
+  forEachRow(columns, rows, bounds,
+             [&callback](int y, int xFirst, int xLast)
+             {
+               for (int x = xFirst; x <= xLast; ++x)
+               {
+                 callback(x, y);
+               }
+             });
+}
+} // namespace VisibleRange
+
+#endif
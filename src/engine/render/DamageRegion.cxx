@@ -0,0 +1,63 @@
+#include "DamageRegion.hxx"
+
+void DamageRegion::add(const SDL_Rect &rect)
+{
+  if (m_isFull || SDL_RectEmpty(&rect))
+  {
+    return;
+  }
+
+  // a merged rect can overlap rects it didn't overlap before, so merge until nothing overlaps anymore
+  SDL_Rect merged = rect;
+  for (size_t i = 0; i < m_rects.size();)
+  {
+    if (SDL_HasIntersection(&merged, &m_rects[i]))
+    {
+      SDL_UnionRect(&merged, &m_rects[i], &merged);
+      m_rects[i] = m_rects.back();
+      m_rects.pop_back();
+      i = 0;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+  m_rects.push_back(merged);
+
+  if (m_rects.size() > maxRects)
+  {
+    SDL_Rect bounds = m_rects.front();
+    for (const SDL_Rect &damagedRect : m_rects)
+    {
+      SDL_UnionRect(&bounds, &damagedRect, &bounds);
+    }
+    m_rects.assign(1, bounds);
+  }
+}
+
+void DamageRegion::add(const DamageRegion &region)
+{
+  if (region.m_isFull)
+  {
+    invalidate();
+    return;
+  }
+
+  for (const SDL_Rect &rect : region.m_rects)
+  {
+    add(rect);
+  }
+}
+
+void DamageRegion::invalidate()
+{
+  m_isFull = true;
+  m_rects.clear();
+}
+
+void DamageRegion::clear()
+{
+  m_isFull = false;
+  m_rects.clear();
+}
@@ -0,0 +1,46 @@
+#ifndef DAMAGEREGION_HXX_
+#define DAMAGEREGION_HXX_
+
+#include <SDL.h>
+
+#include <vector>
+
+/** @brief The parts of the screen that changed since the last frame
+ * Overlapping rects are merged as they're added. Once there are more than maxRects rects, they're merged into their
+ * bounding box, so redrawing the region never has to go through the quads of a frame too often.
+ */
+class DamageRegion
+{
+public:
+  /// Maximum number of separate rects
+  static constexpr size_t maxRects = 16;
+
+  /** @brief Add a changed rect
+   * @param rect the rect in screen coordinates, empty rects are ignored
+   */
+  void add(const SDL_Rect &rect);
+
+  /// Add all rects of another region
+  void add(const DamageRegion &region);
+
+  /// Mark the whole screen as changed
+  void invalidate();
+
+  /// Mark nothing as changed
+  void clear();
+
+  /// Check if the whole screen changed
+  bool isFull() const { return m_isFull; };
+
+  /// Check if nothing changed
+  bool isEmpty() const { return !m_isFull && m_rects.empty(); };
+
+  /// The changed rects, they don't overlap. Empty if the whole screen changed
+  const std::vector<SDL_Rect> &getRects() const { return m_rects; };
+
+private:
+  std::vector<SDL_Rect> m_rects;
+  bool m_isFull = false;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "FootprintOcclusion.hxx"
+
+#include <cmath>
+
+namespace
+{
+// size of a flat node at zoom level 1, it's as big as the camera's tile size
+constexpr int nodeWidth = 32;
+constexpr int nodeHeight = 16;
+} // namespace
+
+FootprintOcclusion::Coverage FootprintOcclusion::computeCoverage(const HitMask &opaqueMask, const SDL_Rect &frame,
+                                                                 int footprintWidth, int footprintHeight)
+{
+  Coverage coverage;
+
+  for (int i = 0; i < footprintWidth && i < maxFootprintSize; ++i)
+  {
+    for (int j = 0; j < footprintHeight && j < maxFootprintSize; ++j)
+    {
+      // the node's rect relative to the frame, with the frame's bottom center on the origin node's bottom corner
+      const int left = frame.w / 2 + (j - i - 1) * nodeWidth / 2 - coverageMargin;
+      const int top = frame.h - (i + j) * nodeHeight / 2 - nodeHeight - coverageMargin;
+      const int right = left + nodeWidth + 2 * coverageMargin;
+      const int bottom = top + nodeHeight + 2 * coverageMargin;
+
+      if (left < 0 || top < 0 || right > frame.w || bottom > frame.h)
+      {
+        continue;
+      }
+
+      bool isCovered = true;
+      for (int y = top; y < bottom && isCovered; ++y)
+      {
+        for (int x = left; x < right && isCovered; ++x)
+        {
+          isCovered = opaqueMask.isOpaque(frame.x + x, frame.y + y);
+        }
+      }
+      coverage[coverageBit(i, j)] = isCovered;
+    }
+  }
+
+  return coverage;
+}
+
+SDL_Rect FootprintOcclusion::nodeRect(const SDL_Rect &buildingRect, int i, int j, double zoomLevel)
+{
+  // the bottom corner of the origin node
+  const int originX = buildingRect.x + buildingRect.w / 2;
+  const int originY = buildingRect.y + buildingRect.h;
+
+  return {originX + static_cast<int>(std::lround((j - i - 1) * nodeWidth / 2 * zoomLevel)),
+          originY - static_cast<int>(std::lround(((i + j) * nodeHeight / 2 + nodeHeight) * zoomLevel)),
+          static_cast<int>(std::lround(nodeWidth * zoomLevel)), static_cast<int>(std::lround(nodeHeight * zoomLevel))};
+}
+
+bool FootprintOcclusion::isInsideNodeRect(const SDL_Rect &spriteRect, const SDL_Rect &nodeRect)
+{
+  return spriteRect.x >= nodeRect.x - 1 && spriteRect.y >= nodeRect.y - 1 &&
+         spriteRect.x + spriteRect.w <= nodeRect.x + nodeRect.w + 1 &&
+         spriteRect.y + spriteRect.h <= nodeRect.y + nodeRect.h + 1;
+}
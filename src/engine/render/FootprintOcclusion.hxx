@@ -0,0 +1,52 @@
+#ifndef FOOTPRINTOCCLUSION_HXX_
+#define FOOTPRINTOCCLUSION_HXX_
+
+#include <SDL.h>
+
+#include <bitset>
+
+#include "HitMask.hxx"
+
+/** @brief Finds the footprint nodes of a building that its sprite covers completely
+ * The terrain, water, ground decoration, zone and road sprites of a covered node are hidden behind the building, so they
+ * don't need to be drawn. A node counts as covered if the building's frame is fully opaque over the whole rect of a flat
+ * node (one tile wide and half a tile high, with its bottom on the node's bottom corner) plus a margin. The margin absorbs
+ * the rounding of scaled sprites, sprites that don't fit into the rect of their node are never skipped.
+ */
+namespace FootprintOcclusion
+{
+/// Maximum width and height of a footprint in nodes
+constexpr int maxFootprintSize = 16;
+
+/// Margin in spritesheet pixels around the rect of a node that has to be opaque too
+constexpr int coverageMargin = 6;
+
+/// Covered nodes of a frame, the bit of node (origin.x - i, origin.y + j) is coverageBit(i, j)
+using Coverage = std::bitset<maxFootprintSize * maxFootprintSize>;
+
+inline size_t coverageBit(int i, int j) { return static_cast<size_t>(i) * maxFootprintSize + static_cast<size_t>(j); }
+
+/** @brief Find the footprint nodes a frame of a building covers
+ * The frame is drawn with the center of its bottom edge on the bottom corner of the origin node.
+ * @param opaqueMask mask of the fully opaque pixels of the spritesheet
+ * @param frame the frame within the spritesheet
+ * @param footprintWidth width of the footprint in nodes
+ * @param footprintHeight height of the footprint in nodes
+ */
+Coverage computeCoverage(const HitMask &opaqueMask, const SDL_Rect &frame, int footprintWidth, int footprintHeight);
+
+/** @brief Get the rect of a flat footprint node in world coordinates
+ * @param buildingRect destination rect of the building sprite in world coordinates
+ * @param i distance of the node from the origin node along the x axis (origin.x - x)
+ * @param j distance of the node from the origin node along the y axis (y - origin.y)
+ * @param zoomLevel the zoom level the building rect has been scaled with
+ */
+SDL_Rect nodeRect(const SDL_Rect &buildingRect, int i, int j, double zoomLevel);
+
+/** @brief Check if a sprite lies within the rect of a node
+ * One pixel of rounding error on each side is accepted, the coverage margin covers it.
+ */
+bool isInsideNodeRect(const SDL_Rect &spriteRect, const SDL_Rect &nodeRect);
+} // namespace FootprintOcclusion
+
+#endif
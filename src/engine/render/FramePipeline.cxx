@@ -0,0 +1,154 @@
+#include "FramePipeline.hxx"
+
+#include "SpriteBatcher.hxx"
+#include "LOG.hxx"
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+FramePipeline::~FramePipeline()
+{
+  stopSimulation();
+
+  if (m_uiLayer)
+  {
+    SDL_DestroyTexture(m_uiLayer);
+  }
+}
+
+void FramePipeline::startSimulation(std::function<bool()> step)
+{
+  stopSimulation();
+  m_simulationRunning = true;
+  m_simulationThread = std::thread(&FramePipeline::runSimulation, this, std::move(step));
+}
+
+void FramePipeline::stopSimulation()
+{
+  m_simulationRunning = false;
+  if (m_simulationThread.joinable())
+  {
+    m_simulationThread.join();
+  }
+}
+
+void FramePipeline::runSimulation(std::function<bool()> step)
+{
+  using Clock = std::chrono::steady_clock;
+
+  while (m_simulationRunning)
+  {
+    const Clock::time_point nextStep = Clock::now() + simulationInterval;
+    {
+      std::lock_guard<std::mutex> lock(m_worldMutex);
+#ifdef MICROPROFILE_ENABLED
+      MICROPROFILE_SCOPEI("Game", "Simulation step", MP_GREEN);
+#endif
+      const Clock::time_point start = Clock::now();
+      try
+      {
+        m_hasSimulationChanges = step() || m_hasSimulationChanges;
+      }
+      catch (...)
+      {
+        m_simulationException = std::current_exception();
+        m_simulationRunning = false;
+        return;
+      }
+      m_simulationTimes.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::this_thread::sleep_until(nextStep);
+  }
+}
+
+bool FramePipeline::lockWorld(bool wait)
+{
+  if (wait)
+  {
+    m_worldMutex.lock();
+  }
+  else if (!m_worldMutex.try_lock())
+  {
+    return false;
+  }
+
+  if (m_simulationException)
+  {
+    const std::exception_ptr exception = m_simulationException;
+    m_simulationException = nullptr;
+    m_worldMutex.unlock();
+    std::rethrow_exception(exception);
+  }
+  return true;
+}
+
+bool FramePipeline::takeSimulationChanges()
+{
+  const bool hasSimulationChanges = m_hasSimulationChanges;
+  m_hasSimulationChanges = false;
+  return hasSimulationChanges;
+}
+
+RenderSnapshot &FramePipeline::beginSnapshot()
+{
+  RenderSnapshot &snapshot = m_snapshots[1 - m_front];
+  snapshot.clear();
+  return snapshot;
+}
+
+bool FramePipeline::recordUI(SDL_Renderer *renderer, SpriteBatcher &batcher, const std::function<void()> &drawUI)
+{
+  if (!m_renderTargetsSupported)
+  {
+    return false;
+  }
+
+  int width = 0;
+  int height = 0;
+  SDL_GetRendererOutputSize(renderer, &width, &height);
+
+  if (!m_uiLayer || m_uiLayerWidth != width || m_uiLayerHeight != height)
+  {
+    if (m_uiLayer)
+    {
+      SDL_DestroyTexture(m_uiLayer);
+    }
+    m_uiLayer = SDL_RenderTargetSupported(renderer)
+                    ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height)
+                    : nullptr;
+    if (!m_uiLayer)
+    {
+      LOG(LOG_WARNING) << "Could not create the UI layer, simulation and rendering won't overlap. SDL Error: "
+                       << SDL_GetError();
+      m_renderTargetsSupported = false;
+      return false;
+    }
+    m_uiLayerWidth = width;
+    m_uiLayerHeight = height;
+
+    // the UI is blended onto a transparent texture, so its colors are already multiplied with their alpha
+    const SDL_BlendMode premultipliedAlpha =
+        SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                   SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(m_uiLayer, premultipliedAlpha) != 0)
+    {
+      SDL_SetTextureBlendMode(m_uiLayer, SDL_BLENDMODE_BLEND);
+    }
+  }
+
+  SDL_Color drawColor;
+  SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g, &drawColor.b, &drawColor.a);
+  SDL_SetRenderTarget(renderer, m_uiLayer);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+  SDL_RenderClear(renderer);
+  SDL_SetRenderDrawColor(renderer, drawColor.r, drawColor.g, drawColor.b, drawColor.a);
+
+  drawUI();
+
+  SDL_SetRenderTarget(renderer, nullptr);
+
+  const SDL_Rect layerRect{0, 0, width, height};
+  batcher.draw(m_uiLayer, layerRect, layerRect, layerRect, SDL_Color{255, 255, 255, 255});
+  return true;
+}
@@ -0,0 +1,121 @@
+#ifndef FRAMEPIPELINE_HXX_
+#define FRAMEPIPELINE_HXX_
+
+#include <SDL.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "RenderSnapshot.hxx"
+#include "SoftwareRasterizer.hxx"
+#include "FrameTimeStats.hxx"
+
+class SpriteBatcher;
+
+/** @brief Splits the game loop into a simulation thread and the render thread
+ * The simulation thread runs the clock tasks and the gameplay. The render thread (the main thread, SDL only renders on
+ * the thread that created the renderer) handles events and records the map and the UI into a render snapshot, then
+ * draws and presents it. Both threads only change the world (the map, the UI and everything else the clock tasks touch)
+ * while they hold the world lock. Drawing and presenting a snapshot doesn't need the lock, so it overlaps with the
+ * simulation.
+ * If the simulation holds the lock when a frame starts, the render thread doesn't wait for it but keeps the last
+ * snapshot on screen, so a long simulation step doesn't block event handling. A snapshot is presented in the frame it's
+ * recorded in.
+ */
+class FramePipeline
+{
+public:
+  /// Time between the start of two simulation steps
+  static constexpr std::chrono::milliseconds simulationInterval{10};
+
+  FramePipeline() = default;
+  ~FramePipeline();
+
+  FramePipeline(const FramePipeline &) = delete;
+  FramePipeline &operator=(const FramePipeline &) = delete;
+
+  /** @brief Start calling a function on the simulation thread every simulationInterval
+   * The function is called while the world lock is held.
+   * @param step the simulation step, returns true if it might have changed what's on screen
+   */
+  void startSimulation(std::function<bool()> step);
+
+  /// Wait for the current simulation step to finish and stop the simulation thread
+  void stopSimulation();
+
+  /** @brief Lock the world for the render thread
+   * Rethrows exceptions of the simulation thread.
+   * @param wait if set to false, don't wait if the simulation holds the lock
+   * @return true if the lock has been acquired
+   */
+  bool lockWorld(bool wait);
+
+  /// Release the world lock
+  void unlockWorld() { m_worldMutex.unlock(); };
+
+  /** @brief Start recording the next snapshot
+   * @return the cleared back buffer
+   */
+  RenderSnapshot &beginSnapshot();
+
+  /** @brief Draw the UI into a layer texture and add it to the snapshot
+   * @param renderer the renderer
+   * @param batcher a batch that records into the snapshot
+   * @param drawUI draws the UI with the renderer
+   * @return false if the renderer can't draw to textures. The UI has to be drawn directly after submit() then.
+   */
+  bool recordUI(SDL_Renderer *renderer, SpriteBatcher &batcher, const std::function<void()> &drawUI);
+
+  /// Make the recorded snapshot the one that is drawn
+  void publishSnapshot() { m_front = 1 - m_front; };
+
+  /** @brief Draw the latest snapshot
+   * @param renderer the renderer
+   */
+  void submit(SDL_Renderer *renderer) const { m_snapshots[m_front].submit(renderer); };
+
+  /** @brief Draw the latest snapshot with the software rasterizer
+   * @param renderer the renderer that presents the frame
+   * @param rasterizer the rasterizer that draws the batches it has the textures of
+   */
+  void submit(SDL_Renderer *renderer, SoftwareRasterizer &rasterizer) const
+  {
+    rasterizer.submit(renderer, m_snapshots[m_front]);
+  };
+
+  /** @brief Check if a simulation step might have changed what's on screen since the last call
+   * Must only be called while the world lock is held.
+   */
+  bool takeSimulationChanges();
+
+  /// Durations of the simulation steps, must only be read while the world lock is held
+  const FrameTimeStats &getSimulationTimes() const { return m_simulationTimes; };
+
+private:
+  void runSimulation(std::function<bool()> step);
+
+  std::mutex m_worldMutex;
+  std::thread m_simulationThread;
+  std::atomic<bool> m_simulationRunning{false};
+  /// exception thrown by the simulation step, rethrown on the render thread
+  std::exception_ptr m_simulationException;
+  /// set by simulation steps that might have changed what's on screen
+  bool m_hasSimulationChanges = false;
+
+  std::array<RenderSnapshot, 2> m_snapshots;
+  /// index of the snapshot that is drawn, the other one is recorded
+  int m_front = 0;
+
+  SDL_Texture *m_uiLayer = nullptr;
+  int m_uiLayerWidth = 0;
+  int m_uiLayerHeight = 0;
+  bool m_renderTargetsSupported = true;
+
+  FrameTimeStats m_simulationTimes;
+};
+
+#endif
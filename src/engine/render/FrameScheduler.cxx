@@ -0,0 +1,63 @@
+#include "FrameScheduler.hxx"
+
+#include <algorithm>
+#include <thread>
+
+void FrameScheduler::setTargetFPS(int targetFPS)
+{
+  m_frameInterval = (targetFPS > 0) ? std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / targetFPS
+                                    : Clock::duration::zero();
+  m_scheduledStart = Clock::now();
+}
+
+double FrameScheduler::getFrameBudget() const
+{
+  return std::chrono::duration<double, std::milli>(m_frameInterval).count();
+}
+
+void FrameScheduler::endFrame(bool isRendered)
+{
+  const Clock::time_point frameEnd = Clock::now();
+
+  if (isRendered)
+  {
+    const Clock::duration frameTime = frameEnd - m_frameStart;
+    m_frameTimes.add(std::chrono::duration<double, std::milli>(frameTime).count());
+    ++m_renderedFrames;
+    if (m_frameInterval != Clock::duration::zero() && frameTime > m_frameInterval)
+    {
+      ++m_overBudgetFrames;
+    }
+  }
+  else
+  {
+    ++m_skippedFrames;
+  }
+
+  const Clock::duration interval =
+      isRendered ? m_frameInterval : std::max<Clock::duration>(m_frameInterval, idleFrameInterval);
+
+  // keep a steady cadence, but don't try to catch up after a frame that was late
+  m_scheduledStart = std::max(m_scheduledStart + interval, frameEnd);
+  waitUntil(m_scheduledStart);
+}
+
+void FrameScheduler::resetFrameCounts()
+{
+  m_renderedFrames = 0;
+  m_skippedFrames = 0;
+  m_overBudgetFrames = 0;
+}
+
+void FrameScheduler::waitUntil(Clock::time_point time)
+{
+  if (time - Clock::now() > spinDuration)
+  {
+    std::this_thread::sleep_until(time - spinDuration);
+  }
+
+  while (Clock::now() < time)
+  {
+    std::this_thread::yield();
+  }
+}
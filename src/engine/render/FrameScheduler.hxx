@@ -0,0 +1,72 @@
+#ifndef FRAMESCHEDULER_HXX_
+#define FRAMESCHEDULER_HXX_
+
+#include <chrono>
+
+#include "FrameTimeStats.hxx"
+
+/** @brief Paces the frames of the render thread and keeps statistics about their budget
+ * Frames start at a steady interval derived from the target FPS. The time between the end of a frame and the start of
+ * the next one is slept away, the last part of it is spent yielding because sleeping alone overshoots by up to a
+ * scheduler time slice. Frames that have been skipped because nothing changed are paced too, but at least with the
+ * idle frame interval, so an idle game doesn't spin even without a target FPS.
+ */
+class FrameScheduler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// Remaining time to the start of the next frame that isn't slept but yielded
+  static constexpr std::chrono::microseconds spinDuration{1500};
+  /// Minimal time between the start of two frames that haven't been rendered
+  static constexpr std::chrono::milliseconds idleFrameInterval{10};
+
+  FrameScheduler() = default;
+
+  /** @brief Set the number of frames per second to aim for
+   * @param targetFPS frames per second, 0 to start each frame as soon as the last one is done
+   */
+  void setTargetFPS(int targetFPS);
+
+  /// The time one frame may take in milliseconds, 0 without a target FPS
+  double getFrameBudget() const;
+
+  /// Start measuring the work of a frame
+  void beginFrame() { m_frameStart = Clock::now(); };
+
+  /** @brief Finish the frame and wait until the next one is due
+   * @param isRendered false if the frame has been skipped because nothing changed
+   */
+  void endFrame(bool isRendered);
+
+  /// Durations of the recent rendered frames, without the time waited for the next frame
+  const FrameTimeStats &getFrameTimes() const { return m_frameTimes; };
+
+  /// Number of rendered frames since the last resetFrameCounts()
+  int getRenderedFrames() const { return m_renderedFrames; };
+
+  /// Number of skipped frames since the last resetFrameCounts()
+  int getSkippedFrames() const { return m_skippedFrames; };
+
+  /// Number of rendered frames that took longer than the frame budget since the last resetFrameCounts()
+  int getOverBudgetFrames() const { return m_overBudgetFrames; };
+
+  /// Start counting frames from 0 again
+  void resetFrameCounts();
+
+private:
+  /// Sleep until shortly before the given time, then yield until it's reached
+  static void waitUntil(Clock::time_point time);
+
+  Clock::duration m_frameInterval = Clock::duration::zero();
+  Clock::time_point m_frameStart = Clock::now();
+  /// the time the current frame has been scheduled to start at
+  Clock::time_point m_scheduledStart = Clock::now();
+
+  FrameTimeStats m_frameTimes;
+  int m_renderedFrames = 0;
+  int m_skippedFrames = 0;
+  int m_overBudgetFrames = 0;
+};
+
+#endif
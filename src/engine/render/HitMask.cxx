@@ -0,0 +1,55 @@
+#include "HitMask.hxx"
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+#include <algorithm>
+
+HitMask::HitMask(SDL_Surface *surface, uint8_t minAlpha)
+{
+  SDL_Surface *rgbaSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+  if (!rgbaSurface)
+  {
+    throw UIError(TRACE_INFO "Could not convert surface to create a hit mask! SDL Error: " + string{SDL_GetError()});
+  }
+
+  std::vector<uint8_t> alpha(static_cast<size_t>(rgbaSurface->w) * rgbaSurface->h);
+  SDL_LockSurface(rgbaSurface);
+  for (int y = 0; y < rgbaSurface->h; ++y)
+  {
+    // SDL_PIXELFORMAT_RGBA32 stores the bytes in R, G, B, A order on every platform
+    const Uint8 *row = static_cast<const Uint8 *>(rgbaSurface->pixels) + static_cast<size_t>(y) * rgbaSurface->pitch;
+    for (int x = 0; x < rgbaSurface->w; ++x)
+    {
+      alpha[static_cast<size_t>(y) * rgbaSurface->w + x] = row[x * 4 + 3];
+    }
+  }
+  SDL_UnlockSurface(rgbaSurface);
+
+  *this = HitMask(rgbaSurface->w, rgbaSurface->h, alpha, minAlpha);
+  SDL_FreeSurface(rgbaSurface);
+}
+
+HitMask::HitMask(int width, int height, const std::vector<uint8_t> &alpha, uint8_t minAlpha)
+    : m_width(static_cast<unsigned int>(width)), m_height(static_cast<unsigned int>(height)),
+      m_wordsPerRow((static_cast<size_t>(width) + 63) / 64)
+{
+  m_bits.assign(std::max<size_t>(m_wordsPerRow * height, 1), 0);
+
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      if (alpha[static_cast<size_t>(y) * width + x] >= minAlpha)
+      {
+        setOpaque(x, y);
+      }
+    }
+  }
+}
+
+void HitMask::setOpaque(int x, int y)
+{
+  const size_t bit = static_cast<size_t>(y) * m_wordsPerRow * 64 + static_cast<size_t>(x);
+  m_bits[bit / 64] |= uint64_t{1} << (bit % 64);
+}
@@ -0,0 +1,59 @@
+#ifndef HITMASK_HXX_
+#define HITMASK_HXX_
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <vector>
+
+/** @brief Stores which pixels of a spritesheet are not transparent, using one bit per pixel
+ * The mask covers the whole spritesheet, so every frame and orientation of a tile is looked up with the same clip rect
+ * offset that is used for drawing it. Coordinates outside of the spritesheet are always transparent.
+ */
+class HitMask
+{
+public:
+  HitMask() = default;
+
+  /** @brief Create the mask from the alpha channel of a surface
+   * @param surface the spritesheet, it can have any pixel format
+   * @param minAlpha pixels with at least this alpha value are opaque
+   * @throws UIError if the surface can not be converted
+   */
+  explicit HitMask(SDL_Surface *surface, uint8_t minAlpha = 1);
+
+  /** @brief Create the mask from an alpha channel
+   * @param width width in pixels
+   * @param height height in pixels
+   * @param alpha alpha values, one byte per pixel, row by row
+   * @param minAlpha pixels with at least this alpha value are opaque
+   */
+  HitMask(int width, int height, const std::vector<uint8_t> &alpha, uint8_t minAlpha = 1);
+
+  /** @brief Check if a pixel is not transparent
+   * @param x x coordinate within the spritesheet
+   * @param y y coordinate within the spritesheet
+   */
+  bool isOpaque(int x, int y) const
+  {
+    // negative coordinates wrap around to large unsigned values, so a single comparison covers both sides
+    const bool isInside = (static_cast<unsigned int>(x) < m_width) & (static_cast<unsigned int>(y) < m_height);
+    // outside of the mask, the first bit of the first word is read and masked out
+    const size_t bit = isInside * (static_cast<size_t>(y) * m_wordsPerRow * 64 + static_cast<size_t>(x));
+    return isInside & static_cast<bool>((m_bits[bit / 64] >> (bit % 64)) & 1U);
+  }
+
+  int getWidth() const { return static_cast<int>(m_width); };
+  int getHeight() const { return static_cast<int>(m_height); };
+
+private:
+  void setOpaque(int x, int y);
+
+  unsigned int m_width = 0;
+  unsigned int m_height = 0;
+  size_t m_wordsPerRow = 0;
+  /// bits of all rows, every row starts with a new word. There is always at least one word to read from.
+  std::vector<uint64_t> m_bits = std::vector<uint64_t>(1, 0);
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include "MapDrawLists.hxx"
+
+#include "FootprintOcclusion.hxx"
+#include "SpriteBatcher.hxx"
+#include "TerrainChunkCache.hxx"
+#include "../map/MapChunks.hxx"
+#include "../map/MapGrid.hxx"
+#include "../TileManager.hxx"
+#include "../basics/Camera.hxx"
+#include "GameStates.hxx"
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+void MapDrawLists::build(Sprite *const *sprites, int spriteCount, const MapGrid &grid)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Build draw lists", MP_RED);
+#endif
+
+  for (auto &list : m_lists)
+  {
+    list.clear();
+  }
+  m_spriteCount = spriteCount;
+
+  for (int i = 0; i < spriteCount; ++i)
+  {
+    SDL_Rect nodeRect{0, 0, 0, 0};
+    const Sprite *occluder = findOccluder(grid, *sprites[i], nodeRect);
+
+    for (auto layer : allLayersOrdered)
+    {
+      Entry entry{static_cast<uint32_t>(i), sprites[i], {}, nullptr};
+      if (sprites[i]->getQuad(layer, entry.quad))
+      {
+        // sprites that reach out of their node (e.g. slopes or higher terrain) are always drawn
+        if (occluder && (occludableLayers & (1U << layer)) &&
+            FootprintOcclusion::isInsideNodeRect(entry.quad.destRect, nodeRect))
+        {
+          entry.occluder = occluder;
+        }
+        m_lists[layer].push_back(entry);
+      }
+    }
+  }
+}
+
+const Sprite *MapDrawLists::findOccluder(const MapGrid &grid, const Sprite &sprite, SDL_Rect &nodeRect)
+{
+  const Point &coordinates = sprite.isoCoordinates;
+  const int originIndex = grid.origCornerIndex(Layer::BUILDINGS, grid.nodeIdx(coordinates.x, coordinates.y));
+  if (originIndex < 0)
+  {
+    return nullptr;
+  }
+
+  const Sprite &building = grid.sprite(originIndex);
+  SpriteQuad buildingQuad;
+  if (!building.getQuad(Layer::BUILDINGS, buildingQuad))
+  {
+    return nullptr;
+  }
+
+  const FootprintOcclusion::Coverage *coverage =
+      TileManager::instance().getFootprintCoverage(grid.tileId(Layer::BUILDINGS, originIndex), buildingQuad.srcRect.x);
+  const Point origin = grid.coordinates(originIndex);
+  const int i = origin.x - coordinates.x;
+  const int j = coordinates.y - origin.y;
+
+  if (!coverage || i < 0 || j < 0 || i >= FootprintOcclusion::maxFootprintSize ||
+      j >= FootprintOcclusion::maxFootprintSize || !coverage->test(FootprintOcclusion::coverageBit(i, j)))
+  {
+    return nullptr;
+  }
+
+  nodeRect = FootprintOcclusion::nodeRect(buildingQuad.destRect, i, j, Camera::instance().zoomLevel());
+  return &building;
+}
+
+int MapDrawLists::draw(SpriteBatcher &batcher, unsigned int activeLayers, const TerrainChunkCache *terrainCache,
+                       const MapChunks &chunks) const
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Draw lists", MP_RED);
+#endif
+
+  struct ListCursor
+  {
+    const Entry *pEntry;
+    const Entry *pEnd;
+    Layer layer;
+    bool isDimmed;
+    bool isCached;
+  };
+
+  const bool isBlueprintMode = GameStates::instance().layerEditMode == LayerEditMode::BLUEPRINT;
+  // buildings only hide what's below them if they're drawn opaque
+  const bool isOcclusionEnabled = (activeLayers & (1U << Layer::BUILDINGS)) && !isBlueprintMode;
+  int occludedQuads = 0;
+  std::array<ListCursor, LAYERS_COUNT> cursors;
+  size_t cursorCount = 0;
+
+  for (auto layer : allLayersOrdered)
+  {
+    const std::vector<Entry> &list = m_lists[layer];
+    if ((activeLayers & (1U << layer)) && !list.empty())
+    {
+      cursors[cursorCount++] = {list.data(), list.data() + list.size(), layer,
+                                isBlueprintMode && layer != Layer::BLUEPRINT && layer != Layer::UNDERGROUND,
+                                terrainCache && (TerrainChunkCache::cachedLayers & (1U << layer))};
+    }
+  }
+
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+
+  // every list holds at most one quad per sprite
+  for (uint32_t order = 0; order < static_cast<uint32_t>(m_spriteCount); ++order)
+  {
+    for (size_t i = 0; i < cursorCount; ++i)
+    {
+      ListCursor &cursor = cursors[i];
+      if (cursor.pEntry == cursor.pEnd || cursor.pEntry->order != order)
+      {
+        continue;
+      }
+
+      const Entry &entry = *cursor.pEntry++;
+      const Sprite &sprite = *entry.sprite;
+
+      if (isOcclusionEnabled && entry.occluder &&
+          entry.occluder->getSpriteTransparencyFactor(Layer::BUILDINGS) == SDL_ALPHA_OPAQUE)
+      {
+        ++occludedQuads;
+        continue;
+      }
+
+      if (cursor.isCached && !sprite.highlightSprite &&
+          terrainCache->isChunkCached(chunks.chunkIdx(sprite.isoCoordinates.x, sprite.isoCoordinates.y)))
+      {
+        continue;
+      }
+
+      SDL_Color color{255, 255, 255, cursor.isDimmed ? Uint8{80} : sprite.getSpriteTransparencyFactor(cursor.layer)};
+      if (sprite.highlightSprite)
+      {
+        color.r = sprite.highlightColor.r;
+        color.g = sprite.highlightColor.g;
+        color.b = sprite.highlightColor.b;
+      }
+
+      const SDL_Rect destRect{entry.quad.destRect.x - cameraOffset.x, entry.quad.destRect.y - cameraOffset.y,
+                              entry.quad.destRect.w, entry.quad.destRect.h};
+      batcher.draw(entry.quad.texture, entry.quad.bounds, entry.quad.srcRect, destRect, color);
+    }
+  }
+
+  return occludedQuads;
+}
@@ -0,0 +1,78 @@
+#ifndef MAPDRAWLISTS_HXX_
+#define MAPDRAWLISTS_HXX_
+
+#include <SDL.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../Sprite.hxx"
+#include "../common/enums.hxx"
+
+class MapChunks;
+class MapGrid;
+class SpriteBatcher;
+class TerrainChunkCache;
+
+/** @brief Holds the quads of the visible map nodes in one list per layer
+ * The lists are built when the visible area or the sprites change, so drawing a frame doesn't need to look at the layers
+ * of every sprite. Disabled layers, blueprint mode and the terrain cache are handled once per list.
+ * Highlighting and transparency change without a refresh, so they're read from the sprites while drawing.
+ * Quads of the lower layers that are completely hidden behind a building remember the building's sprite. They're skipped
+ * while the building is drawn opaque.
+ */
+class MapDrawLists
+{
+public:
+  struct Entry
+  {
+    /// position of the sprite in drawing order, quads of all lists are drawn in this order
+    uint32_t order;
+    const Sprite *sprite;
+    SpriteQuad quad;
+    /// the sprite of the building that covers this quad, nullptr if it's not covered
+    const Sprite *occluder;
+  };
+
+  /// Layers that are drawn below buildings and can be hidden by them
+  static constexpr unsigned int occludableLayers = (1U << Layer::TERRAIN) | (1U << Layer::WATER) |
+                                                   (1U << Layer::GROUND_DECORATION) | (1U << Layer::ZONE) |
+                                                   (1U << Layer::ROAD);
+
+  /** @brief Rebuild all lists
+   * @param sprites the visible sprites in drawing order
+   * @param spriteCount number of visible sprites
+   * @param grid the grid that holds the sprites, to look up the buildings that cover a node
+   */
+  void build(Sprite *const *sprites, int spriteCount, const MapGrid &grid);
+
+  /** @brief Add the quads of all active layers to a batch
+   * The quads of each sprite are drawn in the order of allLayersOrdered, the sprites are drawn in the order of the
+   * visible sprites.
+   * @param batcher the batch to add the quads to
+   * @param activeLayers bitmask of the layers that are drawn
+   * @param terrainCache if set, cached layers of cached chunks are skipped unless the sprite is highlighted
+   * @param chunks the chunks of the map, to look up if a sprite's chunk is cached
+   * @return the number of quads that have been skipped because a building covers them
+   */
+  int draw(SpriteBatcher &batcher, unsigned int activeLayers, const TerrainChunkCache *terrainCache,
+           const MapChunks &chunks) const;
+
+  /// Get the list of a layer
+  const std::vector<Entry> &getList(Layer layer) const { return m_lists[layer]; };
+
+private:
+  /** @brief Find the building that covers the lower layers of a node
+   * @param grid the grid that holds the sprites
+   * @param sprite the sprite of the node
+   * @param nodeRect is set to the rect of the node in world coordinates, the covered quads must lie within it
+   * @return the sprite of the building or nullptr if the node isn't covered
+   */
+  static const Sprite *findOccluder(const MapGrid &grid, const Sprite &sprite, SDL_Rect &nodeRect);
+
+  std::array<std::vector<Entry>, LAYERS_COUNT> m_lists;
+  int m_spriteCount = 0;
+};
+
+#endif
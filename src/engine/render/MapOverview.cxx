@@ -0,0 +1,213 @@
+#include "MapOverview.hxx"
+
+#include "../map/MapChunks.hxx"
+#include "../map/MapGrid.hxx"
+#include "../TileManager.hxx"
+#include "../basics/Camera.hxx"
+#include "LOG.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+MapOverview::~MapOverview() { clear(); }
+
+SDL_Color MapOverview::averageColor(SDL_Surface *surface)
+{
+  SDL_Surface *rgbaSurface = surface ? SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0) : nullptr;
+  if (!rgbaSurface)
+  {
+    return {0, 0, 0, SDL_ALPHA_TRANSPARENT};
+  }
+
+  uint64_t red = 0;
+  uint64_t green = 0;
+  uint64_t blue = 0;
+  uint64_t alpha = 0;
+  SDL_LockSurface(rgbaSurface);
+  for (int y = 0; y < rgbaSurface->h; ++y)
+  {
+    // SDL_PIXELFORMAT_RGBA32 stores the bytes in R, G, B, A order on every platform
+    const Uint8 *row = static_cast<const Uint8 *>(rgbaSurface->pixels) + static_cast<size_t>(y) * rgbaSurface->pitch;
+    for (int x = 0; x < rgbaSurface->w; ++x)
+    {
+      const Uint8 *pixel = row + x * 4;
+      red += pixel[0] * pixel[3];
+      green += pixel[1] * pixel[3];
+      blue += pixel[2] * pixel[3];
+      alpha += pixel[3];
+    }
+  }
+  SDL_UnlockSurface(rgbaSurface);
+  SDL_FreeSurface(rgbaSurface);
+
+  if (alpha == 0)
+  {
+    return {0, 0, 0, SDL_ALPHA_TRANSPARENT};
+  }
+  return {static_cast<Uint8>(red / alpha), static_cast<Uint8>(green / alpha), static_cast<Uint8>(blue / alpha),
+          SDL_ALPHA_OPAQUE};
+}
+
+void MapOverview::update(SDL_Renderer *renderer, const MapChunks &chunks, const MapGrid &grid, unsigned int activeLayers)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Update map overview", MP_YELLOW);
+#endif
+
+  if (m_textureTooBig)
+  {
+    return;
+  }
+
+  const size_t chunkCount = static_cast<size_t>(chunks.chunksX()) * chunks.chunksY();
+  if (!m_texture || m_columns != grid.columns() || m_chunkRevisions.size() != chunkCount)
+  {
+    clear();
+    m_columns = grid.columns();
+    m_width = (grid.columns() + grid.rows() - 1) + nodeWidth - 1;
+    m_height = grid.columns() + grid.rows() - 1;
+
+    SDL_RendererInfo rendererInfo;
+    if (SDL_GetRendererInfo(renderer, &rendererInfo) == 0 && rendererInfo.max_texture_width > 0 &&
+        (m_width > rendererInfo.max_texture_width || m_height > rendererInfo.max_texture_height))
+    {
+      LOG(LOG_WARNING) << "The map is too big for an overview texture, it will always be drawn with sprites";
+      m_textureTooBig = true;
+      return;
+    }
+
+    m_texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, m_width, m_height);
+    if (!m_texture)
+    {
+      LOG(LOG_WARNING) << "Could not create a map overview texture of " << m_width << "x" << m_height
+                       << " pixels! SDL Error: " << SDL_GetError();
+      m_textureTooBig = true;
+      return;
+    }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+
+    m_pixels.assign(static_cast<size_t>(m_width) * m_height * 4, 0);
+    m_chunkRevisions.assign(chunkCount, 0);
+  }
+
+  if (m_layers != activeLayers)
+  {
+    m_layers = activeLayers;
+    m_outdated = true;
+  }
+
+  SDL_Rect dirtyRect{0, 0, 0, 0};
+  for (int chunkIdx = 0; chunkIdx < static_cast<int>(chunkCount); ++chunkIdx)
+  {
+    if (m_outdated || m_chunkRevisions[chunkIdx] != chunks.chunk(chunkIdx).revision)
+    {
+      bakeChunk(chunks, chunkIdx, grid, dirtyRect);
+      m_chunkRevisions[chunkIdx] = chunks.chunk(chunkIdx).revision;
+    }
+  }
+  m_outdated = false;
+
+  if (!SDL_RectEmpty(&dirtyRect))
+  {
+    const size_t pitch = static_cast<size_t>(m_width) * 4;
+    SDL_UpdateTexture(m_texture, &dirtyRect, &m_pixels[dirtyRect.y * pitch + dirtyRect.x * 4], static_cast<int>(pitch));
+  }
+}
+
+void MapOverview::bakeChunk(const MapChunks &chunks, int chunkIdx, const MapGrid &grid, SDL_Rect &dirtyRect)
+{
+  const MapChunk &chunk = chunks.chunk(chunkIdx);
+  const TileManager &tileManager = TileManager::instance();
+
+  for (int x = chunk.firstX; x <= chunk.lastX; ++x)
+  {
+    for (int y = chunk.firstY; y <= chunk.lastY; ++y)
+    {
+      const int nodeIdx = grid.nodeIdx(x, y);
+      SDL_Color color{0, 0, 0, SDL_ALPHA_TRANSPARENT};
+
+      // the top-most active layer is visible from far away
+      for (auto it = std::rbegin(allLayersOrdered); it != std::rend(allLayersOrdered); ++it)
+      {
+        const TileId tileId = grid.tileId(*it, nodeIdx);
+        if ((m_layers & (1U << *it)) && tileId != EMPTY_TILE_ID && tileManager.getOverviewColor(tileId).a != 0)
+        {
+          color = tileManager.getOverviewColor(tileId);
+          break;
+        }
+      }
+
+      const SDL_Point pixel = nodePixel(x, y, m_columns);
+      uint8_t *dest = &m_pixels[(static_cast<size_t>(pixel.y) * m_width + pixel.x) * 4];
+      for (int i = 0; i < nodeWidth; ++i, dest += 4)
+      {
+        dest[0] = color.r;
+        dest[1] = color.g;
+        dest[2] = color.b;
+        dest[3] = color.a;
+      }
+    }
+  }
+
+  // the nodes of a chunk form a diamond in the image, upload its bounding box
+  const SDL_Point left = nodePixel(chunk.firstX, chunk.firstY, m_columns);
+  const SDL_Point right = nodePixel(chunk.lastX, chunk.lastY, m_columns);
+  const SDL_Point top = nodePixel(chunk.firstX, chunk.lastY, m_columns);
+  const SDL_Point bottom = nodePixel(chunk.lastX, chunk.firstY, m_columns);
+  const SDL_Rect chunkRect{left.x, top.y, right.x - left.x + nodeWidth, bottom.y - top.y + 1};
+
+  if (SDL_RectEmpty(&dirtyRect))
+  {
+    dirtyRect = chunkRect;
+  }
+  else
+  {
+    SDL_UnionRect(&dirtyRect, &chunkRect, &dirtyRect);
+  }
+}
+
+void MapOverview::draw(SpriteBatcher &batcher) const
+{
+  if (!m_texture)
+  {
+    return;
+  }
+
+  const double zoomLevel = Camera::instance().zoomLevel();
+  const SDL_Point &tileSize = Camera::instance().tileSize();
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+
+  // a pixel is half a tile wide and half a tile high. The left pixel of node (0, 0) starts half a tile left of the node's
+  // screen coordinates, and the rows are centered on the tiles' diamonds, which sit at the bottom of the sprites.
+  const double pixelWidth = tileSize.x / 2.0;
+  const double pixelHeight = tileSize.y / 2.0;
+  const double left = -pixelWidth;
+  const double top = -(m_columns - 1) * pixelHeight - 1.5 * pixelHeight;
+
+  const SDL_Rect textureRect{0, 0, m_width, m_height};
+  const SDL_Rect destRect{static_cast<int>(std::round(left * zoomLevel)) - cameraOffset.x,
+                          static_cast<int>(std::round(top * zoomLevel)) - cameraOffset.y,
+                          static_cast<int>(std::round(m_width * pixelWidth * zoomLevel)),
+                          static_cast<int>(std::round(m_height * pixelHeight * zoomLevel))};
+  batcher.draw(m_texture, textureRect, textureRect, destRect, SDL_Color{255, 255, 255, 255});
+}
+
+void MapOverview::clear()
+{
+  if (m_texture)
+  {
+    SDL_DestroyTexture(m_texture);
+    m_texture = nullptr;
+  }
+  m_pixels.clear();
+  m_chunkRevisions.clear();
+  m_width = 0;
+  m_height = 0;
+  m_columns = 0;
+  m_outdated = true;
+}
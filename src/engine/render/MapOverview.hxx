@@ -0,0 +1,80 @@
+#ifndef MAPOVERVIEW_HXX_
+#define MAPOVERVIEW_HXX_
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+#include "SpriteBatcher.hxx"
+
+class MapChunks;
+class MapGrid;
+
+/** @brief A low detail image of the whole map that is drawn instead of the sprites when zoomed far out
+ * Every node is baked into nodeWidth x 1 pixels with the color of its top-most active layer. The pixels are laid out like
+ * the isometric map, so the nodes of neighboring rows interlock without gaps and the image can simply be scaled to the
+ * screen. Chunks whose revision changed are baked again, the rest of the image is kept. Heights are not taken into account.
+ */
+class MapOverview
+{
+public:
+  /// Number of pixels per node in x direction, nodes are one pixel high
+  static constexpr int nodeWidth = 2;
+
+  MapOverview() = default;
+  ~MapOverview();
+
+  MapOverview(const MapOverview &) = delete;
+  MapOverview &operator=(const MapOverview &) = delete;
+
+  /** @brief Get the average color of the non-transparent pixels of a surface
+   * @param surface the surface, e.g. a tile spritesheet
+   * @return the average color weighted by alpha, transparent if the surface has no visible pixels
+   */
+  static SDL_Color averageColor(SDL_Surface *surface);
+
+  /** @brief Get the left pixel of a node in the overview image
+   * @param x x coordinate of the node
+   * @param y y coordinate of the node
+   * @param columns number of columns of the map
+   */
+  static SDL_Point nodePixel(int x, int y, int columns) { return {x + y, x - y + columns - 1}; };
+
+  /** @brief Bake all chunks that changed since the last update into the image
+   * @param renderer the renderer the overview texture is created with
+   * @param chunks the chunks of the map
+   * @param grid the grid that holds the tiles of the nodes
+   * @param activeLayers bitmask of the layers that are currently drawn
+   */
+  void update(SDL_Renderer *renderer, const MapChunks &chunks, const MapGrid &grid, unsigned int activeLayers);
+
+  /** @brief Draw the overview scaled to the current zoom level
+   * @param batcher the batch to add the overview to
+   */
+  void draw(SpriteBatcher &batcher) const;
+
+  /// Check if the overview can be drawn. It can't if the map is too big for a single texture.
+  bool isAvailable() const { return m_texture != nullptr; };
+
+  /// Release the texture and the image
+  void clear();
+
+private:
+  /// Bake the nodes of a chunk into the image and extend the rect that has to be uploaded
+  void bakeChunk(const MapChunks &chunks, int chunkIdx, const MapGrid &grid, SDL_Rect &dirtyRect);
+
+  SDL_Texture *m_texture = nullptr;
+  int m_width = 0;
+  int m_height = 0;
+  int m_columns = 0;
+  /// RGBA32 pixels of the image
+  std::vector<uint8_t> m_pixels;
+  /// revisions of the chunks when they were baked
+  std::vector<unsigned int> m_chunkRevisions;
+  unsigned int m_layers = 0;
+  /// set if the whole image has to be baked again
+  bool m_outdated = true;
+  bool m_textureTooBig = false;
+};
+
+#endif
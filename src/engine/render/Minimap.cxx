@@ -0,0 +1,194 @@
+#include "Minimap.hxx"
+
+#include "../Map.hxx"
+#include "../map/MapGrid.hxx"
+#include "../TileManager.hxx"
+#include "SpriteBatcher.hxx"
+#include "../basics/Settings.hxx"
+#include "LOG.hxx"
+
+#include <algorithm>
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+/// terrain at height 0 is darkened by this factor, the highest terrain keeps its color
+static constexpr float lowestTerrainBrightness = 0.6F;
+
+Minimap::Minimap(const MapGrid &grid) : m_grid(grid), m_firstDirtyRow(grid.rows())
+{
+  m_pixels.assign(static_cast<size_t>(grid.nodeCount()) * 4, 0);
+  for (auto &colors : m_groupColors)
+  {
+    colors.assign(grid.nodeCount(), SDL_Color{0, 0, 0, SDL_ALPHA_TRANSPARENT});
+  }
+  m_dirtyMarks.resize(grid.nodeCount());
+}
+
+Minimap::~Minimap()
+{
+  if (m_texture)
+  {
+    SDL_DestroyTexture(m_texture);
+  }
+}
+
+void Minimap::subscribe(Map &map)
+{
+  map.registerCbChangeTile([this](const MapNode &mapNode) { markNodeDirty(mapNode.getIndex()); });
+  map.registerCbDemolish([this](const MapNode *mapNode) { markNodeDirty(mapNode->getIndex()); });
+  map.registerCbChangeHeight(
+      [this](const MapNode &mapNode)
+      {
+        // changing the height of a node demolishes the zones around it
+        const int x = mapNode.getIndex() / m_grid.columns();
+        const int y = mapNode.getIndex() % m_grid.columns();
+        for (int neighborX = std::max(x - 1, 0); neighborX <= std::min(x + 1, m_grid.rows() - 1); ++neighborX)
+        {
+          for (int neighborY = std::max(y - 1, 0); neighborY <= std::min(y + 1, m_grid.columns() - 1); ++neighborY)
+          {
+            markNodeDirty(m_grid.nodeIdx(neighborX, neighborY));
+          }
+        }
+      });
+}
+
+void Minimap::markNodeDirty(int nodeIdx)
+{
+  if (!m_allDirty && m_dirtyMarks.tryMark(nodeIdx))
+  {
+    m_dirtyNodes.push_back(nodeIdx);
+  }
+}
+
+void Minimap::setLayers(unsigned int layers)
+{
+  layers &= selectableLayers;
+  if (layers == m_layers)
+  {
+    return;
+  }
+  m_layers = layers;
+
+  for (int nodeIdx = 0; nodeIdx < m_grid.nodeCount(); ++nodeIdx)
+  {
+    composeNode(nodeIdx);
+  }
+  m_firstDirtyRow = 0;
+  m_lastDirtyRow = m_grid.rows() - 1;
+}
+
+void Minimap::markRowDirty(int row)
+{
+  m_firstDirtyRow = std::min(m_firstDirtyRow, row);
+  m_lastDirtyRow = std::max(m_lastDirtyRow, row);
+}
+
+void Minimap::update(SDL_Renderer *renderer)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Update minimap", MP_YELLOW);
+#endif
+
+  if (m_allDirty)
+  {
+    for (int nodeIdx = 0; nodeIdx < m_grid.nodeCount(); ++nodeIdx)
+    {
+      colorNode(nodeIdx);
+      composeNode(nodeIdx);
+    }
+    m_firstDirtyRow = 0;
+    m_lastDirtyRow = m_grid.rows() - 1;
+    m_allDirty = false;
+  }
+  else
+  {
+    for (int nodeIdx : m_dirtyNodes)
+    {
+      colorNode(nodeIdx);
+      composeNode(nodeIdx);
+      markRowDirty(nodeIdx / m_grid.columns());
+    }
+  }
+  m_dirtyNodes.clear();
+  m_dirtyMarks.nextEpoch();
+
+  if (!m_texture && renderer)
+  {
+    m_texture =
+        SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, m_grid.columns(), m_grid.rows());
+    if (!m_texture)
+    {
+      LOG(LOG_WARNING) << "Could not create the minimap texture! SDL Error: " << SDL_GetError();
+      return;
+    }
+    SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+    m_firstDirtyRow = 0;
+    m_lastDirtyRow = m_grid.rows() - 1;
+  }
+
+  if (m_texture && m_firstDirtyRow <= m_lastDirtyRow)
+  {
+    const int pitch = m_grid.columns() * 4;
+    const SDL_Rect rows{0, m_firstDirtyRow, m_grid.columns(), m_lastDirtyRow - m_firstDirtyRow + 1};
+    SDL_UpdateTexture(m_texture, &rows, &m_pixels[static_cast<size_t>(m_firstDirtyRow) * pitch], pitch);
+    m_firstDirtyRow = m_grid.rows();
+    m_lastDirtyRow = -1;
+  }
+}
+
+void Minimap::draw(SpriteBatcher &batcher, const SDL_Rect &destRect) const
+{
+  const SDL_Rect textureRect{0, 0, m_grid.columns(), m_grid.rows()};
+  batcher.draw(m_texture, textureRect, textureRect, destRect, SDL_Color{255, 255, 255, 255});
+}
+
+void Minimap::colorNode(int nodeIdx)
+{
+  const TileManager &tileManager = TileManager::instance();
+
+  const TileId waterTileId = m_grid.tileId(Layer::WATER, nodeIdx);
+  SDL_Color terrainColor = tileManager.getOverviewColor(waterTileId);
+  if (waterTileId == EMPTY_TILE_ID || terrainColor.a == 0)
+  {
+    terrainColor = tileManager.getOverviewColor(m_grid.tileId(Layer::TERRAIN, nodeIdx));
+
+    // higher terrain is brighter, so the minimap shows the relief
+    const int maxHeight = std::max(Settings::instance().maxElevationHeight, 1);
+    const float brightness =
+        lowestTerrainBrightness + (1.0F - lowestTerrainBrightness) * std::min(static_cast<int>(m_grid.height(nodeIdx)), maxHeight) / maxHeight;
+    terrainColor.r = static_cast<Uint8>(terrainColor.r * brightness);
+    terrainColor.g = static_cast<Uint8>(terrainColor.g * brightness);
+    terrainColor.b = static_cast<Uint8>(terrainColor.b * brightness);
+  }
+
+  m_groupColors[GROUP_TERRAIN][nodeIdx] = terrainColor;
+  m_groupColors[GROUP_ZONES][nodeIdx] = tileManager.getOverviewColor(m_grid.tileId(Layer::ZONE, nodeIdx));
+  m_groupColors[GROUP_ROADS][nodeIdx] = tileManager.getOverviewColor(m_grid.tileId(Layer::ROAD, nodeIdx));
+}
+
+void Minimap::composeNode(int nodeIdx)
+{
+  SDL_Color color{0, 0, 0, SDL_ALPHA_TRANSPARENT};
+
+  // roads are drawn above zones, zones above the terrain
+  if ((m_layers & (1U << Layer::ROAD)) && m_groupColors[GROUP_ROADS][nodeIdx].a != 0)
+  {
+    color = m_groupColors[GROUP_ROADS][nodeIdx];
+  }
+  else if ((m_layers & (1U << Layer::ZONE)) && m_groupColors[GROUP_ZONES][nodeIdx].a != 0)
+  {
+    color = m_groupColors[GROUP_ZONES][nodeIdx];
+  }
+  else if (m_layers & ((1U << Layer::TERRAIN) | (1U << Layer::WATER)))
+  {
+    color = m_groupColors[GROUP_TERRAIN][nodeIdx];
+  }
+
+  uint8_t *dest = &m_pixels[static_cast<size_t>(nodeIdx) * 4];
+  dest[0] = color.r;
+  dest[1] = color.g;
+  dest[2] = color.b;
+  dest[3] = color.a;
+}
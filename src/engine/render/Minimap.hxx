@@ -0,0 +1,103 @@
+#ifndef MINIMAP_HXX_
+#define MINIMAP_HXX_
+
+#include <SDL.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../common/enums.hxx"
+#include "../map/NodeMarks.hxx"
+
+class Map;
+class MapGrid;
+class SpriteBatcher;
+
+/** @brief A top-down image of the map with one pixel per node
+ * The minimap keeps the color of every node for each of its layer groups (terrain, zones, roads) in a CPU buffer and
+ * listens to the map's signals to recolor only the nodes that changed. Only the rows of the image that contain changed
+ * nodes are uploaded to the texture. Selecting other layers only recomposes the cached colors.
+ * Pixel (y, x) shows node (x, y), so the pixel index equals the node index.
+ */
+class Minimap
+{
+public:
+  /// Bitmask of the map layers the minimap can show, water is shown together with the terrain
+  static constexpr unsigned int selectableLayers =
+      (1U << Layer::TERRAIN) | (1U << Layer::WATER) | (1U << Layer::ZONE) | (1U << Layer::ROAD);
+
+  explicit Minimap(const MapGrid &grid);
+  ~Minimap();
+
+  Minimap(const Minimap &) = delete;
+  Minimap &operator=(const Minimap &) = delete;
+
+  /** @brief Recolor nodes when tiles are placed or demolished or heights change
+   * @param map the map that owns the grid of the minimap
+   */
+  void subscribe(Map &map);
+
+  /** @brief Recolor a node with the next update
+   * @param nodeIdx index of the node
+   */
+  void markNodeDirty(int nodeIdx);
+
+  /// Recolor all nodes with the next update
+  void markAllDirty() { m_allDirty = true; };
+
+  /// Only recolor the nodes that are marked dirty from now on, e.g. while the nodes are still being loaded
+  void markAllClean() { m_allDirty = false; };
+
+  /** @brief Select the layers the minimap shows
+   * @param layers bitmask of map layers, layers that are not selectable are ignored
+   */
+  void setLayers(unsigned int layers);
+
+  /// Get the bitmask of the layers the minimap shows
+  unsigned int getLayers() const { return m_layers; };
+
+  /** @brief Recolor all dirty nodes and upload the changed rows
+   * @param renderer the renderer the minimap texture is created with
+   */
+  void update(SDL_Renderer *renderer);
+
+  /** @brief Draw the minimap
+   * @param batcher the batch to add the minimap to
+   * @param destRect the rect the minimap is scaled to
+   */
+  void draw(SpriteBatcher &batcher, const SDL_Rect &destRect) const;
+
+  /// Get the pixel of a node, in R, G, B, A order
+  const uint8_t *pixel(int nodeIdx) const { return &m_pixels[static_cast<size_t>(nodeIdx) * 4]; };
+
+private:
+  enum LayerGroup
+  {
+    GROUP_TERRAIN,
+    GROUP_ZONES,
+    GROUP_ROADS,
+    GROUP_COUNT
+  };
+
+  /// Look up the colors of all layer groups of a node
+  void colorNode(int nodeIdx);
+  /// Combine the cached colors of the selected layer groups into the pixel of a node
+  void composeNode(int nodeIdx);
+  void markRowDirty(int row);
+
+  const MapGrid &m_grid;
+  SDL_Texture *m_texture = nullptr;
+  /// RGBA32 pixels of the image
+  std::vector<uint8_t> m_pixels;
+  /// colors of the nodes per layer group
+  std::array<std::vector<SDL_Color>, GROUP_COUNT> m_groupColors;
+  NodeMarks m_dirtyMarks;
+  std::vector<int> m_dirtyNodes;
+  /// rows that have to be uploaded, firstDirtyRow > lastDirtyRow if there are none
+  int m_firstDirtyRow;
+  int m_lastDirtyRow = -1;
+  unsigned int m_layers = selectableLayers;
+  bool m_allDirty = true;
+};
+
+#endif
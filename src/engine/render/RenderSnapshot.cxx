@@ -0,0 +1,45 @@
+#include "RenderSnapshot.hxx"
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+void RenderSnapshot::clear()
+{
+  m_batches.clear();
+  m_vertices.clear();
+  m_damage.invalidate();
+}
+
+void RenderSnapshot::addBatch(SDL_Texture *texture, const SDL_Vertex *vertices, size_t vertexCount)
+{
+  if (vertexCount == 0)
+  {
+    return;
+  }
+
+  m_batches.push_back({texture, m_vertices.size(), vertexCount});
+  m_vertices.insert(m_vertices.end(), vertices, vertices + vertexCount);
+
+  const size_t quads = vertexCount / 4;
+  while (m_indices.size() < quads * 6)
+  {
+    const int firstVertex = static_cast<int>(m_indices.size() / 6 * 4);
+    m_indices.insert(m_indices.end(),
+                     {firstVertex, firstVertex + 1, firstVertex + 2, firstVertex + 2, firstVertex + 3, firstVertex});
+  }
+}
+
+void RenderSnapshot::submit(SDL_Renderer *renderer, size_t firstBatch) const
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Submit render snapshot", MP_RED);
+#endif
+
+  for (size_t i = firstBatch; i < m_batches.size(); ++i)
+  {
+    const Batch &batch = m_batches[i];
+    SDL_RenderGeometry(renderer, batch.texture, &m_vertices[batch.firstVertex], static_cast<int>(batch.vertexCount),
+                       m_indices.data(), static_cast<int>(batch.vertexCount / 4 * 6));
+  }
+}
@@ -0,0 +1,83 @@
+#ifndef RENDERSNAPSHOT_HXX_
+#define RENDERSNAPSHOT_HXX_
+
+#include <SDL.h>
+#include <vector>
+
+#include "DamageRegion.hxx"
+
+/** @brief The geometry of a frame, recorded so it can be drawn again without looking at the map or the UI
+ * A snapshot holds batches of textured quads in screen coordinates, like the SpriteBatcher submits them. Once it has been
+ * recorded it isn't changed anymore until it is cleared for the next frame, so it can be drawn while the map is changed.
+ * The textures must stay valid as long as the snapshot is drawn.
+ * The damage region tells which parts of the screen look different than in the snapshot recorded before. Unless the
+ * recorder narrows it down, the whole screen is damaged.
+ */
+class RenderSnapshot
+{
+public:
+  RenderSnapshot() { m_damage.invalidate(); };
+
+  /// Remove all batches and damage the whole screen, keeping the allocated memory
+  void clear();
+
+  /** @brief Add a batch of quads
+   * @param texture the texture of all quads
+   * @param vertices four vertices per quad
+   * @param vertexCount number of vertices, a multiple of four
+   */
+  void addBatch(SDL_Texture *texture, const SDL_Vertex *vertices, size_t vertexCount);
+
+  /** @brief Draw all batches in the order they have been added
+   * @param renderer the renderer to draw with
+   */
+  void submit(SDL_Renderer *renderer) const { submit(renderer, 0); };
+
+  /** @brief Draw the batches from the given one on in the order they have been added
+   * @param renderer the renderer to draw with
+   * @param firstBatch index of the first batch to draw, the ones before it have been drawn in another way
+   */
+  void submit(SDL_Renderer *renderer, size_t firstBatch) const;
+
+  /// Check if the snapshot holds any quads
+  bool isEmpty() const { return m_batches.empty(); };
+
+  /// Number of batches, every batch is drawn with a single draw call
+  size_t getBatchCount() const { return m_batches.size(); };
+
+  /// The parts of the screen that changed since the last snapshot
+  DamageRegion &getDamage() { return m_damage; };
+  const DamageRegion &getDamage() const { return m_damage; };
+
+  /// The texture and the quads of a batch
+  struct BatchGeometry
+  {
+    SDL_Texture *texture;
+    /// four vertices per quad, top left, top right, bottom right and bottom left
+    const SDL_Vertex *vertices;
+    size_t vertexCount;
+  };
+
+  /// Get the geometry of a batch, it's valid until the snapshot is cleared
+  BatchGeometry getBatch(size_t index) const
+  {
+    const Batch &batch = m_batches[index];
+    return {batch.texture, &m_vertices[batch.firstVertex], batch.vertexCount};
+  };
+
+private:
+  struct Batch
+  {
+    SDL_Texture *texture;
+    size_t firstVertex;
+    size_t vertexCount;
+  };
+
+  std::vector<Batch> m_batches;
+  std::vector<SDL_Vertex> m_vertices;
+  /// all quads share the same index pattern, the indices of the biggest batch are kept
+  std::vector<int> m_indices;
+  DamageRegion m_damage;
+};
+
+#endif
@@ -0,0 +1,332 @@
+#include "SoftwareRasterizer.hxx"
+#include "RenderSnapshot.hxx"
+#include "TextureAtlas.hxx"
+
+#include "LOG.hxx"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SOFTWARERASTERIZER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+namespace
+{
+constexpr uint32_t opaqueAlpha = 0xFF000000;
+
+/// x / 255, rounded to the nearest integer for 0 <= x <= 255 * 255
+inline uint32_t div255(uint32_t x)
+{
+  x += 128;
+  return (x + (x >> 8)) >> 8;
+}
+
+inline uint32_t blendPixel(uint32_t dest, uint32_t texel, SDL_Color color)
+{
+  const uint32_t alpha = div255((texel >> 24) * color.a);
+  if (alpha == 0)
+  {
+    return dest;
+  }
+
+  uint32_t result = opaqueAlpha;
+  const uint32_t modulation[3] = {color.b, color.g, color.r};
+  for (int channel = 0; channel < 3; ++channel)
+  {
+    const int shift = channel * 8;
+    const uint32_t source = div255(((texel >> shift) & 0xFF) * modulation[channel]);
+    const uint32_t destination = (dest >> shift) & 0xFF;
+    result |= div255(source * alpha + destination * (255 - alpha)) << shift;
+  }
+  return result;
+}
+
+#ifdef SOFTWARERASTERIZER_SSE2
+/// div255() for eight 16 bit lanes
+inline __m128i div255(__m128i x)
+{
+  x = _mm_add_epi16(x, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/// blendPixel() for two pixels with their channels widened to 16 bit
+inline __m128i blendPixels(__m128i dest, __m128i texels, __m128i modulation)
+{
+  const __m128i source = div255(_mm_mullo_epi16(texels, modulation));
+  const __m128i alpha =
+      _mm_shufflehi_epi16(_mm_shufflelo_epi16(source, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+  const __m128i inverseAlpha = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+  return div255(_mm_add_epi16(_mm_mullo_epi16(source, alpha), _mm_mullo_epi16(dest, inverseAlpha)));
+}
+#endif
+} // namespace
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+  if (m_frameTexture)
+  {
+    SDL_DestroyTexture(m_frameTexture);
+  }
+}
+
+void SoftwareRasterizer::addTexture(SDL_Texture *texture, SDL_Surface *surface)
+{
+  if (!texture || !surface)
+  {
+    return;
+  }
+
+  if (surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+  {
+    LOG(LOG_WARNING) << "The software rasterizer can't draw from a surface with the pixel format "
+                     << SDL_GetPixelFormatName(surface->format->format) << ", it will be drawn by the renderer";
+    return;
+  }
+
+  m_textures[texture] = {static_cast<const uint32_t *>(surface->pixels), surface->w, surface->h,
+                         surface->pitch / static_cast<int>(sizeof(uint32_t))};
+}
+
+void SoftwareRasterizer::addTextureAtlas(const TextureAtlas &atlas)
+{
+  for (size_t page = 0; page < atlas.getPageCount(); ++page)
+  {
+    addTexture(atlas.getPage(static_cast<int>(page)), atlas.getPageSurface(static_cast<int>(page)));
+  }
+}
+
+void SoftwareRasterizer::submit(SDL_Renderer *renderer, const RenderSnapshot &snapshot)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Rasterize render snapshot", MP_RED);
+#endif
+
+  size_t rasterizedBatches = 0;
+  while (rasterizedBatches < snapshot.getBatchCount() && m_textures.count(snapshot.getBatch(rasterizedBatches).texture))
+  {
+    ++rasterizedBatches;
+  }
+
+  if (rasterizedBatches == 0 || !resizeFrame(renderer))
+  {
+    // the frame buffer doesn't show the last snapshot anymore
+    m_isFrameValid = false;
+    m_rasterizedBatches = 0;
+    m_redrawnPixels = 0;
+    snapshot.submit(renderer);
+    return;
+  }
+
+  Uint8 red = 0;
+  Uint8 green = 0;
+  Uint8 blue = 0;
+  Uint8 alpha = 0;
+  SDL_GetRenderDrawColor(renderer, &red, &green, &blue, &alpha);
+  const uint32_t clearColor = opaqueAlpha | (red << 16) | (green << 8) | blue;
+
+  const SDL_Rect frameRect{0, 0, m_frameWidth, m_frameHeight};
+  const int pitch = m_frameWidth * static_cast<int>(sizeof(uint32_t));
+  const DamageRegion &damage = snapshot.getDamage();
+  m_redrawnPixels = 0;
+
+  // the damage only covers changes of the snapshot, not batches moving between the frame buffer and the renderer
+  if (!m_isFrameValid || clearColor != m_clearColor || rasterizedBatches != m_rasterizedBatches || damage.isFull())
+  {
+    redrawRect(snapshot, rasterizedBatches, frameRect, clearColor);
+    SDL_UpdateTexture(m_frameTexture, nullptr, m_frameBuffer.data(), pitch);
+  }
+  else
+  {
+    // everything else still shows the last snapshot
+    for (const SDL_Rect &damagedRect : damage.getRects())
+    {
+      SDL_Rect rect;
+      if (SDL_IntersectRect(&damagedRect, &frameRect, &rect))
+      {
+        redrawRect(snapshot, rasterizedBatches, rect, clearColor);
+        SDL_UpdateTexture(m_frameTexture, &rect, &m_frameBuffer[static_cast<size_t>(rect.y) * m_frameWidth + rect.x],
+                          pitch);
+      }
+    }
+  }
+
+  SDL_RenderCopy(renderer, m_frameTexture, nullptr, nullptr);
+
+  m_isFrameValid = true;
+  m_clearColor = clearColor;
+  m_rasterizedBatches = rasterizedBatches;
+  snapshot.submit(renderer, rasterizedBatches);
+}
+
+void SoftwareRasterizer::redrawRect(const RenderSnapshot &snapshot, size_t batchCount, const SDL_Rect &rect,
+                                    uint32_t clearColor)
+{
+  for (int y = rect.y; y < rect.y + rect.h; ++y)
+  {
+    uint32_t *row = &m_frameBuffer[static_cast<size_t>(y) * m_frameWidth + rect.x];
+    std::fill(row, row + rect.w, clearColor);
+  }
+
+  for (size_t batch = 0; batch < batchCount; ++batch)
+  {
+    const RenderSnapshot::BatchGeometry geometry = snapshot.getBatch(batch);
+    const RasterTexture &texture = m_textures[geometry.texture];
+    for (size_t vertex = 0; vertex + 4 <= geometry.vertexCount; vertex += 4)
+    {
+      drawQuad(m_frameBuffer.data(), m_frameWidth, rect, texture, &geometry.vertices[vertex]);
+    }
+  }
+
+  m_redrawnPixels += static_cast<size_t>(rect.w) * rect.h;
+}
+
+bool SoftwareRasterizer::resizeFrame(SDL_Renderer *renderer)
+{
+  int width = 0;
+  int height = 0;
+  if (SDL_GetRendererOutputSize(renderer, &width, &height) != 0 || width <= 0 || height <= 0)
+  {
+    return false;
+  }
+
+  if (m_frameTexture && width == m_frameWidth && height == m_frameHeight)
+  {
+    return true;
+  }
+
+  if (m_frameTexture)
+  {
+    SDL_DestroyTexture(m_frameTexture);
+  }
+
+  m_frameTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+  if (!m_frameTexture)
+  {
+    LOG(LOG_WARNING) << "Could not create the frame texture of the software rasterizer: " << SDL_GetError();
+    m_frameWidth = 0;
+    m_frameHeight = 0;
+    return false;
+  }
+
+  // the frame buffer replaces everything that has been drawn before
+  SDL_SetTextureBlendMode(m_frameTexture, SDL_BLENDMODE_NONE);
+  m_frameWidth = width;
+  m_frameHeight = height;
+  m_frameBuffer.resize(static_cast<size_t>(width) * height);
+  m_isFrameValid = false;
+  return true;
+}
+
+void SoftwareRasterizer::drawQuad(uint32_t *frame, int frameWidth, const SDL_Rect &clipRect,
+                                  const RasterTexture &texture, const SDL_Vertex *quad)
+{
+  const double left = quad[0].position.x;
+  const double top = quad[0].position.y;
+  const double right = quad[2].position.x;
+  const double bottom = quad[2].position.y;
+  if (right <= left || bottom <= top || !texture.pixels)
+  {
+    return;
+  }
+
+  const double texLeft = quad[0].tex_coord.x * texture.width;
+  const double texTop = quad[0].tex_coord.y * texture.height;
+  const double texRight = quad[2].tex_coord.x * texture.width;
+  const double texBottom = quad[2].tex_coord.y * texture.height;
+
+  // pixels whose center lies within the quad
+  const int x0 = std::max(clipRect.x, static_cast<int>(std::ceil(left - 0.5)));
+  const int x1 = std::min(clipRect.x + clipRect.w, static_cast<int>(std::ceil(right - 0.5)));
+  const int y0 = std::max(clipRect.y, static_cast<int>(std::ceil(top - 0.5)));
+  const int y1 = std::min(clipRect.y + clipRect.h, static_cast<int>(std::ceil(bottom - 0.5)));
+  if (x0 >= x1 || y0 >= y1)
+  {
+    return;
+  }
+
+  // texels outside of the quad's source rect belong to other spritesheets of the atlas. The texture coordinates are
+  // floats, so they're only close to the texel edges
+  constexpr double tolerance = 1e-3;
+  const int minTexelX = std::max(0, static_cast<int>(std::floor(texLeft + tolerance)));
+  const int maxTexelX = std::min(texture.width - 1, static_cast<int>(std::ceil(texRight - tolerance)) - 1);
+  const int minTexelY = std::max(0, static_cast<int>(std::floor(texTop + tolerance)));
+  const int maxTexelY = std::min(texture.height - 1, static_cast<int>(std::ceil(texBottom - tolerance)) - 1);
+  if (minTexelX > maxTexelX || minTexelY > maxTexelY)
+  {
+    return;
+  }
+
+  const double texelsPerPixelX = (texRight - texLeft) / (right - left);
+  const double texelsPerPixelY = (texBottom - texTop) / (bottom - top);
+  const int count = x1 - x0;
+
+  const uint32_t minU = static_cast<uint32_t>(minTexelX) << 16;
+  const uint32_t maxU = (static_cast<uint32_t>(maxTexelX) << 16) | 0xFFFF;
+  uint32_t u = std::clamp(static_cast<uint32_t>(std::max(0.0, (texLeft + (x0 + 0.5 - left) * texelsPerPixelX) * 65536.0)),
+                          minU, maxU);
+  uint32_t step = static_cast<uint32_t>(texelsPerPixelX * 65536.0);
+  if (count > 1 && u + static_cast<uint64_t>(step) * (count - 1) > maxU)
+  {
+    step = (maxU - u) / static_cast<uint32_t>(count - 1);
+  }
+
+  const SDL_Color color = quad[0].color;
+  for (int y = y0; y < y1; ++y)
+  {
+    const int texelY =
+        std::clamp(static_cast<int>(std::floor(texTop + (y + 0.5 - top) * texelsPerPixelY)), minTexelY, maxTexelY);
+    blendSpan(frame + static_cast<size_t>(y) * frameWidth + x0, texture.pixels + static_cast<size_t>(texelY) * texture.pitch,
+              u, step, count, color);
+  }
+}
+
+void SoftwareRasterizer::blendSpan(uint32_t *dest, const uint32_t *sourceRow, uint32_t u, uint32_t step, int count,
+                                   SDL_Color color)
+{
+#ifdef SOFTWARERASTERIZER_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(opaqueAlpha));
+  const __m128i modulation = _mm_set_epi16(color.a, color.r, color.g, color.b, color.a, color.r, color.g, color.b);
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    // nearest neighbour scaling picks the texels one by one, only the blending is done four pixels at once
+    const __m128i texels =
+        _mm_set_epi32(static_cast<int>(sourceRow[(u + 3 * step) >> 16]), static_cast<int>(sourceRow[(u + 2 * step) >> 16]),
+                      static_cast<int>(sourceRow[(u + step) >> 16]), static_cast<int>(sourceRow[u >> 16]));
+    u += 4 * step;
+
+    // the transparent parts of sprites are skipped
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(texels, alphaMask), zero)) == 0xFFFF)
+    {
+      continue;
+    }
+
+    __m128i *pixels = reinterpret_cast<__m128i *>(dest + i);
+    const __m128i destination = _mm_loadu_si128(pixels);
+    const __m128i low = blendPixels(_mm_unpacklo_epi8(destination, zero), _mm_unpacklo_epi8(texels, zero), modulation);
+    const __m128i high = blendPixels(_mm_unpackhi_epi8(destination, zero), _mm_unpackhi_epi8(texels, zero), modulation);
+    _mm_storeu_si128(pixels, _mm_or_si128(_mm_packus_epi16(low, high), alphaMask));
+  }
+
+  blendSpanScalar(dest + i, sourceRow, u, step, count - i, color);
+#else
+  blendSpanScalar(dest, sourceRow, u, step, count, color);
+#endif
+}
+
+void SoftwareRasterizer::blendSpanScalar(uint32_t *dest, const uint32_t *sourceRow, uint32_t u, uint32_t step, int count,
+                                         SDL_Color color)
+{
+  for (int i = 0; i < count; ++i, u += step)
+  {
+    dest[i] = blendPixel(dest[i], sourceRow[u >> 16], color);
+  }
+}
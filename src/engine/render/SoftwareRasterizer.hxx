@@ -0,0 +1,114 @@
+#ifndef SOFTWARERASTERIZER_HXX_
+#define SOFTWARERASTERIZER_HXX_
+
+#include <SDL.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class RenderSnapshot;
+class TextureAtlas;
+
+/// Pixels of a texture the SoftwareRasterizer can draw from, in SDL_PIXELFORMAT_ARGB8888
+struct RasterTexture
+{
+  const uint32_t *pixels = nullptr;
+  int width = 0;
+  int height = 0;
+  /// distance between two rows in pixels
+  int pitch = 0;
+};
+
+/** @brief Draws the quads of a RenderSnapshot into a frame buffer in main memory
+ * Without a GPU, SDL falls back to its generic software renderer, which is slow for the scaled, blended and color
+ * modulated quads of the map. The rasterizer draws them with nearest neighbour scaling into an ARGB8888 frame buffer,
+ * blending four pixels at once with SSE2 where it's available, and presents the frame with a single texture update.
+ * Only quads of textures whose pixels have been added can be drawn. The batches of a snapshot are rasterized up to the
+ * first batch of another texture, that one and all batches after it are drawn by the renderer to keep the drawing order.
+ * The frame buffer is kept from frame to frame. Only the damage region of a snapshot is redrawn, the rest of the frame
+ * buffer still shows the last snapshot. The whole frame is redrawn if the size or the clear color changed.
+ */
+class SoftwareRasterizer
+{
+public:
+  SoftwareRasterizer() = default;
+  ~SoftwareRasterizer();
+
+  SoftwareRasterizer(const SoftwareRasterizer &) = delete;
+  SoftwareRasterizer &operator=(const SoftwareRasterizer &) = delete;
+
+  /** @brief Allow drawing the quads of a texture
+   * @param texture the texture the quads are recorded with
+   * @param surface the pixels of the texture in SDL_PIXELFORMAT_ARGB8888. It has to stay valid as long as it's drawn
+   */
+  void addTexture(SDL_Texture *texture, SDL_Surface *surface);
+
+  /** @brief Allow drawing the quads of all pages of a texture atlas
+   * The atlas must have kept its page surfaces.
+   * @see TextureAtlas#setKeepsPageSurfaces
+   */
+  void addTextureAtlas(const TextureAtlas &atlas);
+
+  /// Forget all textures that have been added
+  void clearTextures() { m_textures.clear(); };
+
+  /** @brief Draw a snapshot, replacing everything drawn before
+   * The damaged parts of the frame buffer are cleared with the draw color of the renderer and drawn again.
+   * @param renderer the renderer to present the frame buffer with
+   * @param snapshot the snapshot to draw
+   */
+  void submit(SDL_Renderer *renderer, const RenderSnapshot &snapshot);
+
+  /// Number of batches of the last submitted snapshot that have been rasterized
+  size_t getRasterizedBatches() const { return m_rasterizedBatches; };
+
+  /// Number of pixels of the frame buffer that have been redrawn for the last submitted snapshot
+  size_t getRedrawnPixels() const { return m_redrawnPixels; };
+
+  /** @brief Draw a quad into a frame buffer
+   * Pixels whose center lies within the quad are drawn. Like SDL_BLENDMODE_BLEND, the texels are blended onto the
+   * frame buffer with their alpha, which stays opaque.
+   * @param frame the frame buffer, one row after another
+   * @param frameWidth width of the frame buffer
+   * @param clipRect only pixels within this rect are drawn, it must lie within the frame buffer
+   * @param texture the texture of the quad
+   * @param quad four vertices, top left, top right, bottom right and bottom left. Their color modulates the texels
+   */
+  static void drawQuad(uint32_t *frame, int frameWidth, const SDL_Rect &clipRect, const RasterTexture &texture,
+                       const SDL_Vertex *quad);
+
+  /** @brief Blend a row of texels onto a row of opaque pixels
+   * @param dest the first pixel
+   * @param sourceRow the row of the texture
+   * @param u position of the first texel in the row as 16.16 fixed point number
+   * @param step distance of the texels of two neighbouring pixels as 16.16 fixed point number
+   * @param count number of pixels
+   * @param color color and alpha modulation of the texels
+   */
+  static void blendSpan(uint32_t *dest, const uint32_t *sourceRow, uint32_t u, uint32_t step, int count, SDL_Color color);
+
+  /// Same as blendSpan(), but without SIMD
+  static void blendSpanScalar(uint32_t *dest, const uint32_t *sourceRow, uint32_t u, uint32_t step, int count,
+                              SDL_Color color);
+
+private:
+  /// Make the frame buffer and its texture as large as the output of the renderer
+  bool resizeFrame(SDL_Renderer *renderer);
+
+  /// Clear a rect of the frame buffer and draw the quads of the first batches of a snapshot into it
+  void redrawRect(const RenderSnapshot &snapshot, size_t batchCount, const SDL_Rect &rect, uint32_t clearColor);
+
+  std::unordered_map<SDL_Texture *, RasterTexture> m_textures;
+  std::vector<uint32_t> m_frameBuffer;
+  SDL_Texture *m_frameTexture = nullptr;
+  int m_frameWidth = 0;
+  int m_frameHeight = 0;
+  size_t m_rasterizedBatches = 0;
+  size_t m_redrawnPixels = 0;
+  /// the frame buffer shows the last submitted snapshot
+  bool m_isFrameValid = false;
+  uint32_t m_clearColor = 0;
+};
+
+#endif
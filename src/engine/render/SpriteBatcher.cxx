@@ -0,0 +1,106 @@
+#include "SpriteBatcher.hxx"
+#include "RenderSnapshot.hxx"
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+void SpriteBatcher::begin(SDL_Renderer *renderer)
+{
+  m_renderer = renderer;
+  m_snapshot = nullptr;
+  m_texture = nullptr;
+  m_vertices.clear();
+  m_drawCalls = 0;
+  m_quadCount = 0;
+  m_textureChanges = 0;
+}
+
+void SpriteBatcher::begin(RenderSnapshot &snapshot)
+{
+  begin(nullptr);
+  m_snapshot = &snapshot;
+}
+
+void SpriteBatcher::end() { flush(); }
+
+void SpriteBatcher::draw(SDL_Texture *texture, const SDL_Rect &bounds, const SDL_Rect &srcRect, const SDL_Rect &destRect,
+                         SDL_Color color)
+{
+  if (!texture || srcRect.w <= 0 || srcRect.h <= 0)
+  {
+    return;
+  }
+
+  const SDL_Rect source{bounds.x + srcRect.x, bounds.y + srcRect.y, srcRect.w, srcRect.h};
+  SDL_Rect clipped;
+  if (!SDL_IntersectRect(&source, &bounds, &clipped))
+  {
+    return;
+  }
+
+  if (texture != m_texture)
+  {
+    flush();
+    m_texture = texture;
+    m_textureChanges++;
+
+    int width = 1;
+    int height = 1;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    m_textureWidth = static_cast<float>(width);
+    m_textureHeight = static_cast<float>(height);
+  }
+
+  // scale the destination rect the same way SDL_RenderCopy does for clipped source rects
+  const float scaleX = static_cast<float>(destRect.w) / static_cast<float>(srcRect.w);
+  const float scaleY = static_cast<float>(destRect.h) / static_cast<float>(srcRect.h);
+  const float left = static_cast<float>(destRect.x) + static_cast<float>(clipped.x - source.x) * scaleX;
+  const float top = static_cast<float>(destRect.y) + static_cast<float>(clipped.y - source.y) * scaleY;
+  const float right = left + static_cast<float>(clipped.w) * scaleX;
+  const float bottom = top + static_cast<float>(clipped.h) * scaleY;
+
+  const float u0 = static_cast<float>(clipped.x) / m_textureWidth;
+  const float v0 = static_cast<float>(clipped.y) / m_textureHeight;
+  const float u1 = static_cast<float>(clipped.x + clipped.w) / m_textureWidth;
+  const float v1 = static_cast<float>(clipped.y + clipped.h) / m_textureHeight;
+
+  m_vertices.push_back({{left, top}, color, {u0, v0}});
+  m_vertices.push_back({{right, top}, color, {u1, v0}});
+  m_vertices.push_back({{right, bottom}, color, {u1, v1}});
+  m_vertices.push_back({{left, bottom}, color, {u0, v1}});
+  m_quadCount++;
+}
+
+void SpriteBatcher::flush()
+{
+  if (m_vertices.empty())
+  {
+    return;
+  }
+
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Flush sprite batch", MP_RED);
+#endif
+
+  if (m_snapshot)
+  {
+    m_snapshot->addBatch(m_texture, m_vertices.data(), m_vertices.size());
+    m_drawCalls++;
+    m_vertices.clear();
+    return;
+  }
+
+  const size_t quads = m_vertices.size() / 4;
+  while (m_indices.size() < quads * 6)
+  {
+    const int firstVertex = static_cast<int>(m_indices.size() / 6 * 4);
+    m_indices.insert(m_indices.end(),
+                     {firstVertex, firstVertex + 1, firstVertex + 2, firstVertex + 2, firstVertex + 3, firstVertex});
+  }
+
+  SDL_RenderGeometry(m_renderer, m_texture, m_vertices.data(), static_cast<int>(m_vertices.size()), m_indices.data(),
+                     static_cast<int>(quads * 6));
+  m_drawCalls++;
+  m_vertices.clear();
+}
@@ -0,0 +1,86 @@
+#ifndef SPRITEBATCHER_HXX_
+#define SPRITEBATCHER_HXX_
+
+#include <SDL.h>
+
+#include <vector>
+
+class RenderSnapshot;
+
+/// Counters of a batch since begin(), to measure the work of a frame
+struct BatchStats
+{
+  int drawCalls = 0;
+  int quads = 0;
+  /// number of times the texture changed, every change ends a draw call
+  int textureChanges = 0;
+};
+
+/** @brief Collects textured quads and submits them with as few draw calls as possible
+ * Consecutive quads that use the same texture are put into one vertex buffer and drawn with a single SDL_RenderGeometry
+ * call. The batch is flushed whenever the texture changes, so the drawing order of all quads is kept.
+ * Color and alpha modulation are stored as vertex colors, so they don't break a batch either.
+ * Instead of drawing the quads, the batches can be recorded into a RenderSnapshot.
+ */
+class SpriteBatcher
+{
+public:
+  SpriteBatcher() = default;
+
+  /** @brief Start a new frame
+   * @param renderer the renderer to draw to
+   */
+  void begin(SDL_Renderer *renderer);
+
+  /** @brief Start recording a frame
+   * The batches are appended to the snapshot instead of being drawn.
+   * @param snapshot the snapshot to record to
+   */
+  void begin(RenderSnapshot &snapshot);
+
+  /** @brief Draw all remaining quads
+   */
+  void end();
+
+  /** @brief Add a textured quad
+   * Like SDL_RenderCopy, the source rect is clipped to the bounds and the destination rect is adjusted accordingly.
+   * @param texture the texture to draw from
+   * @param bounds the part of the texture the source rect has to stay within (e.g. a spritesheet within a texture atlas)
+   * @param srcRect the source rect relative to the bounds
+   * @param destRect the destination rect in screen coordinates
+   * @param color color and alpha modulation of the quad
+   */
+  void draw(SDL_Texture *texture, const SDL_Rect &bounds, const SDL_Rect &srcRect, const SDL_Rect &destRect, SDL_Color color);
+
+  /** @brief Submit all collected quads
+   */
+  void flush();
+
+  /// Number of draw calls since begin()
+  int getDrawCalls() const { return m_drawCalls; };
+
+  /// Number of quads since begin()
+  int getQuadCount() const { return m_quadCount; };
+
+  /// Number of texture changes since begin()
+  int getTextureChanges() const { return m_textureChanges; };
+
+  BatchStats getStats() const { return {m_drawCalls, m_quadCount, m_textureChanges}; };
+
+private:
+  SDL_Renderer *m_renderer = nullptr;
+  RenderSnapshot *m_snapshot = nullptr;
+  SDL_Texture *m_texture = nullptr;
+  float m_textureWidth = 1;
+  float m_textureHeight = 1;
+
+  std::vector<SDL_Vertex> m_vertices;
+  /// all quads share the same index pattern, so the indices are only generated when the buffer grows
+  std::vector<int> m_indices;
+
+  int m_drawCalls = 0;
+  int m_quadCount = 0;
+  int m_textureChanges = 0;
+};
+
+#endif
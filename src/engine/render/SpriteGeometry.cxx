@@ -0,0 +1,37 @@
+#include "SpriteGeometry.hxx"
+
+#include <cmath>
+
+SpriteGeometryTable::GeometryId SpriteGeometryTable::add(int frameWidth, int frameHeight, int sheetHeight)
+{
+  SpriteGeometry geometry;
+  geometry.frameWidth = frameWidth;
+  geometry.frameHeight = frameHeight;
+  geometry.clipY = sheetHeight - frameHeight;
+  m_geometries.push_back(geometry);
+  m_zoomLevel = 0;
+
+  return static_cast<GeometryId>(m_geometries.size() - 1);
+}
+
+void SpriteGeometryTable::clear()
+{
+  m_geometries.clear();
+  m_zoomLevel = 0;
+}
+
+void SpriteGeometryTable::setZoomLevel(double zoomLevel)
+{
+  if (zoomLevel == m_zoomLevel)
+  {
+    return;
+  }
+
+  // the same rounding as Sprite::refresh, so sprites look the same with and without the table
+  for (SpriteGeometry &geometry : m_geometries)
+  {
+    geometry.width = static_cast<int>(std::round(static_cast<double>(geometry.frameWidth) * zoomLevel));
+    geometry.height = static_cast<int>(std::round(static_cast<double>(geometry.frameHeight) * zoomLevel));
+  }
+  m_zoomLevel = zoomLevel;
+}
@@ -0,0 +1,59 @@
+#ifndef SPRITEGEOMETRY_HXX_
+#define SPRITEGEOMETRY_HXX_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// Geometry of the frames of a spritesheet, shared by all sprites that draw from it
+struct SpriteGeometry
+{
+  /// size of a frame in the spritesheet
+  int frameWidth = 0;
+  int frameHeight = 0;
+  /// y coordinate of the frames in the spritesheet, frames are aligned at the bottom of the sheet
+  int clipY = 0;
+  /// size of a frame at the current zoom level
+  int width = 0;
+  int height = 0;
+};
+
+/** @brief Holds the geometry of all tile spritesheets at the current zoom level
+ * Every sprite that shows a frame of the same spritesheet has the same clip rect height and the same scaled size, so
+ * they're computed once per zoom level instead of once per sprite.
+ */
+class SpriteGeometryTable
+{
+public:
+  using GeometryId = uint32_t;
+  static constexpr GeometryId NO_GEOMETRY = std::numeric_limits<GeometryId>::max();
+
+  /** @brief Add the geometry of a spritesheet
+   * @param frameWidth width of a frame in pixels
+   * @param frameHeight height of a frame in pixels
+   * @param sheetHeight height of the spritesheet in pixels
+   * @return id of the geometry
+   */
+  GeometryId add(int frameWidth, int frameHeight, int sheetHeight);
+
+  /// Remove all geometries
+  void clear();
+
+  /** @brief Scale all geometries for a zoom level
+   * Does nothing if the table has already been scaled for this zoom level.
+   * @param zoomLevel the zoom level of the camera
+   */
+  void setZoomLevel(double zoomLevel);
+
+  /// Zoom level the table has been scaled for
+  double getZoomLevel() const { return m_zoomLevel; };
+
+  const SpriteGeometry &get(GeometryId id) const { return m_geometries[id]; };
+
+private:
+  std::vector<SpriteGeometry> m_geometries;
+  /// zoom level 0 is never used, so geometries that are added are always scaled with the next zoom level
+  double m_zoomLevel = 0;
+};
+
+#endif
@@ -0,0 +1,200 @@
+#include "TerrainChunkCache.hxx"
+
+#include "../map/MapChunks.hxx"
+#include "../map/MapGrid.hxx"
+#include "../basics/Camera.hxx"
+#include "LOG.hxx"
+
+#include <algorithm>
+
+#ifdef MICROPROFILE_ENABLED
+#include "microprofile/microprofile.h"
+#endif
+
+TerrainChunkCache::~TerrainChunkCache() { clear(); }
+
+void TerrainChunkCache::update(SDL_Renderer *renderer, const MapChunks &chunks, const MapGrid &grid, unsigned int activeLayers)
+{
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Update terrain cache", MP_YELLOW);
+#endif
+
+  if (!m_renderTargetsSupported)
+  {
+    return;
+  }
+
+  if (m_entries.empty())
+  {
+    if (!SDL_RenderTargetSupported(renderer))
+    {
+      LOG(LOG_WARNING) << "The renderer does not support render targets, static terrain will not be cached";
+      m_renderTargetsSupported = false;
+      return;
+    }
+
+    SDL_RendererInfo rendererInfo;
+    m_maxTextureSize = (SDL_GetRendererInfo(renderer, &rendererInfo) == 0)
+                           ? std::min(rendererInfo.max_texture_width, rendererInfo.max_texture_height)
+                           : 0;
+  }
+
+  const size_t chunkCount = static_cast<size_t>(chunks.chunksX()) * chunks.chunksY();
+  if (m_entries.size() != chunkCount)
+  {
+    clear();
+    m_entries.resize(chunkCount);
+  }
+
+  const double zoomLevel = Camera::instance().zoomLevel();
+  const unsigned int layers = activeLayers & cachedLayers;
+
+  for (int chunkIdx = 0; chunkIdx < static_cast<int>(chunkCount); ++chunkIdx)
+  {
+    const MapChunk &chunk = chunks.chunk(chunkIdx);
+    Entry &entry = m_entries[chunkIdx];
+
+    if (!chunk.visible)
+    {
+      releaseEntry(entry);
+    }
+    else if (!entry.cached || entry.revision != chunk.revision || entry.zoomLevel != zoomLevel || entry.layers != layers)
+    {
+      renderEntry(entry, renderer, chunks, chunkIdx, grid, layers);
+      entry.revision = chunk.revision;
+      entry.zoomLevel = zoomLevel;
+      entry.layers = layers;
+    }
+  }
+}
+
+void TerrainChunkCache::draw(SpriteBatcher &batcher, const MapChunks &chunks) const
+{
+  const SDL_Point &cameraOffset = Camera::instance().cameraOffset();
+
+  // same order as the nodes: y descending, x ascending
+  for (int chunkY = chunks.chunksY() - 1; chunkY >= 0; --chunkY)
+  {
+    for (int chunkX = 0; chunkX < chunks.chunksX(); ++chunkX)
+    {
+      const int chunkIdx = chunkX * chunks.chunksY() + chunkY;
+
+      if (!isChunkCached(chunkIdx) || !m_entries[chunkIdx].texture || !chunks.chunk(chunkIdx).visible)
+      {
+        continue;
+      }
+
+      const Entry &entry = m_entries[chunkIdx];
+      const SDL_Rect textureRect{0, 0, entry.worldRect.w, entry.worldRect.h};
+      const SDL_Rect destRect{entry.worldRect.x - cameraOffset.x, entry.worldRect.y - cameraOffset.y, entry.worldRect.w,
+                              entry.worldRect.h};
+      batcher.draw(entry.texture, textureRect, textureRect, destRect, SDL_Color{255, 255, 255, 255});
+    }
+  }
+}
+
+void TerrainChunkCache::clear()
+{
+  for (auto &entry : m_entries)
+  {
+    releaseEntry(entry);
+  }
+  m_entries.clear();
+}
+
+void TerrainChunkCache::releaseEntry(Entry &entry)
+{
+  if (entry.texture)
+  {
+    SDL_DestroyTexture(entry.texture);
+  }
+  entry = Entry{};
+}
+
+void TerrainChunkCache::renderEntry(Entry &entry, SDL_Renderer *renderer, const MapChunks &chunks, int chunkIdx,
+                                    const MapGrid &grid, unsigned int layers)
+{
+  const MapChunk &chunk = chunks.chunk(chunkIdx);
+
+  SDL_Rect worldRect{0, 0, 0, 0};
+  for (int x = chunk.firstX; x <= chunk.lastX; ++x)
+  {
+    for (int y = chunk.firstY; y <= chunk.lastY; ++y)
+    {
+      const SDL_Rect spriteRect = grid.sprite(grid.nodeIdx(x, y)).getWorldBoundingBox(layers);
+      if (SDL_RectEmpty(&spriteRect))
+      {
+        continue;
+      }
+      if (SDL_RectEmpty(&worldRect))
+      {
+        worldRect = spriteRect;
+      }
+      else
+      {
+        SDL_UnionRect(&worldRect, &spriteRect, &worldRect);
+      }
+    }
+  }
+
+  if (SDL_RectEmpty(&worldRect))
+  { // nothing to draw, the cache is up to date without a texture
+    releaseEntry(entry);
+    entry.cached = true;
+    return;
+  }
+
+  if (m_maxTextureSize > 0 && (worldRect.w > m_maxTextureSize || worldRect.h > m_maxTextureSize))
+  { // the chunk is too big at this zoom level, it will be drawn node by node
+    releaseEntry(entry);
+    return;
+  }
+
+  if (!entry.texture || entry.worldRect.w != worldRect.w || entry.worldRect.h != worldRect.h)
+  {
+    releaseEntry(entry);
+    entry.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, worldRect.w, worldRect.h);
+    if (!entry.texture)
+    {
+      LOG(LOG_WARNING) << "Could not create a terrain cache texture of " << worldRect.w << "x" << worldRect.h
+                       << " pixels! SDL Error: " << SDL_GetError();
+      return;
+    }
+
+    // the sprites are blended onto a transparent texture, so its colors are already multiplied with their alpha
+    const SDL_BlendMode premultipliedAlpha =
+        SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                   SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    if (SDL_SetTextureBlendMode(entry.texture, premultipliedAlpha) != 0)
+    {
+      SDL_SetTextureBlendMode(entry.texture, SDL_BLENDMODE_BLEND);
+    }
+  }
+  entry.worldRect = worldRect;
+
+#ifdef MICROPROFILE_ENABLED
+  MICROPROFILE_SCOPEI("Map", "Render terrain chunk", MP_YELLOW);
+#endif
+
+  SDL_Color drawColor;
+  SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g, &drawColor.b, &drawColor.a);
+  SDL_SetRenderTarget(renderer, entry.texture);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
+  SDL_RenderClear(renderer);
+  SDL_SetRenderDrawColor(renderer, drawColor.r, drawColor.g, drawColor.b, drawColor.a);
+
+  const SDL_Point offset{worldRect.x, worldRect.y};
+  m_batcher.begin(renderer);
+  for (int y = chunk.lastY; y >= chunk.firstY; --y)
+  {
+    for (int x = chunk.firstX; x <= chunk.lastX; ++x)
+    {
+      // highlights change often, they're drawn on top of the cache
+      grid.sprite(grid.nodeIdx(x, y)).render(m_batcher, offset, layers, false);
+    }
+  }
+  m_batcher.end();
+
+  SDL_SetRenderTarget(renderer, nullptr);
+  entry.cached = true;
+}
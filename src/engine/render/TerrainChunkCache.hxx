@@ -0,0 +1,78 @@
+#ifndef TERRAINCHUNKCACHE_HXX_
+#define TERRAINCHUNKCACHE_HXX_
+
+#include <SDL.h>
+#include <vector>
+
+#include "SpriteBatcher.hxx"
+#include "../common/enums.hxx"
+
+class MapChunks;
+class MapGrid;
+
+/** @brief Caches the static layers of each map chunk in a render target texture
+ * Terrain, water and ground decoration rarely change, so instead of drawing them node by node every frame, they are
+ * drawn once per zoom level into a texture per chunk. A chunk's texture is redrawn when one of its nodes changes, when the
+ * zoom level or the active layers change. Textures of chunks that are not visible are released.
+ * All other layers and highlighted nodes have to be drawn on top of the cached textures.
+ */
+class TerrainChunkCache
+{
+public:
+  /// Bitmask of the layers that are cached
+  static constexpr unsigned int cachedLayers = (1U << Layer::TERRAIN) | (1U << Layer::WATER) | (1U << Layer::GROUND_DECORATION);
+
+  TerrainChunkCache() = default;
+  ~TerrainChunkCache();
+
+  TerrainChunkCache(const TerrainChunkCache &) = delete;
+  TerrainChunkCache &operator=(const TerrainChunkCache &) = delete;
+
+  /** @brief Redraw the textures of all visible chunks that are outdated
+   * Must be called before anything is drawn to the screen, because it changes the render target.
+   * @param renderer the renderer to draw with
+   * @param chunks the chunks of the map, the culling pass must be up to date
+   * @param grid the grid that holds the sprites
+   * @param activeLayers bitmask of the layers that are currently drawn
+   */
+  void update(SDL_Renderer *renderer, const MapChunks &chunks, const MapGrid &grid, unsigned int activeLayers);
+
+  /** @brief Draw the cached textures of all visible chunks in drawing order
+   * @param batcher the batch to add the textures to
+   * @param chunks the chunks of the map
+   */
+  void draw(SpriteBatcher &batcher, const MapChunks &chunks) const;
+
+  /// Check if the static layers of a chunk are drawn from the cache
+  bool isChunkCached(int chunkIdx) const
+  {
+    return chunkIdx < static_cast<int>(m_entries.size()) && m_entries[chunkIdx].cached;
+  };
+
+  /// Release all textures
+  void clear();
+
+private:
+  struct Entry
+  {
+    SDL_Texture *texture = nullptr;
+    /// area of the texture in world coordinates
+    SDL_Rect worldRect{0, 0, 0, 0};
+    double zoomLevel = 0;
+    unsigned int revision = 0;
+    unsigned int layers = 0;
+    /// the cache holds the current static layers of the chunk (an empty chunk doesn't need a texture)
+    bool cached = false;
+  };
+
+  void releaseEntry(Entry &entry);
+  void renderEntry(Entry &entry, SDL_Renderer *renderer, const MapChunks &chunks, int chunkIdx, const MapGrid &grid,
+                   unsigned int layers);
+
+  std::vector<Entry> m_entries;
+  SpriteBatcher m_batcher;
+  int m_maxTextureSize = 0;
+  bool m_renderTargetsSupported = true;
+};
+
+#endif
@@ -0,0 +1,216 @@
+#include "TextureAtlas.hxx"
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+#include <algorithm>
+#include <numeric>
+
+TextureAtlas::~TextureAtlas() { clear(); }
+
+void TextureAtlas::add(const std::string &id, SDL_Surface *surface)
+{
+  if (surface)
+  {
+    m_pendingSurfaces.emplace_back(id, surface);
+  }
+}
+
+void TextureAtlas::build(SDL_Renderer *renderer, int maxPageSize)
+{
+  destroyPages();
+  m_regions.clear();
+
+  int pageSize = maxPageSize;
+  SDL_RendererInfo rendererInfo;
+  if (SDL_GetRendererInfo(renderer, &rendererInfo) == 0)
+  {
+    // a maximum size of 0 means there is no limit
+    if (rendererInfo.max_texture_width > 0)
+    {
+      pageSize = std::min(pageSize, rendererInfo.max_texture_width);
+    }
+    if (rendererInfo.max_texture_height > 0)
+    {
+      pageSize = std::min(pageSize, rendererInfo.max_texture_height);
+    }
+  }
+
+  std::vector<SDL_Point> sizes;
+  sizes.reserve(m_pendingSurfaces.size());
+  for (const auto &[id, surface] : m_pendingSurfaces)
+  {
+    sizes.push_back({surface->w, surface->h});
+  }
+
+  const std::vector<AtlasRegion> regions = pack(sizes, pageSize);
+
+  // shrink the pages to the area that is actually used
+  std::vector<SDL_Point> pageSizes;
+  for (const auto &region : regions)
+  {
+    if (region.isValid())
+    {
+      if (static_cast<int>(pageSizes.size()) <= region.page)
+      {
+        pageSizes.resize(region.page + 1, {0, 0});
+      }
+      pageSizes[region.page].x = std::max(pageSizes[region.page].x, region.rect.x + region.rect.w);
+      pageSizes[region.page].y = std::max(pageSizes[region.page].y, region.rect.y + region.rect.h);
+    }
+  }
+
+  std::vector<SDL_Surface *> pageSurfaces;
+  for (const auto &size : pageSizes)
+  {
+    // the software rasterizer blends in the native format of SDL's software renderer
+    SDL_Surface *pageSurface = SDL_CreateRGBSurfaceWithFormat(
+        0, size.x, size.y, 32, m_keepsPageSurfaces ? SDL_PIXELFORMAT_ARGB8888 : SDL_PIXELFORMAT_RGBA32);
+    if (!pageSurface)
+    {
+      for (SDL_Surface *surface : pageSurfaces)
+      {
+        SDL_FreeSurface(surface);
+      }
+      throw UIError(TRACE_INFO "Could not create texture atlas page! SDL Error: " + string{SDL_GetError()});
+    }
+    pageSurfaces.push_back(pageSurface);
+  }
+
+  size_t packedSurfaces = 0;
+  for (size_t i = 0; i < m_pendingSurfaces.size(); ++i)
+  {
+    const auto &[id, surface] = m_pendingSurfaces[i];
+    const AtlasRegion &region = regions[i];
+
+    if (!region.isValid())
+    {
+      LOG(LOG_DEBUG) << "Spritesheet " << id << " (" << surface->w << "x" << surface->h
+                     << ") is too big for the texture atlas, it will be drawn from its own texture";
+      continue;
+    }
+
+    // copy the pixels including the alpha channel instead of blending them onto the empty page
+    SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+    SDL_GetSurfaceBlendMode(surface, &blendMode);
+    SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    SDL_Rect destRect = region.rect;
+    SDL_BlitSurface(surface, nullptr, pageSurfaces[region.page], &destRect);
+    SDL_SetSurfaceBlendMode(surface, blendMode);
+
+    m_regions[id] = region;
+    packedSurfaces++;
+  }
+
+  bool pagesCreated = true;
+  for (SDL_Surface *pageSurface : pageSurfaces)
+  {
+    SDL_Texture *page = pagesCreated ? SDL_CreateTextureFromSurface(renderer, pageSurface) : nullptr;
+    if (page && m_keepsPageSurfaces)
+    {
+      m_pageSurfaces.push_back(pageSurface);
+    }
+    else
+    {
+      SDL_FreeSurface(pageSurface);
+    }
+
+    if (page)
+    {
+      SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+      m_pages.push_back(page);
+    }
+    else
+    {
+      pagesCreated = false;
+    }
+  }
+
+  if (!pagesCreated)
+  {
+    clear();
+    throw UIError(TRACE_INFO "Could not create texture atlas page! SDL Error: " + string{SDL_GetError()});
+  }
+
+  LOG(LOG_DEBUG) << "Packed " << packedSurfaces << " of " << m_pendingSurfaces.size() << " spritesheets into "
+                 << m_pages.size() << " texture atlas pages of up to " << pageSize << "x" << pageSize << " pixels";
+  m_pendingSurfaces.clear();
+}
+
+void TextureAtlas::clear()
+{
+  destroyPages();
+  m_regions.clear();
+  m_pendingSurfaces.clear();
+}
+
+void TextureAtlas::destroyPages()
+{
+  for (SDL_Texture *page : m_pages)
+  {
+    SDL_DestroyTexture(page);
+  }
+  m_pages.clear();
+
+  for (SDL_Surface *pageSurface : m_pageSurfaces)
+  {
+    SDL_FreeSurface(pageSurface);
+  }
+  m_pageSurfaces.clear();
+}
+
+const AtlasRegion &TextureAtlas::getRegion(const std::string &id) const
+{
+  static const AtlasRegion invalidRegion;
+
+  const auto it = m_regions.find(id);
+  return (it != m_regions.end()) ? it->second : invalidRegion;
+}
+
+std::vector<AtlasRegion> TextureAtlas::pack(const std::vector<SDL_Point> &sizes, int pageSize, int padding)
+{
+  std::vector<AtlasRegion> regions(sizes.size());
+
+  // tallest first, so every shelf is filled with rectangles of a similar height
+  std::vector<size_t> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&sizes](size_t a, size_t b)
+                   { return (sizes[a].y != sizes[b].y) ? sizes[a].y > sizes[b].y : sizes[a].x > sizes[b].x; });
+
+  int page = 0;
+  int shelfY = 0;
+  int shelfHeight = 0;
+  int cursorX = 0;
+
+  for (size_t index : order)
+  {
+    const SDL_Point &size = sizes[index];
+
+    if (size.x <= 0 || size.y <= 0 || size.x > pageSize || size.y > pageSize)
+    {
+      continue;
+    }
+
+    if (cursorX + size.x > pageSize)
+    { // start a new shelf
+      shelfY += shelfHeight + padding;
+      shelfHeight = 0;
+      cursorX = 0;
+    }
+
+    if (shelfY + size.y > pageSize)
+    { // start a new page
+      page++;
+      shelfY = 0;
+      shelfHeight = 0;
+      cursorX = 0;
+    }
+
+    regions[index] = {page, {cursorX, shelfY, size.x, size.y}};
+    cursorX += size.x + padding;
+    shelfHeight = std::max(shelfHeight, size.y);
+  }
+
+  return regions;
+}
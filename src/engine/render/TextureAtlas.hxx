@@ -0,0 +1,91 @@
+#ifndef TEXTUREATLAS_HXX_
+#define TEXTUREATLAS_HXX_
+
+#include <SDL.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @brief Position of a spritesheet within a texture atlas
+ */
+struct AtlasRegion
+{
+  /// page of the atlas that contains the spritesheet, -1 if the spritesheet is not part of the atlas
+  int page = -1;
+  /// position and size of the spritesheet on the page
+  SDL_Rect rect{0, 0, 0, 0};
+
+  bool isValid() const { return page >= 0; };
+};
+
+/** @brief Packs many spritesheets into a few large textures
+ * Drawing sprites from the same texture allows the renderer to batch them, so a frame only needs a few draw calls instead
+ * of one per sprite. Spritesheets are packed on shelves, sorted by their height. Spritesheets that are larger than a page
+ * are not added to the atlas and have to be drawn from their own texture.
+ */
+class TextureAtlas
+{
+public:
+  TextureAtlas() = default;
+  ~TextureAtlas();
+
+  TextureAtlas(const TextureAtlas &) = delete;
+  TextureAtlas &operator=(const TextureAtlas &) = delete;
+
+  /** @brief Add a spritesheet to the atlas. The atlas is created when build() is called.
+   * @param id unique id of the spritesheet
+   * @param surface the spritesheet. The surface is not owned by the atlas and has to stay valid until build() is called
+   */
+  void add(const std::string &id, SDL_Surface *surface);
+
+  /** @brief Pack all added spritesheets and create the textures for the pages
+   * @param renderer the renderer to create the textures for
+   * @param maxPageSize maximum width and height of a page, it will be limited to the maximum texture size of the renderer
+   * @throws UIError if a page texture can not be created
+   */
+  void build(SDL_Renderer *renderer, int maxPageSize = 4096);
+
+  /// Destroy all pages and forget all spritesheets
+  void clear();
+
+  /** @brief Get the region of a spritesheet
+   * @param id the id that has been used to add the spritesheet
+   * @return the region of the spritesheet, or an invalid region if it is not part of the atlas
+   */
+  const AtlasRegion &getRegion(const std::string &id) const;
+
+  SDL_Texture *getPage(int page) const { return m_pages[page]; };
+  size_t getPageCount() const { return m_pages.size(); };
+
+  /** @brief Keep the pixels of the pages after they've been uploaded to the textures
+   * The SoftwareRasterizer needs them to draw from the pages. Must be set before build() is called.
+   */
+  void setKeepsPageSurfaces(bool keepsPageSurfaces) { m_keepsPageSurfaces = keepsPageSurfaces; };
+
+  /// Get the pixels of a page in SDL_PIXELFORMAT_ARGB8888, nullptr if they haven't been kept
+  SDL_Surface *getPageSurface(int page) const
+  {
+    return (page < static_cast<int>(m_pageSurfaces.size())) ? m_pageSurfaces[page] : nullptr;
+  };
+
+  /** @brief Pack rectangles of the given sizes on shelves
+   * @param sizes width and height of all rectangles
+   * @param pageSize width and height of a page
+   * @param padding free space between two rectangles
+   * @return the region for each size in the same order, rectangles that do not fit on a page get an invalid region
+   */
+  static std::vector<AtlasRegion> pack(const std::vector<SDL_Point> &sizes, int pageSize, int padding = 1);
+
+private:
+  std::vector<std::pair<std::string, SDL_Surface *>> m_pendingSurfaces;
+  std::unordered_map<std::string, AtlasRegion> m_regions;
+  std::vector<SDL_Texture *> m_pages;
+  std::vector<SDL_Surface *> m_pageSurfaces;
+  bool m_keepsPageSurfaces = false;
+
+  /// Destroy the textures and surfaces of all pages
+  void destroyPages();
+};
+
+#endif
@@ -47,11 +47,12 @@ void ZoneArea::spawnBuildings()
 
     // get the maximum size we can spawn at this node
     TileSize maxTileSize = getMaximumTileSize(node.coordinate);
-    std::string buildingTileID =
-        TileManager::instance().getRandomTileIDForZoneWithRandomSize(m_zoneType, m_zoneDensity, maxTileSize).value_or("");
+    const TileId buildingTileId = TileManager::instance()
+                                      .getRandomTileIDForZoneWithRandomSize(m_zoneType, m_zoneDensity, maxTileSize)
+                                      .value_or(EMPTY_TILE_ID);
 
     // place the building
-    Engine::instance().map->setTileID(buildingTileID, node.coordinate);
+    Engine::instance().map->setTileID(buildingTileId, node.coordinate);
     buildingsSpawned++;
   }
 }
@@ -1,6 +1,8 @@
 #include <iostream>
 
 #include "Game.hxx"
+#include "engine/RenderBenchmark.hxx"
+#include "engine/basics/Settings.hxx"
 #include "Exception.hxx"
 #include "LOG.hxx"
 
@@ -18,6 +20,9 @@ int protected_main(int argc, char **argv)
 
   bool skipMenu = false;
   bool quitGame = false;
+  std::string benchmarkScript;
+  std::string benchmarkOutput;
+  std::string benchmarkReference;
 
   // add commandline parameter to skipMenu
   for (int i = 1; i < argc; ++i)
@@ -26,6 +31,27 @@ int protected_main(int argc, char **argv)
     {
       skipMenu = true;
     }
+    // --headless <script> <output directory> renders a benchmark script without a window
+    else if (std::string(argv[i]) == "--headless" && i + 2 < argc)
+    {
+      benchmarkScript = argv[++i];
+      benchmarkOutput = argv[++i];
+    }
+    // --reference <directory> compares the benchmark frames to the ones of an earlier run
+    else if (std::string(argv[i]) == "--reference" && i + 1 < argc)
+    {
+      benchmarkReference = argv[++i];
+    }
+    // --software-rasterizer draws the map with the software rasterizer, e.g. to benchmark it against the renderer
+    else if (std::string(argv[i]) == "--software-rasterizer")
+    {
+      Settings::instance().forceSoftwareRasterizer = true;
+    }
+  }
+
+  if (!benchmarkScript.empty())
+  {
+    Settings::instance().headless = true;
   }
 
   LOG(LOG_DEBUG) << "Launching Cytopia";
@@ -37,6 +63,14 @@ int protected_main(int argc, char **argv)
   if (!game.initialize())
     return EXIT_FAILURE;
 
+  if (!benchmarkScript.empty())
+  {
+    LOG(LOG_DEBUG) << "Running the render benchmark " << benchmarkScript;
+    const bool isBenchmarkPassed = RenderBenchmark().run(benchmarkScript, benchmarkOutput, benchmarkReference);
+    game.shutdown();
+    return isBenchmarkPassed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   if (!skipMenu)
   {
     quitGame = game.mainMenu();
@@ -1,36 +1,43 @@
 #include <cassert>
 #include "GameClock.hxx"
 
-template <typename Task, typename Cmp, typename Now> void GameClock::tickTask(PriorityQueue<Task, Cmp> &queue, const Now now)
+template <typename Task, typename Cmp, typename Now> bool GameClock::tickTask(PriorityQueue<Task, Cmp> &queue, const Now now)
 {
+  bool hasCalledTask = false;
+
   while (!queue.empty() && (now >= queue.top().m_waketime))
   {
     const auto task = queue.top();
     queue.pop();
     const bool isCanceled = task.callback();
+    hasCalledTask = true;
 
     if (!isCanceled && (task.m_period != decltype(task.m_period){0}))
     {
       queue.push(Task(task.callback, now + task.m_period, task.m_period, task.hndl));
     }
   }
+
+  return hasCalledTask;
 }
 
-void GameClock::tick(void)
+bool GameClock::tick(void)
 {
   std::lock_guard<std::mutex> lock(m_lock);
 
   const auto now = Clock::now();
 
-  tickTask(m_realTimeTasks, now);
+  bool hasCalledTask = tickTask(m_realTimeTasks, now);
 
   if ((now - m_lastGameTickTime) >= m_gameTickDuration)
   {
     m_lastGameTickTime = now;
     m_gameTicks++;
 
-    tickTask(m_gameTimeTasks, m_gameTicks);
+    hasCalledTask = tickTask(m_gameTimeTasks, m_gameTicks) || hasCalledTask;
   }
+
+  return hasCalledTask;
 }
 
 template <typename Queue> static bool removeTaskFromQueue(const GameClock::ClockTaskHndl hndl, Queue &queue)
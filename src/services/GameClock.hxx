@@ -47,8 +47,9 @@ public:
   /**
   * @brief This function provide the tick for both clocks.
   * It must be called frequently. Call frequency determines clock precision.
+  * @return true if the callback of any task has been called.
   */
-  void tick(void);
+  bool tick(void);
 
   /**
   * @brief Add new real time clock task.
@@ -142,8 +143,9 @@ private:
   * @brief Tick clock for given task type.
   * @param queue Priority queue of tasks.
   * @param now The time point when tick occurred.
+  * @return true if the callback of any task has been called.
   */
-  template <typename Task, typename Cmp, typename Now> void tickTask(PriorityQueue<Task, Cmp> &queue, Now now);
+  template <typename Task, typename Cmp, typename Now> bool tickTask(PriorityQueue<Task, Cmp> &queue, Now now);
 };
 
 #include "GameClock.inl.hxx"
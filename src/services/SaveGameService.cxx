@@ -0,0 +1,106 @@
+#include "SaveGameService.hxx"
+
+#include "LOG.hxx"
+
+SaveGameService::~SaveGameService()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_jobAdded.notify_all();
+
+  // the remaining savegames are still written
+  if (m_worker.joinable())
+  {
+    m_worker.join();
+  }
+}
+
+void SaveGameService::save(SaveGameSnapshot &&snapshot, const std::string &filePath, SaveGameFormat format,
+                           Callback onCompletion)
+{
+  // std::function has to be copyable, so the snapshot can't be captured by a unique_ptr
+  auto pSnapshot = std::make_shared<SaveGameSnapshot>(std::move(snapshot));
+  enqueue([pSnapshot, filePath, format]() { pSnapshot->saveToFile(filePath, format); }, std::move(onCompletion));
+}
+
+void SaveGameService::enqueue(Task task, Callback onCompletion)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(SaveJob{std::move(task), std::move(onCompletion)});
+
+    if (!m_worker.joinable())
+    {
+      m_worker = std::thread(&SaveGameService::runWorker, this);
+    }
+  }
+  m_jobAdded.notify_one();
+}
+
+void SaveGameService::dispatchCompletions()
+{
+  std::vector<Completion> completions;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    completions.swap(m_completions);
+  }
+
+  for (const Completion &completion : completions)
+  {
+    if (completion.onCompletion)
+    {
+      completion.onCompletion(completion.error);
+    }
+  }
+}
+
+void SaveGameService::waitForSaves()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_jobDone.wait(lock, [this]() { return m_jobs.empty() && !m_isWriting; });
+}
+
+bool SaveGameService::isSaving() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return !m_jobs.empty() || m_isWriting;
+}
+
+void SaveGameService::runWorker()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true)
+  {
+    m_jobAdded.wait(lock, [this]() { return !m_jobs.empty() || m_isStopping; });
+    if (m_jobs.empty())
+    {
+      return;
+    }
+
+    SaveJob job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    m_isWriting = true;
+    lock.unlock();
+
+    std::string error;
+    try
+    {
+      job.task();
+    }
+    catch (const std::exception &exception)
+    {
+      error = exception.what();
+      LOG(LOG_ERROR) << "Could not save the game: " << error;
+    }
+    // snapshots can be large, free them before the next job is taken
+    job.task = nullptr;
+
+    lock.lock();
+    m_completions.push_back(Completion{std::move(job.onCompletion), std::move(error)});
+    m_isWriting = false;
+    m_jobDone.notify_all();
+  }
+}
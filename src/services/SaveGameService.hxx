@@ -0,0 +1,92 @@
+#ifndef SAVE_GAME_SERVICE_HXX_
+#define SAVE_GAME_SERVICE_HXX_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../engine/map/SaveGameSnapshot.hxx"
+#include "../util/Singleton.hxx"
+
+/**
+ * @brief Save game service. Writes savegames on a worker thread.
+ * The game thread only takes a SaveGameSnapshot of the map, which is a copy of a few compact arrays. Serializing,
+ * compressing and writing the snapshot happens on the worker thread, so saving doesn't stall the game loop.
+ * Savegames are written in the order they're requested. The callbacks of finished saves are called on the game thread
+ * by dispatchCompletions().
+ */
+class SaveGameService : public Singleton<SaveGameService>
+{
+public:
+  /**
+   * @brief Called when a savegame has been written or failed to
+   * @param error empty if the savegame has been written, otherwise the reason it failed
+   */
+  using Callback = std::function<void(const std::string &error)>;
+
+  /// Writes a file, throws an exception derived from std::exception if it fails
+  using Task = std::function<void()>;
+
+  ~SaveGameService();
+
+  /**
+   * @brief Save a snapshot on the worker thread
+   * @param snapshot the map state to save
+   * @param filePath full path of the savegame, it's replaced once the new one is written completely
+   * @param format the file format
+   * @param onCompletion called by dispatchCompletions() after the savegame has been written
+   */
+  void save(SaveGameSnapshot &&snapshot, const std::string &filePath, SaveGameFormat format, Callback onCompletion);
+
+  /**
+   * @brief Run a task on the worker thread, in order with the savegames
+   * For other files that belong to savegames, e.g. a SaveGameJournal.
+   * @param task the task to run, everything it captures is freed once it's done
+   * @param onCompletion called by dispatchCompletions() after the task has been run
+   */
+  void enqueue(Task task, Callback onCompletion);
+
+  /**
+   * @brief Call the callbacks of all saves that finished since the last call
+   * Meant to be called by the game loop every frame.
+   */
+  void dispatchCompletions();
+
+  /// Wait until all requested savegames have been written, e.g. before loading one of them or quitting
+  void waitForSaves();
+
+  /// Check if a savegame is waiting to be written or being written
+  bool isSaving() const;
+
+private:
+  struct SaveJob
+  {
+    Task task;
+    Callback onCompletion;
+  };
+
+  struct Completion
+  {
+    Callback onCompletion;
+    std::string error;
+  };
+
+  void runWorker();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_jobAdded;
+  std::condition_variable m_jobDone;
+  std::deque<SaveJob> m_jobs;
+  /// a job has been taken from the queue and is being written
+  bool m_isWriting = false;
+  bool m_isStopping = false;
+  std::vector<Completion> m_completions;
+  std::thread m_worker;
+};
+
+#endif
@@ -39,6 +39,19 @@ std::vector<std::string> getSaveGamePaths();
 
 bool fileExists(const std::string &filePath);
 
+/** @brief Create a directory and all of its missing parent directories
+ * @param directory Path of the directory, unlike the other functions it is not relative to the base path
+ * @returns true if the directory exists afterwards
+ */
+bool createDirectories(const std::string &directory);
+
+/** @brief Append a file name to a directory path
+ * @param directory Path of the directory
+ * @param fileName Name of the file in the directory
+ * @returns the path of the file, with a separator between the directory and the file name
+ */
+std::string joinPath(const std::string &directory, const std::string &fileName);
+
 /** @brief Get Base Path (where cytopia is being run)
  * A wrapper for SDL_GetBasePath, which is not run on Android because it hard-crashes the app. Memory is freed after the call.
  * @returns the Base path
@@ -0,0 +1,52 @@
+#ifndef FIXED_VECTOR_HXX_
+#define FIXED_VECTOR_HXX_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+/**
+  * @brief A vector with a capacity that is fixed at compile time.
+  * The elements are stored inline, so it never allocates and can be returned by value from hot code paths.
+  * Pushing more elements than the capacity is a programming error.
+  */
+template <typename T, std::size_t Capacity> class FixedVector
+{
+public:
+  using Container = std::array<T, Capacity>;
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = typename Container::iterator;
+  using const_iterator = typename Container::const_iterator;
+
+  static constexpr size_type capacity() noexcept { return Capacity; }
+
+  size_type size() const noexcept { return m_size; }
+  bool empty() const noexcept { return m_size == 0; }
+  void clear() noexcept { m_size = 0; }
+
+  void push_back(const value_type &element)
+  {
+    assert(m_size < Capacity);
+    m_elements[m_size++] = element;
+  }
+
+  reference operator[](size_type index) { return m_elements[index]; }
+  const_reference operator[](size_type index) const { return m_elements[index]; }
+
+  reference front() { return m_elements[0]; }
+  const_reference front() const { return m_elements[0]; }
+
+  iterator begin() noexcept { return m_elements.begin(); }
+  const_iterator begin() const noexcept { return m_elements.begin(); }
+  iterator end() noexcept { return m_elements.begin() + m_size; }
+  const_iterator end() const noexcept { return m_elements.begin() + m_size; }
+
+private:
+  Container m_elements{};
+  size_type m_size = 0;
+};
+
+#endif
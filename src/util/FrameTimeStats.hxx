@@ -0,0 +1,58 @@
+#ifndef FRAME_TIME_STATS_HXX_
+#define FRAME_TIME_STATS_HXX_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+/**
+  * @brief Keeps the durations of the most recent frames to report percentiles
+  * Only the last sampleCount durations are kept, older ones are overwritten. Not thread safe.
+  */
+class FrameTimeStats
+{
+public:
+  /// Number of frames the percentiles are calculated from
+  static constexpr size_t sampleCount = 256;
+
+  /** @brief Add the duration of a frame
+    * @param milliseconds duration of the frame
+    */
+  void add(double milliseconds)
+  {
+    m_samples[m_next] = milliseconds;
+    m_next = (m_next + 1) % sampleCount;
+    m_count = std::min(m_count + 1, sampleCount);
+  }
+
+  /** @brief Get a percentile of the recent frame durations
+    * @param percentile the percentile between 0 and 100, e.g. 99 for the duration 99% of the frames stay below
+    * @return the duration in milliseconds or 0 if there are no samples
+    */
+  double percentile(double percentile) const
+  {
+    if (m_count == 0)
+    {
+      return 0;
+    }
+
+    std::array<double, sampleCount> sorted;
+    std::copy(m_samples.begin(), m_samples.begin() + m_count, sorted.begin());
+    const size_t rank =
+        std::min(static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count))), m_count);
+    const size_t index = (rank > 0) ? rank - 1 : 0;
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.begin() + m_count);
+    return sorted[index];
+  }
+
+  /// Number of durations the percentiles are calculated from
+  size_t size() const { return m_count; }
+
+private:
+  std::array<double, sampleCount> m_samples{};
+  size_t m_next = 0;
+  size_t m_count = 0;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "MappedFile.hxx"
+
+#include <fstream>
+
+#include "Exception.hxx"
+#include "LOG.hxx"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string &filePath)
+{
+#ifdef _WIN32
+  HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    throw ConfigurationError(TRACE_INFO "Can't open file " + filePath);
+  }
+
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+  {
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    // the view keeps the mapping and the file open, the handles aren't needed anymore
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping)
+    {
+      m_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+#else
+  const int file = open(filePath.c_str(), O_RDONLY);
+  if (file < 0)
+  {
+    throw ConfigurationError(TRACE_INFO "Can't open file " + filePath);
+  }
+
+  struct stat fileStatus;
+  if (fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0)
+  {
+    m_size = static_cast<size_t>(fileStatus.st_size);
+    // the mapping keeps the file open, the descriptor isn't needed anymore
+    void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    m_mapping = (mapping != MAP_FAILED) ? mapping : nullptr;
+  }
+  close(file);
+#endif
+
+  if (m_mapping)
+  {
+    m_data = static_cast<const char *>(m_mapping);
+  }
+  else
+  {
+    readFile(filePath);
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  if (!m_mapping)
+  {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapping);
+#else
+  munmap(m_mapping, m_size);
+#endif
+}
+
+void MappedFile::readFile(const std::string &filePath)
+{
+  std::ifstream stream(filePath, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+  if (!stream)
+  {
+    throw ConfigurationError(TRACE_INFO "Can't open file " + filePath);
+  }
+
+  m_buffer.resize(static_cast<size_t>(stream.tellg()));
+  stream.seekg(0);
+  if (!m_buffer.empty() && !stream.read(&m_buffer[0], static_cast<std::streamsize>(m_buffer.size())))
+  {
+    throw ConfigurationError(TRACE_INFO "Could not read file " + filePath);
+  }
+
+  if (!m_buffer.empty())
+  {
+    LOG(LOG_WARNING) << "Could not map the file " << filePath << " into memory, it has been read instead";
+  }
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
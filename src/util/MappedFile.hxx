@@ -0,0 +1,44 @@
+#ifndef MAPPEDFILE_HXX_
+#define MAPPEDFILE_HXX_
+
+#include <cstddef>
+#include <string>
+
+/** @brief Maps a file into memory read-only
+ * The pages of the file are only read from disk when they're accessed, so opening a large file costs the same as
+ * opening a small one. If the file can't be mapped, it's read into memory completely instead.
+ */
+class MappedFile
+{
+public:
+  /** @brief Map a file
+   * @param filePath full path of the file
+   * @throws ConfigurationError if the file can't be opened or read
+   */
+  explicit MappedFile(const std::string &filePath);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /// The contents of the file, they stay valid as long as the MappedFile exists
+  const char *data() const { return m_data; };
+
+  /// Size of the file in bytes
+  size_t size() const { return m_size; };
+
+  /// Check if the file is mapped, otherwise it has been read into memory
+  bool isMapped() const { return m_mapping != nullptr; };
+
+private:
+  /// Read the file into m_buffer
+  void readFile(const std::string &filePath);
+
+  const char *m_data = nullptr;
+  size_t m_size = 0;
+  /// the mapped view of the file, nullptr if it isn't mapped
+  void *m_mapping = nullptr;
+  std::string m_buffer;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef PARALLEL_FOR_HXX_
+#define PARALLEL_FOR_HXX_
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/**
+  * @brief Call a function for every index of a range, using all cores.
+  * The range is split into one contiguous block per thread, the calling thread processes the first block.
+  * Every index is processed exactly once, but in no particular order, so the function must only write data that
+  * belongs to its index. Exceptions are rethrown in the calling thread after all threads have finished.
+  * @param begin first index
+  * @param end index after the last one
+  * @param function callable with the signature void(size_t index)
+  * @param minBlockSize the smallest number of indices worth a thread of their own. Starting a thread costs more than
+  *        processing a small block, the default fits cheap functions like the update of a single map node.
+  */
+template <typename Function>
+void parallelFor(size_t begin, size_t end, const Function &function, size_t minBlockSize = 1024)
+{
+  const size_t count = (end > begin) ? end - begin : 0;
+  const size_t blockCount = std::max<size_t>(
+      std::min<size_t>(std::thread::hardware_concurrency(), count / std::max<size_t>(minBlockSize, 1)), 1);
+
+  if (blockCount == 1)
+  {
+    for (size_t index = begin; index < end; ++index)
+    {
+      function(index);
+    }
+    return;
+  }
+
+  const size_t blockSize = (count + blockCount - 1) / blockCount;
+  std::vector<std::exception_ptr> errors(blockCount);
+  auto processBlock = [&](size_t block)
+  {
+    try
+    {
+      const size_t blockEnd = std::min(begin + (block + 1) * blockSize, end);
+      for (size_t index = begin + block * blockSize; index < blockEnd; ++index)
+      {
+        function(index);
+      }
+    }
+    catch (...)
+    {
+      errors[block] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(blockCount - 1);
+  try
+  {
+    for (size_t block = 1; block < blockCount; ++block)
+    {
+      threads.emplace_back(processBlock, block);
+    }
+  }
+  catch (const std::system_error &)
+  {
+    // no more threads can be started, the remaining blocks are processed by the calling thread
+  }
+
+  for (size_t block = threads.size() + 1; block < blockCount; ++block)
+  {
+    processBlock(block);
+  }
+  processBlock(0);
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  for (const auto &error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+#endif
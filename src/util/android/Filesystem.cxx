@@ -61,6 +61,21 @@ std::vector<std::string> getSaveGamePaths() { LOG(LOG_ERROR) << "fs::getSaveGame
 
 bool fileExists(const std::string &filePath) { return true; }
 
+bool createDirectories(const std::string &directory)
+{
+  LOG(LOG_ERROR) << "fs::createDirectories() not implemented!";
+  return false;
+}
+
+std::string joinPath(const std::string &directory, const std::string &fileName)
+{
+  if (directory.empty() || directory.back() == '/')
+  {
+    return directory + fileName;
+  }
+  return directory + '/' + fileName;
+}
+
 std::string getBasePath() { return ""; }
 
 } // namespace fs
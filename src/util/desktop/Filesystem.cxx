@@ -106,6 +106,18 @@ std::vector<std::string> fs::getSaveGamePaths()
 
 bool fs::fileExists(const std::string &filePath) { return fs::exists(fs::path(filePath)); }
 
+bool fs::createDirectories(const std::string &directory)
+{
+  std::error_code error;
+  fs::create_directories(fs::path(directory), error);
+  return fs::is_directory(fs::path(directory), error);
+}
+
+std::string fs::joinPath(const std::string &directory, const std::string &fileName)
+{
+  return (fs::path(directory) / fileName).string();
+}
+
 std::string fs::getBasePath()
 {
   std::string sPath;
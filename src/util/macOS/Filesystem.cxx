@@ -3,6 +3,7 @@
 #include "LOG.hxx"
 
 #include <fstream>
+#include <sys/stat.h>
 
 #include <SDL.h>
 
@@ -70,6 +71,29 @@ std::vector<std::string> fs::getSaveGamePaths()
 
 bool fs::fileExists(const std::string &filePath) { return true; }
 
+bool fs::createDirectories(const std::string &directory)
+{
+  // create the parent directories first, one separator at a time
+  for (size_t separator = directory.find('/', 1); separator != std::string::npos;
+       separator = directory.find('/', separator + 1))
+  {
+    mkdir(directory.substr(0, separator).c_str(), 0755);
+  }
+  mkdir(directory.c_str(), 0755);
+
+  struct stat status;
+  return stat(directory.c_str(), &status) == 0 && S_ISDIR(status.st_mode);
+}
+
+std::string fs::joinPath(const std::string &directory, const std::string &fileName)
+{
+  if (directory.empty() || directory.back() == '/')
+  {
+    return directory + fileName;
+  }
+  return directory + '/' + fileName;
+}
+
 std::string fs::getBasePath()
 {
   std::string sPath;
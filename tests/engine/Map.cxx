@@ -0,0 +1,384 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "../../src/engine/Map.hxx"
+#include "../../src/engine/TileManager.hxx"
+#include "../../src/engine/basics/Camera.hxx"
+#include "../../src/engine/basics/isoMath.hxx"
+#include "../util/AllocationCounter.hxx"
+#include "Filesystem.hxx"
+#include "Settings.hxx"
+
+namespace
+{
+/** @brief Gives the tests access to what a map needs, the tile data and the spritesheets of the game's resources
+ * The resources are copied next to the test binary. The spritesheets are loaded by the software renderer of the
+ * headless mode, so no display is needed.
+ */
+class MapFixture
+{
+public:
+  MapFixture()
+  {
+    // only takes effect if the window manager hasn't been created by an earlier test yet
+    Settings::instance().headless = true;
+  }
+
+  /// Initialize every node of a map with a function of its coordinates, the nodes still have to be updated
+  template <typename InitializeNode> static void initializeNodes(Map &map, int mapSize, const InitializeNode &initializeNode)
+  {
+    for (int x = 0; x < mapSize; ++x)
+    {
+      for (int y = 0; y < mapSize; ++y)
+      {
+        initializeNode(map.getMapNode({x, y, 0, 0}), x, y);
+      }
+    }
+  }
+};
+} // namespace
+
+TEST_CASE_METHOD(MapFixture, "Benchmark findNodeInMap", "[engine][map][.benchmark]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  Map map(mapSize, mapSize);
+  Camera::instance().centerScreenOnMapCenter();
+  map.refresh();
+
+  // mouse positions that cover the whole screen
+  std::vector<SDL_Point> mousePositions;
+  for (int y = 0; y < Settings::instance().screenHeight; y += 8)
+  {
+    for (int x = 0; x < Settings::instance().screenWidth; x += 8)
+    {
+      mousePositions.push_back({x, y});
+    }
+  }
+
+  BENCHMARK("findNodeInMap")
+  {
+    int nodesFound = 0;
+    for (const auto &mousePosition : mousePositions)
+    {
+      nodesFound += map.findNodeInMap(mousePosition).x >= 0;
+    }
+    return nodesFound;
+  };
+}
+
+TEST_CASE_METHOD(MapFixture, "Benchmark updating node neighbors", "[engine][map][.benchmark]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  Map map(mapSize, mapSize);
+
+  const int brushSize = std::min(64, mapSize);
+  std::vector<Point> brush;
+  for (int x = 0; x < brushSize; ++x)
+  {
+    for (int y = 0; y < brushSize; ++y)
+    {
+      brush.push_back({x, y, 0, 0});
+    }
+  }
+
+  // raising and lowering keeps the terrain the same for every run
+  BENCHMARK("raise and lower terrain with a 64x64 brush")
+  {
+    for (const auto &point : brush)
+    {
+      map.increaseHeight(point);
+    }
+    for (const auto &point : brush)
+    {
+      map.decreaseHeight(point);
+    }
+  };
+
+  BENCHMARK("updateAllNodes") { map.updateAllNodes(); };
+  BENCHMARK("updateAllNodes one by one") { map.updateAllNodes(false); };
+}
+
+TEST_CASE_METHOD(MapFixture, "Updating all nodes in parallel gives the same result as one by one", "[engine][map]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  Map serialMap(mapSize, mapSize, false);
+  Map parallelMap(mapSize, mapSize, false);
+
+  // cliffs, pits and water, so heights have to be settled and every kind of tile map is used
+  initializeNodes(serialMap, mapSize,
+                  [&parallelMap](MapNode &serialNode, int x, int y)
+                  {
+                    const int height = ((x / 5 + y / 3) % 4) * 2 + ((x * 7 + y * 13) % 11 == 0 ? 3 : 0);
+                    serialNode.initialize(height, "terrain_grass", (x * y) % 17 == 1 ? "water" : "");
+
+                    // the same way a savegame is loaded, so tile indices that are picked randomly are the same
+                    MapNode &parallelNode = parallelMap.getMapNode({x, y, 0, 0});
+                    parallelNode.initialize(height, "");
+                    parallelNode.setMapNodeData(serialNode.getMapNodeData(), serialNode.getCoordinates());
+                  });
+
+  serialMap.updateAllNodes(false);
+  parallelMap.updateAllNodes();
+
+  for (int x = 0; x < mapSize; ++x)
+  {
+    for (int y = 0; y < mapSize; ++y)
+    {
+      const Point coordinates{x, y, 0, 0};
+      const MapNode &serialNode = serialMap.getMapNode(coordinates);
+      const MapNode &parallelNode = parallelMap.getMapNode(coordinates);
+
+      REQUIRE(serialNode.getCoordinates().height == parallelNode.getCoordinates().height);
+      REQUIRE(serialNode.getElevationBitmask() == parallelNode.getElevationBitmask());
+
+      for (auto layer : allLayersOrdered)
+      {
+        const MapNodeData serialData = serialNode.getMapNodeDataForLayer(layer);
+        const MapNodeData parallelData = parallelNode.getMapNodeDataForLayer(layer);
+        REQUIRE(serialData.tileId == parallelData.tileId);
+        REQUIRE(serialData.tileIndex == parallelData.tileIndex);
+        REQUIRE(serialData.tileMap == parallelData.tileMap);
+
+        const SDL_Rect serialClipRect = serialNode.getSprite()->getClipRect(layer);
+        const SDL_Rect parallelClipRect = parallelNode.getSprite()->getClipRect(layer);
+        REQUIRE(SDL_RectEquals(&serialClipRect, &parallelClipRect));
+      }
+    }
+  }
+}
+
+TEST_CASE_METHOD(MapFixture, "Hovering over the map doesn't allocate", "[engine][map]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  Map map(mapSize, mapSize);
+  Camera::instance().centerScreenOnMapCenter();
+  map.refresh();
+
+  const TileId tileToPlace = TileManager::instance().getTileId("BD_2x1_Billboard");
+  REQUIRE(tileToPlace != EMPTY_TILE_ID);
+
+  std::vector<SDL_Point> mousePositions;
+  for (int y = 0; y < Settings::instance().screenHeight; y += 8)
+  {
+    for (int x = 0; x < Settings::instance().screenWidth; x += 8)
+    {
+      mousePositions.push_back({x, y});
+    }
+  }
+
+  // the same steps as the EventManager takes to highlight the nodes under the mouse
+  std::vector<Point> nodesToHighlight;
+  bool placementAllowed = false;
+  auto hoverOverMap = [&]()
+  {
+    for (const auto &mousePosition : mousePositions)
+    {
+      for (const auto &node : nodesToHighlight)
+      {
+        map.unHighlightNode(node);
+      }
+
+      const Point mouseIsoCoords = map.findNodeInMap(mousePosition, Layer::TERRAIN);
+      const TileFootprint footprint = TileManager::instance().getTargetCoordsOfTileID(mouseIsoCoords, tileToPlace);
+      nodesToHighlight.assign(footprint.begin(), footprint.end());
+
+      for (const auto &node : nodesToHighlight)
+      {
+        placementAllowed = map.isPlacementOnNodeAllowed(node, tileToPlace);
+        map.highlightNode(node, placementAllowed ? SpriteHighlightColor::GRAY : SpriteHighlightColor::RED);
+        map.findNodeInMap(convertIsoToScreenCoordinates(node), Layer::BUILDINGS);
+      }
+    }
+  };
+
+  // the first pass grows the buffers, in the steady state they're reused
+  hoverOverMap();
+
+  AllocationCounter allocationCounter;
+  hoverOverMap();
+  const size_t allocations = allocationCounter.stop();
+
+  CHECK(allocations == 0);
+}
+
+TEST_CASE_METHOD(MapFixture, "Recoloring changed minimap nodes gives the same image as recoloring all nodes", "[engine][map]")
+{
+  const int mapSize = 32;
+  Map map(mapSize, mapSize, false);
+  initializeNodes(map, mapSize,
+                  [](MapNode &node, int x, int y)
+                  { node.initialize((x + y) % 3, "terrain_grass", (x * y) % 13 == 1 ? "water" : ""); });
+  map.updateAllNodes();
+
+  Minimap &minimap = map.getMinimap();
+  minimap.update(nullptr);
+
+  map.setTileID("road_dirt", std::vector<Point>{{4, 4, 0, 0}, {4, 5, 0, 0}, {4, 6, 0, 0}});
+  map.increaseHeight({10, 10, 0, 0});
+  map.demolishNode({{4, 5, 0, 0}});
+  minimap.setLayers((1U << Layer::TERRAIN) | (1U << Layer::ROAD));
+  minimap.update(nullptr);
+
+  std::vector<uint8_t> incremental(minimap.pixel(0), minimap.pixel(0) + mapSize * mapSize * 4);
+  minimap.markAllDirty();
+  minimap.update(nullptr);
+  std::vector<uint8_t> full(minimap.pixel(0), minimap.pixel(0) + mapSize * mapSize * 4);
+
+  CHECK(incremental == full);
+}
+
+TEST_CASE_METHOD(MapFixture, "Demolishing a building damages the screen where it has been drawn", "[engine][map]")
+{
+  const int mapSize = 32;
+  Map map(mapSize, mapSize, false);
+  initializeNodes(map, mapSize, [](MapNode &node, int, int) { node.initialize(0, "terrain_grass"); });
+  map.updateAllNodes();
+
+  const Point buildingCoordinates{10, 10, 0, 0};
+  map.setTileID("BD_2x2_FancyTentLarge", buildingCoordinates);
+  map.refresh();
+  map.takeDamage();
+
+  SDL_Rect buildingRect = map.getMapNode(buildingCoordinates).getSprite()->getWorldBoundingBox(1U << Layer::BUILDINGS);
+  buildingRect.x -= Camera::instance().cameraOffset().x;
+  buildingRect.y -= Camera::instance().cameraOffset().y;
+  REQUIRE_FALSE(SDL_RectEmpty(&buildingRect));
+
+  map.demolishNode({buildingCoordinates});
+  map.refresh();
+  const DamageRegion damage = map.takeDamage();
+  REQUIRE_FALSE(damage.isFull());
+
+  // the damaged rects don't overlap, so they cover the old rect of the building if their intersections add up to it
+  int coveredArea = 0;
+  for (const SDL_Rect &damagedRect : damage.getRects())
+  {
+    SDL_Rect intersection;
+    if (SDL_IntersectRect(&damagedRect, &buildingRect, &intersection))
+    {
+      coveredArea += intersection.w * intersection.h;
+    }
+  }
+  CHECK(coveredArea == buildingRect.w * buildingRect.h);
+}
+
+TEST_CASE_METHOD(MapFixture, "Saved maps are loaded the same in both savegame formats", "[engine][map]")
+{
+  const int mapSize = 48;
+  Map map(mapSize, mapSize, false);
+  initializeNodes(map, mapSize,
+                  [](MapNode &node, int x, int y)
+                  { node.initialize((x + y) % 5, "terrain_grass", (x * y) % 13 == 1 ? "water" : ""); });
+  map.setTileID("road_dirt", std::vector<Point>{{4, 4, 0, 0}, {4, 5, 0, 0}, {4, 6, 0, 0}});
+  map.updateAllNodes();
+
+  const std::string fileName = "savegame_format_test.cts";
+  for (const SaveGameFormat format : {SaveGameFormat::BINARY, SaveGameFormat::JSON})
+  {
+    map.saveMapToFile(fileName, format);
+    const std::unique_ptr<Map> loadedMap(Map::loadMapFromFile(fileName));
+    REQUIRE(loadedMap);
+
+    for (int x = 0; x < mapSize; ++x)
+    {
+      for (int y = 0; y < mapSize; ++y)
+      {
+        const MapNode &node = map.getMapNode({x, y, 0, 0});
+        const MapNode &loadedNode = loadedMap->getMapNode({x, y, 0, 0});
+        REQUIRE(node.getCoordinates().height == loadedNode.getCoordinates().height);
+
+        for (auto layer : allLayersOrdered)
+        {
+          const MapNodeData data = node.getMapNodeDataForLayer(layer);
+          const MapNodeData loadedData = loadedNode.getMapNodeDataForLayer(layer);
+          REQUIRE(data.tileId == loadedData.tileId);
+          REQUIRE(data.tileIndex == loadedData.tileIndex);
+          REQUIRE(data.origCornerPoint == loadedData.origCornerPoint);
+          REQUIRE(data.shouldRender == loadedData.shouldRender);
+        }
+      }
+    }
+  }
+  std::remove((fs::getBasePath() + fileName).c_str());
+}
+
+TEST_CASE_METHOD(MapFixture, "Changes in the journal of a savegame are replayed when it's loaded", "[engine][map]")
+{
+  const int mapSize = 48;
+  Map map(mapSize, mapSize);
+
+  const std::string fileName = "savegame_journal_test.cts";
+  const std::string filePath = fs::getBasePath() + fileName;
+  const std::string journalPath = SaveGameJournal::journalPath(filePath);
+  map.saveMapToFile(fileName);
+  map.markChangesSaved();
+  SaveGameJournal::create(journalPath, {SaveGameJournal::fileChecksum(filePath), mapSize, mapSize},
+                          TileManager::instance().getTileIDStrings());
+
+  map.setTileID("road_dirt", std::vector<Point>{{4, 4, 0, 0}, {4, 5, 0, 0}, {4, 6, 0, 0}});
+  map.increaseHeight({10, 10, 0, 0});
+  REQUIRE(map.hasUnsavedChanges());
+  SaveGameJournal::append(journalPath, map.takeUnsavedChanges());
+  CHECK_FALSE(map.hasUnsavedChanges());
+
+  map.demolishNode({{4, 5, 0, 0}});
+  map.decreaseHeight({20, 20, 0, 0});
+  SaveGameJournal::append(journalPath, map.takeUnsavedChanges());
+
+  const std::unique_ptr<Map> loadedMap(Map::loadMapFromFile(fileName));
+  REQUIRE(loadedMap);
+  CHECK_FALSE(loadedMap->hasUnsavedChanges());
+
+  for (int x = 0; x < mapSize; ++x)
+  {
+    for (int y = 0; y < mapSize; ++y)
+    {
+      const MapNode &node = map.getMapNode({x, y, 0, 0});
+      const MapNode &loadedNode = loadedMap->getMapNode({x, y, 0, 0});
+      REQUIRE(node.getCoordinates().height == loadedNode.getCoordinates().height);
+
+      for (auto layer : allLayersOrdered)
+      {
+        const MapNodeData data = node.getMapNodeDataForLayer(layer);
+        const MapNodeData loadedData = loadedNode.getMapNodeDataForLayer(layer);
+        REQUIRE(data.tileId == loadedData.tileId);
+        REQUIRE(data.tileIndex == loadedData.tileIndex);
+        REQUIRE(data.origCornerPoint == loadedData.origCornerPoint);
+      }
+    }
+  }
+
+  // a journal of another version of the savegame is ignored
+  map.saveMapToFile(fileName);
+  loadedMap->increaseHeight({30, 30, 0, 0});
+  SaveGameJournal::append(journalPath, loadedMap->takeUnsavedChanges());
+  const std::unique_ptr<Map> reloadedMap(Map::loadMapFromFile(fileName));
+  CHECK(reloadedMap->getMapNode({30, 30, 0, 0}).getCoordinates().height ==
+        map.getMapNode({30, 30, 0, 0}).getCoordinates().height);
+
+  std::remove(filePath.c_str());
+  std::remove(journalPath.c_str());
+}
+
+TEST_CASE_METHOD(MapFixture, "Benchmark saving and loading maps", "[engine][map][.benchmark]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  Map map(mapSize, mapSize);
+
+  const std::string fileName = "savegame_benchmark.cts";
+  BENCHMARK("save binary") { map.saveMapToFile(fileName, SaveGameFormat::BINARY); };
+  // binary savegames are loaded lazily, the first frame only needs the chunks on screen
+  BENCHMARK("open binary lazily") { return std::unique_ptr<Map>(Map::loadMapFromFile(fileName)); };
+  BENCHMARK("load binary")
+  {
+    std::unique_ptr<Map> loadedMap(Map::loadMapFromFile(fileName));
+    loadedMap->getMapNodes();
+    return loadedMap;
+  };
+  BENCHMARK("save json") { map.saveMapToFile(fileName, SaveGameFormat::JSON); };
+  BENCHMARK("load json") { return std::unique_ptr<Map>(Map::loadMapFromFile(fileName)); };
+  std::remove((fs::getBasePath() + fileName).c_str());
+}
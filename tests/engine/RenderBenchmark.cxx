@@ -0,0 +1,28 @@
+#include <catch.hpp>
+#include "../../src/engine/RenderBenchmark.hxx"
+
+#include "SDL.h"
+
+TEST_CASE("Count the pixels that differ from a reference frame", "[engine][render]")
+{
+  SDL_Surface *image = SDL_CreateRGBSurfaceWithFormat(0, 4, 3, 32, SDL_PIXELFORMAT_RGBA32);
+  SDL_Surface *reference = SDL_CreateRGBSurfaceWithFormat(0, 4, 3, 32, SDL_PIXELFORMAT_RGBA32);
+  REQUIRE(image != nullptr);
+  REQUIRE(reference != nullptr);
+
+  SDL_FillRect(image, nullptr, SDL_MapRGBA(image->format, 10, 20, 30, 255));
+  SDL_FillRect(reference, nullptr, SDL_MapRGBA(reference->format, 10, 20, 30, 255));
+  CHECK(RenderBenchmark::countDifferentPixels(image, reference) == 0);
+
+  const SDL_Rect changedArea{1, 1, 2, 1};
+  SDL_FillRect(image, &changedArea, SDL_MapRGBA(image->format, 10, 20, 31, 255));
+  CHECK(RenderBenchmark::countDifferentPixels(image, reference) == 2);
+
+  SDL_Surface *largerReference = SDL_CreateRGBSurfaceWithFormat(0, 5, 3, 32, SDL_PIXELFORMAT_RGBA32);
+  CHECK(RenderBenchmark::countDifferentPixels(image, largerReference) == 15);
+  CHECK(RenderBenchmark::countDifferentPixels(image, nullptr) == 12);
+
+  SDL_FreeSurface(largerReference);
+  SDL_FreeSurface(reference);
+  SDL_FreeSurface(image);
+}
@@ -23,10 +23,10 @@ TEST_CASE("Get Tile Texture", "[engine][resourcesmanager]")
   REQUIRE_THROWS_AS(ResourcesManager::instance().getTileTexture("UNLOADED"), UIError);
 }
 
-TEST_CASE("Get Tile Surface", "[engine][resourcesmanager]")
+TEST_CASE("Get Tile Hit Mask", "[engine][resourcesmanager]")
 {
-  REQUIRE_THROWS_AS(ResourcesManager::instance().getTileSurface("UNLOADED"), UIError);
-  REQUIRE_THROWS_AS(ResourcesManager::instance().getTileSurface("UNLOADED"), UIError);
+  REQUIRE_THROWS_AS(ResourcesManager::instance().getTileHitMask("UNLOADED"), UIError);
+  REQUIRE_THROWS_AS(ResourcesManager::instance().getTileHitMask("UNLOADED"), UIError);
 }
 
 TEST_CASE("Load Texture", "[engine][resourcesmanager]")
@@ -0,0 +1,60 @@
+#include <catch.hpp>
+#include <algorithm>
+
+#include "../../src/engine/basics/PointFunctions.hxx"
+#include "../../util/AllocationCounter.hxx"
+#include "Settings.hxx"
+
+TEST_CASE("Get the neighbors of a node", "[engine][basics]")
+{
+  const Point center{5, 5, 0, 0};
+
+  SECTION("The neighbors are in the order of the offset table")
+  {
+    const Neighborhood neighbors = PointFunctions::getNeighbors(center, true);
+    REQUIRE(neighbors.size() == neighborOffsets.size());
+
+    for (size_t i = 0; i < neighbors.size(); ++i)
+    {
+      CHECK(neighbors[i].x == center.x + neighborOffsets[i].x);
+      CHECK(neighbors[i].y == center.y + neighborOffsets[i].y);
+      CHECK(PointFunctions::getNeighborPositionToOrigin(neighbors[i], center)._to_integral() == neighborOffsets[i].position);
+    }
+  }
+
+  SECTION("The central node can be left out")
+  {
+    const Neighborhood neighbors = PointFunctions::getNeighbors(center, false);
+    CHECK(neighbors.size() == 8);
+    CHECK(std::find(neighbors.begin(), neighbors.end(), center) == neighbors.end());
+  }
+
+  SECTION("Nodes outside of the map are left out")
+  {
+    CHECK(PointFunctions::getNeighbors({0, 0, 0, 0}, true).size() == 4);
+    CHECK(PointFunctions::getNeighbors({0, 5, 0, 0}, false).size() == 5);
+  }
+}
+
+TEST_CASE("Neighborhood queries don't allocate", "[engine][basics]")
+{
+  const int mapSize = Settings::instance().mapSize;
+  unsigned int bitmask = 0;
+
+  AllocationCounter allocationCounter;
+  for (int x = 0; x < mapSize; ++x)
+  {
+    for (int y = 0; y < mapSize; ++y)
+    {
+      const Point center{x, y, 0, 0};
+      for (const auto &neighbor : PointFunctions::getNeighbors(center, false))
+      {
+        bitmask |= PointFunctions::getNeighborPositionToOrigin(neighbor, center);
+      }
+    }
+  }
+  const size_t allocations = allocationCounter.stop();
+
+  CHECK(allocations == 0);
+  CHECK(bitmask == 0xFF);
+}
@@ -0,0 +1,139 @@
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/engine/map/BinarySaveGame.hxx"
+#include "Exception.hxx"
+
+namespace
+{
+/// A chunk with different values in every column
+BinarySaveGame::Chunk makeChunk(int firstNode, int nodeCount)
+{
+  BinarySaveGame::Chunk chunk;
+  chunk.firstNode = firstNode;
+  chunk.resize(nodeCount);
+  for (int i = 0; i < nodeCount; ++i)
+  {
+    chunk.heights[i] = static_cast<uint8_t>(i % 32);
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      chunk.tileRefs[layer][i] = static_cast<uint16_t>((i + layer) % 3);
+      chunk.tileIndices[layer][i] = static_cast<uint16_t>(i * layer);
+      chunk.origCornerIndices[layer][i] = (i % 7 == 0) ? -1 : firstNode + i - static_cast<int>(layer % 2);
+    }
+  }
+  return chunk;
+}
+
+bool isEqual(const BinarySaveGame::Chunk &a, const BinarySaveGame::Chunk &b)
+{
+  return a.firstNode == b.firstNode && a.nodeCount == b.nodeCount && a.heights == b.heights &&
+         a.tileRefs == b.tileRefs && a.tileIndices == b.tileIndices && a.origCornerIndices == b.origCornerIndices;
+}
+
+std::string writeSaveGame(const std::vector<BinarySaveGame::Chunk> &chunks)
+{
+  std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
+  BinarySaveGame::Header header;
+  header.saveGameVersion = 4;
+  header.columns = 100;
+  header.rows = 100;
+  header.chunkCount = static_cast<uint32_t>(chunks.size());
+
+  BinarySaveGame::Writer writer(stream, header, {"", "terrain_grass", "road"});
+  for (const BinarySaveGame::Chunk &chunk : chunks)
+  {
+    writer.writeChunk(chunk);
+  }
+  return stream.str();
+}
+} // namespace
+
+TEST_CASE("Binary savegames keep all columns", "[engine][map][savegame]")
+{
+  const std::vector<BinarySaveGame::Chunk> chunks{makeChunk(0, 8192), makeChunk(8192, 1808)};
+  std::istringstream stream(writeSaveGame(chunks), std::ios_base::in | std::ios_base::binary);
+
+  REQUIRE(BinarySaveGame::isBinarySaveGame(stream));
+  BinarySaveGame::Reader reader(stream);
+  CHECK(reader.getHeader().saveGameVersion == 4);
+  CHECK(reader.getHeader().columns == 100);
+  CHECK(reader.getHeader().rows == 100);
+  CHECK(reader.getTileIDs() == std::vector<std::string>{"", "terrain_grass", "road"});
+
+  BinarySaveGame::Chunk chunk;
+  for (const BinarySaveGame::Chunk &expected : chunks)
+  {
+    REQUIRE(reader.readChunk(chunk));
+    CHECK(isEqual(chunk, expected));
+  }
+  CHECK_FALSE(reader.readChunk(chunk));
+}
+
+TEST_CASE("Binary savegames in memory are decoded in any order", "[engine][map][savegame]")
+{
+  const std::vector<BinarySaveGame::Chunk> chunks{makeChunk(0, 8192), makeChunk(8192, 1000), makeChunk(9192, 808)};
+  const std::string saveGame = writeSaveGame(chunks);
+
+  BinarySaveGame::MemoryReader reader(saveGame.data(), saveGame.size());
+  CHECK(reader.getHeader().saveGameVersion == 4);
+  CHECK(reader.getTileIDs() == std::vector<std::string>{"", "terrain_grass", "road"});
+  REQUIRE(reader.getChunkCount() == chunks.size());
+
+  BinarySaveGame::Chunk chunk;
+  for (size_t chunkNumber : {2, 0, 1})
+  {
+    reader.readChunk(chunkNumber, chunk);
+    CHECK(isEqual(chunk, chunks[chunkNumber]));
+  }
+}
+
+TEST_CASE("Damaged binary savegames are rejected", "[engine][map][savegame]")
+{
+  const std::string saveGame = writeSaveGame({makeChunk(0, 1000)});
+  BinarySaveGame::Chunk chunk;
+
+  SECTION("Other files aren't binary savegames")
+  {
+    std::istringstream stream("{\"Savegame version\": 4}");
+    CHECK_FALSE(BinarySaveGame::isBinarySaveGame(stream));
+    CHECK_THROWS_AS(BinarySaveGame::Reader(stream), ConfigurationError);
+  }
+
+  SECTION("A flipped bit fails the checksum")
+  {
+    std::string damaged = saveGame;
+    damaged[damaged.size() - 10] ^= 0x10;
+    std::istringstream stream(damaged, std::ios_base::in | std::ios_base::binary);
+    BinarySaveGame::Reader reader(stream);
+    CHECK_THROWS_AS(reader.readChunk(chunk), ConfigurationError);
+  }
+
+  SECTION("A truncated file is detected")
+  {
+    std::istringstream stream(saveGame.substr(0, saveGame.size() - 1), std::ios_base::in | std::ios_base::binary);
+    BinarySaveGame::Reader reader(stream);
+    CHECK_THROWS_AS(reader.readChunk(chunk), ConfigurationError);
+  }
+
+  SECTION("A truncated file is detected before decoding chunks from memory")
+  {
+    CHECK_THROWS_AS(BinarySaveGame::MemoryReader(saveGame.data(), saveGame.size() - 1), ConfigurationError);
+  }
+
+  SECTION("A flipped bit fails the checksum of a chunk in memory")
+  {
+    std::string damaged = saveGame;
+    damaged[damaged.size() - 10] ^= 0x10;
+    BinarySaveGame::MemoryReader reader(damaged.data(), damaged.size());
+    CHECK_THROWS_AS(reader.readChunk(0, chunk), ConfigurationError);
+  }
+
+  SECTION("Overlapping chunks are rejected")
+  {
+    const std::string overlapping = writeSaveGame({makeChunk(0, 1000), makeChunk(500, 1000)});
+    CHECK_THROWS_AS(BinarySaveGame::MemoryReader(overlapping.data(), overlapping.size()), ConfigurationError);
+  }
+}
@@ -0,0 +1,175 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/engine/basics/ZlibStream.hxx"
+#include "../../../src/engine/map/JsonSaveGame.hxx"
+#include "../../util/PeakMemory.hxx"
+#include "json.hxx"
+
+using json = nlohmann::json;
+
+namespace
+{
+const std::vector<std::string> tileIDs{"", "terrain_grass", "road \"dirt\""};
+
+/// A node with different values in every layer
+JsonSaveGame::Node makeNode(int x, int y)
+{
+  JsonSaveGame::Node node;
+  node.coordinates = {x, y, x + y, (x * y) % 32};
+  for (size_t layer = 0; layer < node.layers.size(); ++layer)
+  {
+    node.layers[layer].tileRef = static_cast<uint16_t>((x + y + layer) % tileIDs.size());
+    node.layers[layer].tileIndex = static_cast<int32_t>(x * layer);
+    if ((x + layer) % 3 == 0)
+    {
+      node.layers[layer].origCornerPoint = {x, y, 0, 0};
+    }
+  }
+  return node;
+}
+
+/// Write a savegame with all nodes of a map through a zlib stream
+void writeSaveGame(std::ostream &stream, int columns, int rows)
+{
+  DeflateStreamBuf deflateBuffer(stream);
+  std::ostream compressedStream(&deflateBuffer);
+
+  JsonSaveGame::Writer writer(compressedStream, {4, columns, rows}, tileIDs);
+  for (int x = 0; x < rows; ++x)
+  {
+    for (int y = 0; y < columns; ++y)
+    {
+      writer.writeNode(makeNode(x, y));
+    }
+  }
+  writer.finish();
+  compressedStream.flush();
+  deflateBuffer.finish();
+}
+
+/// Read a savegame through a zlib stream and check that every node is the same as written
+int readSaveGame(std::istream &stream, int columns, int rows)
+{
+  InflateStreamBuf inflateBuffer(stream);
+  std::istream decompressedStream(&inflateBuffer);
+
+  bool isHeaderRead = false;
+  int nodeCount = 0;
+  int mismatches = 0;
+  JsonSaveGame::read(
+      decompressedStream,
+      [&](const JsonSaveGame::Header &header) {
+        isHeaderRead = true;
+        mismatches += header.saveGameVersion != 4 || header.columns != columns || header.rows != rows;
+      },
+      [&](const JsonSaveGame::Node &node, const std::vector<std::string> &nodeTileIDs) {
+        mismatches += !isHeaderRead;
+        const JsonSaveGame::Node expected = makeNode(node.coordinates.x, node.coordinates.y);
+        mismatches += node.coordinates.z != expected.coordinates.z || node.coordinates.height != expected.coordinates.height;
+        for (size_t layer = 0; layer < node.layers.size(); ++layer)
+        {
+          const JsonSaveGame::NodeLayer &nodeLayer = node.layers[layer];
+          const JsonSaveGame::NodeLayer &expectedLayer = expected.layers[layer];
+          mismatches += nodeTileIDs[nodeLayer.tileRef] != tileIDs[expectedLayer.tileRef] ||
+                        nodeLayer.tileIndex != expectedLayer.tileIndex ||
+                        nodeLayer.origCornerPoint != expectedLayer.origCornerPoint;
+        }
+        ++nodeCount;
+      });
+
+  CHECK(mismatches == 0);
+  return nodeCount;
+}
+} // namespace
+
+TEST_CASE("Json savegames are streamed node by node", "[engine][map][savegame]")
+{
+  std::stringstream stream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+  writeSaveGame(stream, 12, 7);
+  CHECK(readSaveGame(stream, 12, 7) == 12 * 7);
+}
+
+TEST_CASE("Json savegames written from a json document can be read", "[engine][map][savegame]")
+{
+  // json documents sort their keys, so the rows of the map only follow the nodes
+  json nodes = json::array();
+  for (int x = 0; x < 3; ++x)
+  {
+    for (int y = 0; y < 2; ++y)
+    {
+      const JsonSaveGame::Node node = makeNode(x, y);
+      json layers = json::array();
+      for (const JsonSaveGame::NodeLayer &layer : node.layers)
+      {
+        const Point &corner = layer.origCornerPoint;
+        layers.push_back({{"tileID", tileIDs[layer.tileRef]},
+                          {"tileIndex", layer.tileIndex},
+                          {"origCornerPoint", {{"x", corner.x}, {"y", corner.y}, {"z", corner.z}, {"height", corner.height}}}});
+      }
+      const Point &coordinates = node.coordinates;
+      nodes.push_back({{"coordinates",
+                        {{"x", coordinates.x}, {"y", coordinates.y}, {"z", coordinates.z}, {"height", coordinates.height}}},
+                       {"mapNodeData", layers}});
+    }
+  }
+  const json saveGame{{"Savegame version", 4}, {"columns", 2}, {"rows", 3}, {"mapNode", nodes}};
+
+  std::stringstream stream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+  {
+    DeflateStreamBuf deflateBuffer(stream);
+    std::ostream compressedStream(&deflateBuffer);
+    compressedStream << saveGame.dump();
+    compressedStream.flush();
+    deflateBuffer.finish();
+  }
+  // the old savegames end with a newline after the zlib stream
+  stream << std::endl;
+
+  CHECK(readSaveGame(stream, 2, 3) == 2 * 3);
+}
+
+TEST_CASE("Damaged json savegames are rejected", "[engine][map][savegame]")
+{
+  std::stringstream stream(std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+  writeSaveGame(stream, 12, 7);
+  const std::string saveGame = stream.str();
+
+  std::istringstream truncated(saveGame.substr(0, saveGame.size() / 2), std::ios_base::in | std::ios_base::binary);
+  CHECK_THROWS(readSaveGame(truncated, 12, 7));
+}
+
+TEST_CASE("Saving and loading json savegames needs memory for a chunk, not for the map", "[engine][map][savegame]")
+{
+  // 65536 nodes are about 90 MB of json, a json document of them takes several times that
+  const int mapSize = 256;
+  const std::string fileName = "json_savegame_memory_test.cts";
+
+  PeakMemory saveMemory;
+  if (!saveMemory.isSupported())
+  {
+    WARN("The peak resident set size can't be measured on this system");
+    return;
+  }
+  {
+    std::ofstream stream(fileName, std::ios_base::out | std::ios_base::binary);
+    writeSaveGame(stream, mapSize, mapSize);
+  }
+  const size_t saveGrowth = saveMemory.growth();
+
+  PeakMemory loadMemory;
+  {
+    std::ifstream stream(fileName, std::ios_base::in | std::ios_base::binary);
+    CHECK(readSaveGame(stream, mapSize, mapSize) == mapSize * mapSize);
+  }
+  const size_t loadGrowth = loadMemory.growth();
+  std::remove(fileName.c_str());
+
+  INFO("peak memory growth while saving: " << saveGrowth << " bytes, while loading: " << loadGrowth << " bytes");
+  CHECK(saveGrowth < 8 * 1024 * 1024);
+  CHECK(loadGrowth < 8 * 1024 * 1024);
+}
@@ -0,0 +1,131 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/engine/map/SaveGameJournal.hxx"
+#include "Exception.hxx"
+
+namespace
+{
+const std::string journalFile = "SaveGameJournalTest.cts.journal";
+
+/// A grid with different values in every attribute
+void fillGrid(MapGrid &grid, int seed)
+{
+  for (int index = 0; index < grid.nodeCount(); ++index)
+  {
+    grid.height(index) = static_cast<uint8_t>((index + seed) % 32);
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      grid.tileId(static_cast<Layer>(layer), index) = static_cast<TileId>((index + layer + seed) % 3);
+      grid.tileIndex(static_cast<Layer>(layer), index) = static_cast<uint16_t>(index * layer);
+      grid.origCornerIndex(static_cast<Layer>(layer), index) = (index % 7 == 0) ? -1 : index - static_cast<int>(layer % 2);
+    }
+  }
+}
+
+bool isEqual(const SaveGameJournal::Batch &a, const SaveGameJournal::Batch &b)
+{
+  return a.nodeIndices == b.nodeIndices && a.heights == b.heights && a.tileRefs == b.tileRefs &&
+         a.tileIndices == b.tileIndices && a.origCornerIndices == b.origCornerIndices;
+}
+
+std::string readFile(const std::string &filePath)
+{
+  std::ifstream stream(filePath, std::ios_base::in | std::ios_base::binary);
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
+}
+} // namespace
+
+TEST_CASE("Journal batches are read back in order", "[engine][map][savegame]")
+{
+  MapGrid grid(32, 32);
+  fillGrid(grid, 0);
+  SaveGameJournal::Batch first;
+  for (int index : {0, 5, 31, 32, 1023})
+  {
+    first.addNode(grid, index);
+  }
+
+  fillGrid(grid, 1);
+  SaveGameJournal::Batch second;
+  for (int index = 100; index < 400; ++index)
+  {
+    second.addNode(grid, index);
+  }
+
+  SaveGameJournal::create(journalFile, {0x12345678, 32, 32}, {"", "terrain_grass", "road"});
+  SaveGameJournal::append(journalFile, first);
+  SaveGameJournal::append(journalFile, second);
+
+  std::ifstream stream(journalFile, std::ios_base::in | std::ios_base::binary);
+  SaveGameJournal::Reader reader(stream);
+  CHECK(reader.getHeader().baseChecksum == 0x12345678);
+  CHECK(reader.getHeader().columns == 32);
+  CHECK(reader.getHeader().rows == 32);
+  CHECK(reader.getTileIDs() == std::vector<std::string>{"", "terrain_grass", "road"});
+
+  SaveGameJournal::Batch batch;
+  REQUIRE(reader.readBatch(batch));
+  CHECK(isEqual(batch, first));
+  REQUIRE(reader.readBatch(batch));
+  CHECK(isEqual(batch, second));
+  CHECK_FALSE(reader.readBatch(batch));
+
+  stream.close();
+  std::remove(journalFile.c_str());
+}
+
+TEST_CASE("Partially written journal batches are detected", "[engine][map][savegame]")
+{
+  MapGrid grid(16, 16);
+  fillGrid(grid, 0);
+  SaveGameJournal::Batch batch;
+  for (int index = 0; index < grid.nodeCount(); ++index)
+  {
+    batch.addNode(grid, index);
+  }
+
+  SaveGameJournal::create(journalFile, {0, 16, 16}, {""});
+  SaveGameJournal::append(journalFile, batch);
+  const size_t intactSize = readFile(journalFile).size();
+  SaveGameJournal::append(journalFile, batch);
+
+  // cut the second batch off in the middle, like a crash while it's appended
+  const std::string journal = readFile(journalFile);
+  std::istringstream stream(journal.substr(0, intactSize + (journal.size() - intactSize) / 2),
+                            std::ios_base::in | std::ios_base::binary);
+  SaveGameJournal::Reader reader(stream);
+
+  SaveGameJournal::Batch readBatch;
+  REQUIRE(reader.readBatch(readBatch));
+  CHECK(isEqual(readBatch, batch));
+  CHECK_THROWS_AS(reader.readBatch(readBatch), ConfigurationError);
+
+  std::remove(journalFile.c_str());
+}
+
+TEST_CASE("File checksums change with the contents of the file", "[engine][map][savegame]")
+{
+  const std::string fileName = "SaveGameJournalChecksumTest.cts";
+  {
+    std::ofstream stream(fileName, std::ios_base::out | std::ios_base::binary);
+    stream << "123456789";
+  }
+  // the CRC-32 check value
+  CHECK(SaveGameJournal::fileChecksum(fileName) == 0xCBF43926);
+
+  {
+    std::ofstream stream(fileName, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+    stream << "0";
+  }
+  CHECK(SaveGameJournal::fileChecksum(fileName) != 0xCBF43926);
+
+  std::remove(fileName.c_str());
+  CHECK_THROWS_AS(SaveGameJournal::fileChecksum(fileName), ConfigurationError);
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../../src/engine/map/SaveGameLoader.hxx"
+#include "Exception.hxx"
+
+namespace
+{
+const std::string saveGameFile = "SaveGameLoaderTest.cts";
+
+/// A chunk with a different height for every node
+BinarySaveGame::Chunk makeChunk(int firstNode, int nodeCount)
+{
+  BinarySaveGame::Chunk chunk;
+  chunk.firstNode = firstNode;
+  chunk.resize(nodeCount);
+  for (int i = 0; i < nodeCount; ++i)
+  {
+    chunk.heights[i] = static_cast<uint8_t>((firstNode + i) % 32);
+    for (auto layer = 0U; layer < LAYERS_COUNT; ++layer)
+    {
+      chunk.origCornerIndices[layer][i] = -1;
+    }
+  }
+  return chunk;
+}
+
+void writeSaveGame(const std::vector<BinarySaveGame::Chunk> &chunks)
+{
+  std::ofstream stream(saveGameFile, std::ios_base::out | std::ios_base::binary);
+  BinarySaveGame::Header header;
+  header.saveGameVersion = 4;
+  header.columns = 100;
+  header.rows = 100;
+  header.chunkCount = static_cast<uint32_t>(chunks.size());
+
+  BinarySaveGame::Writer writer(stream, header, {""});
+  for (const BinarySaveGame::Chunk &chunk : chunks)
+  {
+    writer.writeChunk(chunk);
+  }
+}
+} // namespace
+
+TEST_CASE("The savegame loader decodes every chunk once", "[engine][map][savegame]")
+{
+  writeSaveGame({makeChunk(0, 4096), makeChunk(4096, 4096), makeChunk(8192, 1808)});
+
+  {
+    SaveGameLoader loader(saveGameFile);
+    REQUIRE(loader.getChunkCount() == 3);
+    CHECK(loader.getChunkOfNode(0) == 0);
+    CHECK(loader.getChunkOfNode(4095) == 0);
+    CHECK(loader.getChunkOfNode(4096) == 1);
+    CHECK(loader.getChunkOfNode(9999) == 2);
+
+    std::vector<int> heights(10000, -1);
+    std::vector<int> decodeCounts(3, 0);
+    loader.start({2, 1, 0},
+                 [&heights, &decodeCounts](const BinarySaveGame::Chunk &chunk)
+                 {
+                   // every chunk has its own counter and nodes, so the workers don't race
+                   ++decodeCounts[static_cast<size_t>(chunk.firstNode / 4096)];
+                   for (int i = 0; i < chunk.nodeCount; ++i)
+                   {
+                     heights[chunk.firstNode + i] = chunk.heights[i];
+                   }
+                 });
+
+    // the nearest chunk is waited for first, like the game does for the chunks on the screen
+    for (size_t chunkNumber : {1U, 0U, 2U, 1U})
+    {
+      loader.waitForChunk(chunkNumber);
+    }
+
+    CHECK(decodeCounts == std::vector<int>{1, 1, 1});
+    for (int index = 0; index < 10000; ++index)
+    {
+      REQUIRE(heights[index] == index % 32);
+    }
+  }
+
+  std::remove(saveGameFile.c_str());
+}
+
+TEST_CASE("Savegames that don't cover the whole map aren't loaded", "[engine][map][savegame]")
+{
+  writeSaveGame({makeChunk(0, 8192)});
+  CHECK_THROWS_AS(SaveGameLoader(saveGameFile), ConfigurationError);
+  std::remove(saveGameFile.c_str());
+}
+
+TEST_CASE("Savegames with a damaged chunk aren't loaded", "[engine][map][savegame]")
+{
+  writeSaveGame({makeChunk(0, 8192), makeChunk(8192, 1808)});
+  {
+    // flip a byte of the compressed data of the last chunk, like a savegame damaged on disk
+    std::fstream stream(saveGameFile, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    stream.seekg(-1, std::ios_base::end);
+    const char lastByte = static_cast<char>(stream.get());
+    stream.seekp(-1, std::ios_base::end);
+    stream.put(static_cast<char>(lastByte ^ 0x5a));
+  }
+
+  CHECK_THROWS_AS(SaveGameLoader(saveGameFile), ConfigurationError);
+  std::remove(saveGameFile.c_str());
+}
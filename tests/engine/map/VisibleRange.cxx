@@ -0,0 +1,116 @@
+#include <catch.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../../src/engine/map/VisibleRange.hxx"
+
+using NodeList = std::vector<std::pair<int, int>>;
+
+/// The full grid scan that was used by Map::calculateVisibleMap before, used as a reference
+static NodeList fullScan(int columns, int rows, const ScreenDiamond &bounds)
+{
+  NodeList nodes;
+  for (int y = columns - 1; y >= 0; y--)
+  {
+    for (int x = 0; x < rows; x++)
+    {
+      const int xVal = x + y;
+      const int yVal = y - x;
+
+      if ((xVal >= bounds.left) && (xVal <= bounds.right) && (yVal <= bounds.top) && (yVal >= bounds.bottom))
+      {
+        nodes.emplace_back(x, y);
+      }
+    }
+  }
+  return nodes;
+}
+
+static NodeList directRange(int columns, int rows, const ScreenDiamond &bounds)
+{
+  NodeList nodes;
+  VisibleRange::forEachNode(columns, rows, bounds, [&nodes](int x, int y) { nodes.emplace_back(x, y); });
+  return nodes;
+}
+
+/// Screen bounds of a 1920x1080 screen with 32 pixel wide tiles, centered on the map
+static ScreenDiamond centeredScreen(int mapSize)
+{
+  constexpr int maxHeight = 32;
+  const int center = mapSize - 1;
+  return {center - 60, center + 60, 67, -68 - maxHeight};
+}
+
+TEST_CASE("Visible range matches the full grid scan", "[engine][map]")
+{
+  const int mapSize = 64;
+
+  SECTION("Screen within the map")
+  {
+    CHECK(directRange(mapSize, mapSize, {40, 80, 10, -20}) == fullScan(mapSize, mapSize, {40, 80, 10, -20}));
+  }
+
+  SECTION("Screen larger than the map")
+  {
+    CHECK(directRange(mapSize, mapSize, {-500, 500, 500, -500}) == fullScan(mapSize, mapSize, {-500, 500, 500, -500}));
+  }
+
+  SECTION("Screen partially outside of the map")
+  {
+    for (int offset = -80; offset <= 200; offset += 7)
+    {
+      const ScreenDiamond bounds{offset - 21, offset + 20, offset / 3 + 15, offset / 3 - 48};
+      CHECK(directRange(mapSize, mapSize, bounds) == fullScan(mapSize, mapSize, bounds));
+    }
+  }
+
+  SECTION("Screen completely outside of the map")
+  {
+    CHECK(directRange(mapSize, mapSize, {200, 260, 10, -10}).empty());
+    CHECK(directRange(mapSize, mapSize, {-60, -2, 10, -10}).empty());
+    CHECK(directRange(mapSize, mapSize, {40, 80, -70, -100}).empty());
+  }
+
+  SECTION("Non-square map")
+  {
+    CHECK(directRange(32, 96, {10, 90, 20, -60}) == fullScan(32, 96, {10, 90, 20, -60}));
+    CHECK(directRange(96, 32, {10, 90, 20, -60}) == fullScan(96, 32, {10, 90, 20, -60}));
+  }
+}
+
+TEST_CASE("Benchmark visible range calculation", "[engine][map][.benchmark]")
+{
+  for (const int mapSize : {128, 512, 2048})
+  {
+    const ScreenDiamond bounds = centeredScreen(mapSize);
+    int visibleNodes = 0;
+    const auto countNode = [&visibleNodes](int, int) { ++visibleNodes; };
+
+    BENCHMARK("full scan, map size " + std::to_string(mapSize))
+    {
+      visibleNodes = 0;
+      for (int y = mapSize - 1; y >= 0; y--)
+      {
+        for (int x = 0; x < mapSize; x++)
+        {
+          const int xVal = x + y;
+          const int yVal = y - x;
+
+          if ((xVal >= bounds.left) && (xVal <= bounds.right) && (yVal <= bounds.top) && (yVal >= bounds.bottom))
+          {
+            countNode(x, y);
+          }
+        }
+      }
+      return visibleNodes;
+    };
+
+    BENCHMARK("direct range, map size " + std::to_string(mapSize))
+    {
+      visibleNodes = 0;
+      VisibleRange::forEachNode(mapSize, mapSize, bounds, countNode);
+      return visibleNodes;
+    };
+  }
+}
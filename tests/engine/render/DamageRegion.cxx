@@ -0,0 +1,53 @@
+#include <catch.hpp>
+
+#include "../../../src/engine/render/DamageRegion.hxx"
+
+TEST_CASE("Overlapping damaged rects are merged", "[engine][render][damage]")
+{
+  DamageRegion damage;
+  CHECK(damage.isEmpty());
+
+  damage.add({0, 0, 10, 10});
+  damage.add({100, 100, 10, 10});
+  damage.add({0, 0, 0, 10});
+  REQUIRE(damage.getRects().size() == 2);
+
+  // bridges both rects, so all three become one
+  damage.add({5, 5, 100, 100});
+  REQUIRE(damage.getRects().size() == 1);
+  const SDL_Rect &rect = damage.getRects().front();
+  CHECK(rect.x == 0);
+  CHECK(rect.y == 0);
+  CHECK(rect.w == 110);
+  CHECK(rect.h == 110);
+
+  damage.clear();
+  CHECK(damage.isEmpty());
+}
+
+TEST_CASE("Too many damaged rects are merged into their bounding box", "[engine][render][damage]")
+{
+  DamageRegion damage;
+  for (int i = 0; i <= static_cast<int>(DamageRegion::maxRects); ++i)
+  {
+    damage.add({i * 20, 0, 10, 10});
+  }
+
+  REQUIRE(damage.getRects().size() == 1);
+  CHECK(damage.getRects().front().w == static_cast<int>(DamageRegion::maxRects) * 20 + 10);
+}
+
+TEST_CASE("A fully damaged region ignores further rects", "[engine][render][damage]")
+{
+  DamageRegion damage;
+  damage.add({0, 0, 10, 10});
+
+  DamageRegion full;
+  full.invalidate();
+  damage.add(full);
+  damage.add({20, 20, 10, 10});
+
+  CHECK(damage.isFull());
+  CHECK_FALSE(damage.isEmpty());
+  CHECK(damage.getRects().empty());
+}
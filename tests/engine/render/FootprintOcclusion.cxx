@@ -0,0 +1,58 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "../../../src/engine/render/FootprintOcclusion.hxx"
+
+using namespace FootprintOcclusion;
+
+TEST_CASE("Opaque buildings cover the nodes behind their front", "[engine][render]")
+{
+  // a 2x2 building, two tiles wide
+  const int width = 64;
+  const int height = 48;
+  const SDL_Rect frame{0, 0, width, height};
+  const HitMask opaqueMask(width, height, std::vector<uint8_t>(width * height, SDL_ALPHA_OPAQUE));
+
+  const Coverage coverage = computeCoverage(opaqueMask, frame, 2, 2);
+
+  // the margin around the nodes at the bottom edge reaches out of the frame
+  CHECK_FALSE(coverage.test(coverageBit(0, 0)));
+  CHECK_FALSE(coverage.test(coverageBit(1, 0)));
+  CHECK_FALSE(coverage.test(coverageBit(0, 1)));
+  CHECK(coverage.test(coverageBit(1, 1)));
+}
+
+TEST_CASE("Transparent pixels uncover a node", "[engine][render]")
+{
+  const int width = 64;
+  const int height = 48;
+  std::vector<uint8_t> alpha(width * height, SDL_ALPHA_OPAQUE);
+  // a window in the middle of node (1, 1)
+  alpha[24 * width + 32] = SDL_ALPHA_TRANSPARENT;
+  const HitMask opaqueMask(width, height, alpha);
+
+  const Coverage coverage = computeCoverage(opaqueMask, {0, 0, width, height}, 2, 2);
+
+  CHECK(coverage.none());
+}
+
+TEST_CASE("Node rects are placed relative to the building's bottom center", "[engine][render]")
+{
+  const SDL_Rect buildingRect{100, 200, 64, 48};
+  const int bottomCenterX = buildingRect.x + buildingRect.w / 2;
+  const int bottomY = buildingRect.y + buildingRect.h;
+
+  const SDL_Rect rect = nodeRect(buildingRect, 1, 1, 1.0);
+  CHECK(rect.x == bottomCenterX - 16);
+  CHECK(rect.y == bottomY - 32);
+  CHECK(rect.w == 32);
+  CHECK(rect.h == 16);
+
+  const SDL_Rect zoomedRect = nodeRect({100, 200, 128, 96}, 1, 1, 2.0);
+  CHECK(zoomedRect.w == 64);
+  CHECK(zoomedRect.h == 32);
+
+  CHECK(isInsideNodeRect({rect.x - 1, rect.y, 33, 17}, rect));
+  CHECK_FALSE(isInsideNodeRect({rect.x, rect.y - 10, 32, 26}, rect));
+}
@@ -0,0 +1,66 @@
+#include <catch.hpp>
+#include <thread>
+
+#include "../../../src/engine/render/FrameScheduler.hxx"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Frames start at the interval of the target FPS", "[engine][render]")
+{
+  FrameScheduler scheduler;
+  scheduler.setTargetFPS(100);
+  CHECK(scheduler.getFrameBudget() == Approx(10.0));
+
+  const auto start = FrameScheduler::Clock::now();
+  for (int i = 0; i < 10; ++i)
+  {
+    scheduler.beginFrame();
+    scheduler.endFrame(true);
+  }
+  const auto elapsed = FrameScheduler::Clock::now() - start;
+
+  CHECK(elapsed >= 95ms);
+  CHECK(elapsed < 200ms);
+  CHECK(scheduler.getRenderedFrames() == 10);
+  CHECK(scheduler.getSkippedFrames() == 0);
+  CHECK(scheduler.getFrameTimes().size() == 10);
+}
+
+TEST_CASE("Skipped frames are counted and paced without a target FPS", "[engine][render]")
+{
+  FrameScheduler scheduler;
+  scheduler.setTargetFPS(0);
+  CHECK(scheduler.getFrameBudget() == 0);
+
+  const auto start = FrameScheduler::Clock::now();
+  for (int i = 0; i < 5; ++i)
+  {
+    scheduler.beginFrame();
+    scheduler.endFrame(false);
+  }
+
+  CHECK(FrameScheduler::Clock::now() - start >= 5 * FrameScheduler::idleFrameInterval);
+  CHECK(scheduler.getSkippedFrames() == 5);
+  CHECK(scheduler.getRenderedFrames() == 0);
+  // skipped frames don't take part in the frame time statistics
+  CHECK(scheduler.getFrameTimes().size() == 0);
+
+  scheduler.resetFrameCounts();
+  CHECK(scheduler.getSkippedFrames() == 0);
+}
+
+TEST_CASE("Frames that take longer than the budget are counted", "[engine][render]")
+{
+  FrameScheduler scheduler;
+  scheduler.setTargetFPS(200);
+
+  scheduler.beginFrame();
+  std::this_thread::sleep_for(20ms);
+  scheduler.endFrame(true);
+
+  scheduler.beginFrame();
+  scheduler.endFrame(true);
+
+  CHECK(scheduler.getOverBudgetFrames() == 1);
+  CHECK(scheduler.getFrameTimes().percentile(100) >= 20);
+}
@@ -0,0 +1,39 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "../../../src/engine/render/HitMask.hxx"
+
+TEST_CASE("Hit masks match the alpha channel", "[engine][render][hitmask]")
+{
+  // wider than a word, so rows span several words
+  const int width = 100;
+  const int height = 7;
+  std::vector<uint8_t> alpha(width * height);
+  for (int i = 0; i < width * height; ++i)
+  {
+    alpha[i] = (i % 3 == 0) ? SDL_ALPHA_TRANSPARENT : static_cast<uint8_t>(i % 256);
+  }
+
+  const HitMask hitMask(width, height, alpha);
+
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      CHECK(hitMask.isOpaque(x, y) == (alpha[y * width + x] != SDL_ALPHA_TRANSPARENT));
+    }
+  }
+}
+
+TEST_CASE("Pixels outside of a hit mask are transparent", "[engine][render][hitmask]")
+{
+  const HitMask hitMask(2, 2, {255, 255, 255, 255});
+
+  CHECK(hitMask.isOpaque(1, 1));
+  CHECK_FALSE(hitMask.isOpaque(-1, 0));
+  CHECK_FALSE(hitMask.isOpaque(0, -1));
+  CHECK_FALSE(hitMask.isOpaque(2, 0));
+  CHECK_FALSE(hitMask.isOpaque(0, 2));
+  CHECK_FALSE(HitMask().isOpaque(0, 0));
+}
@@ -0,0 +1,61 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include "../../../src/engine/render/MapOverview.hxx"
+
+TEST_CASE("Nodes cover the map overview without gaps or overlaps", "[engine][render][mapoverview]")
+{
+  const int columns = 5;
+  const int rows = 3;
+  const int width = columns + rows - 1 + MapOverview::nodeWidth - 1;
+  const int height = columns + rows - 1;
+  std::vector<int> coverage(width * height, 0);
+
+  for (int x = 0; x < rows; ++x)
+  {
+    for (int y = 0; y < columns; ++y)
+    {
+      const SDL_Point pixel = MapOverview::nodePixel(x, y, columns);
+      REQUIRE(pixel.x >= 0);
+      REQUIRE(pixel.x + MapOverview::nodeWidth <= width);
+      REQUIRE(pixel.y >= 0);
+      REQUIRE(pixel.y < height);
+      for (int i = 0; i < MapOverview::nodeWidth; ++i)
+      {
+        coverage[pixel.y * width + pixel.x + i]++;
+      }
+    }
+  }
+
+  for (int count : coverage)
+  {
+    CHECK(count <= 1);
+  }
+  // the nodes on the diagonal x == y form a row without gaps
+  const int centerRow = columns - 1;
+  for (int x = 0; x < rows * MapOverview::nodeWidth; ++x)
+  {
+    CHECK(coverage[centerRow * width + x] == 1);
+  }
+}
+
+TEST_CASE("The overview color of a spritesheet ignores transparent pixels", "[engine][render][mapoverview]")
+{
+  SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, 4, 1, 32, SDL_PIXELFORMAT_RGBA32);
+  REQUIRE(surface);
+  Uint8 *pixels = static_cast<Uint8 *>(surface->pixels);
+  const Uint8 data[] = {200, 100, 0, 255, 100, 50, 0, 255, 255, 255, 255, 0, 0, 0, 0, 0};
+  std::copy(std::begin(data), std::end(data), pixels);
+
+  const SDL_Color color = MapOverview::averageColor(surface);
+  CHECK(color.r == 150);
+  CHECK(color.g == 75);
+  CHECK(color.b == 0);
+  CHECK(color.a == SDL_ALPHA_OPAQUE);
+
+  std::fill(pixels, pixels + sizeof(data), 0);
+  CHECK(MapOverview::averageColor(surface).a == SDL_ALPHA_TRANSPARENT);
+  SDL_FreeSurface(surface);
+}
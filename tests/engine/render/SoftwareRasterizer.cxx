@@ -0,0 +1,158 @@
+#include <catch.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "../../../src/engine/render/RenderSnapshot.hxx"
+#include "../../../src/engine/render/SoftwareRasterizer.hxx"
+
+namespace
+{
+std::vector<SDL_Vertex> quadVertices(SDL_FRect rect, SDL_FRect texCoords, SDL_Color color)
+{
+  return {{{rect.x, rect.y}, color, {texCoords.x, texCoords.y}},
+          {{rect.x + rect.w, rect.y}, color, {texCoords.x + texCoords.w, texCoords.y}},
+          {{rect.x + rect.w, rect.y + rect.h}, color, {texCoords.x + texCoords.w, texCoords.y + texCoords.h}},
+          {{rect.x, rect.y + rect.h}, color, {texCoords.x, texCoords.y + texCoords.h}}};
+}
+} // namespace
+
+TEST_CASE("SIMD and scalar blending give the same pixels", "[engine][render][rasterizer]")
+{
+  std::vector<uint32_t> texels(97);
+  uint32_t random = 12345;
+  for (uint32_t &texel : texels)
+  {
+    random = random * 1103515245 + 12345;
+    texel = random;
+  }
+  // fully transparent and fully opaque runs take shortcuts
+  std::fill(texels.begin() + 8, texels.begin() + 16, 0x00FFFFFF);
+  std::fill(texels.begin() + 16, texels.begin() + 24, 0xFF336699);
+
+  for (const SDL_Color color : {SDL_Color{255, 255, 255, 255}, SDL_Color{200, 100, 50, 128}, SDL_Color{0, 0, 0, 0}})
+  {
+    for (const uint32_t step : {0x10000U, 0x8000U, 0x18000U})
+    {
+      const int count = static_cast<int>((static_cast<uint64_t>(texels.size() - 1) << 16) / step);
+      std::vector<uint32_t> simd(count, 0xFF808080);
+      std::vector<uint32_t> scalar = simd;
+
+      SoftwareRasterizer::blendSpan(simd.data(), texels.data(), 0, step, count, color);
+      SoftwareRasterizer::blendSpanScalar(scalar.data(), texels.data(), 0, step, count, color);
+      CHECK(simd == scalar);
+    }
+  }
+}
+
+TEST_CASE("Texels are blended with their alpha", "[engine][render][rasterizer]")
+{
+  const uint32_t texels[] = {0xFFFF0000, 0x00FF0000, 0x80FFFFFF, 0xFF00FF00};
+  uint32_t pixels[] = {0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000};
+
+  SoftwareRasterizer::blendSpan(pixels, texels, 0, 0x10000, 4, {255, 255, 255, 255});
+  CHECK(pixels[0] == 0xFFFF0000);
+  CHECK(pixels[1] == 0xFF000000);
+  CHECK(pixels[2] == 0xFF808080);
+  CHECK(pixels[3] == 0xFF00FF00);
+
+  // color modulation darkens the texels, alpha modulation makes them transparent
+  uint32_t modulated[] = {0xFF000000, 0xFF000000};
+  SoftwareRasterizer::blendSpan(modulated, texels, 0, 0x30000, 2, {255, 128, 255, 255});
+  CHECK(modulated[0] == 0xFFFF0000);
+  CHECK(modulated[1] == 0xFF008000);
+  SoftwareRasterizer::blendSpan(modulated, texels + 3, 0, 0x10000, 1, {255, 255, 255, 0});
+  CHECK(modulated[0] == 0xFFFF0000);
+}
+
+TEST_CASE("Quads are scaled with the nearest texel", "[engine][render][rasterizer]")
+{
+  // the left 2x2 texels are the quad's source, the right column belongs to another spritesheet
+  const uint32_t texels[] = {0xFF000001, 0xFF000002, 0xFFFFFFFF, 0xFF000003, 0xFF000004, 0xFFFFFFFF};
+  const RasterTexture texture{texels, 3, 2, 3};
+
+  const int frameWidth = 6;
+  const int frameHeight = 5;
+  std::vector<uint32_t> frame(frameWidth * frameHeight, 0xFF000000);
+
+  // 2x2 texels drawn to 4x4 pixels, starting one pixel outside of the frame
+  const std::vector<SDL_Vertex> quad = quadVertices({-1, 1, 4, 4}, {0, 0, 2.0f / 3.0f, 1}, {255, 255, 255, 255});
+  SoftwareRasterizer::drawQuad(frame.data(), frameWidth, {0, 0, frameWidth, frameHeight}, texture, quad.data());
+
+  const std::vector<uint32_t> expected{
+      0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, 0xFF000000, //
+      0xFF000001, 0xFF000002, 0xFF000002, 0xFF000000, 0xFF000000, 0xFF000000, //
+      0xFF000001, 0xFF000002, 0xFF000002, 0xFF000000, 0xFF000000, 0xFF000000, //
+      0xFF000003, 0xFF000004, 0xFF000004, 0xFF000000, 0xFF000000, 0xFF000000, //
+      0xFF000003, 0xFF000004, 0xFF000004, 0xFF000000, 0xFF000000, 0xFF000000, //
+  };
+  CHECK(frame == expected);
+
+  // redrawing a damaged rect only touches the pixels within it
+  std::vector<uint32_t> clipped(frameWidth * frameHeight, 0xFF000000);
+  SoftwareRasterizer::drawQuad(clipped.data(), frameWidth, {1, 2, 2, 2}, texture, quad.data());
+  for (int y = 0; y < frameHeight; ++y)
+  {
+    for (int x = 0; x < frameWidth; ++x)
+    {
+      const bool isInside = x >= 1 && x < 3 && y >= 2 && y < 4;
+      CHECK(clipped[y * frameWidth + x] == (isInside ? expected[y * frameWidth + x] : 0xFF000000));
+    }
+  }
+}
+
+TEST_CASE("Benchmark software rasterizer against SDL's software renderer", "[engine][render][rasterizer][.benchmark]")
+{
+  const int width = 1280;
+  const int height = 720;
+  SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+  SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(target);
+  REQUIRE(renderer);
+
+  // a page with half transparent sprites, like the tiles of the texture atlas
+  const int pageSize = 256;
+  SDL_Surface *page = SDL_CreateRGBSurfaceWithFormat(0, pageSize, pageSize, 32, SDL_PIXELFORMAT_ARGB8888);
+  uint32_t *pixels = static_cast<uint32_t *>(page->pixels);
+  for (int i = 0; i < pageSize * pageSize; ++i)
+  {
+    pixels[i] = (i % 3 == 0) ? 0x00000000 : 0xFF000000 | static_cast<uint32_t>(i * 2654435761U >> 8);
+  }
+  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, page);
+  SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+  // the same scene for both: 5000 tiles of 32x32 texels, drawn at zoom level 1.5 with highlighting
+  RenderSnapshot snapshot;
+  for (int i = 0; i < 5000; ++i)
+  {
+    const float tileX = static_cast<float>((i % 8) * 32) / pageSize;
+    const float tileY = static_cast<float>((i / 8 % 8) * 32) / pageSize;
+    const SDL_Color color = (i % 10 == 0) ? SDL_Color{255, 128, 128, 255} : SDL_Color{255, 255, 255, 255};
+    const std::vector<SDL_Vertex> quad = quadVertices(
+        {static_cast<float>(i * 37 % width) - 24, static_cast<float>(i * 53 % height) - 24, 48, 48},
+        {tileX, tileY, 32.0f / pageSize, 32.0f / pageSize}, color);
+    snapshot.addBatch(texture, quad.data(), quad.size());
+  }
+
+  SoftwareRasterizer rasterizer;
+  rasterizer.addTexture(texture, page);
+
+  BENCHMARK("SDL software renderer")
+  {
+    SDL_RenderClear(renderer);
+    snapshot.submit(renderer);
+    SDL_RenderPresent(renderer);
+  };
+
+  BENCHMARK("software rasterizer")
+  {
+    SDL_RenderClear(renderer);
+    rasterizer.submit(renderer, snapshot);
+    SDL_RenderPresent(renderer);
+  };
+
+  CHECK(rasterizer.getRasterizedBatches() == snapshot.getBatchCount());
+
+  SDL_DestroyTexture(texture);
+  SDL_FreeSurface(page);
+  SDL_DestroyRenderer(renderer);
+  SDL_FreeSurface(target);
+}
@@ -0,0 +1,38 @@
+#include <catch.hpp>
+#include <cmath>
+
+#include "../../../src/engine/render/SpriteGeometry.hxx"
+
+TEST_CASE("Sprite geometries are scaled like sprites", "[engine][render][spritegeometry]")
+{
+  SpriteGeometryTable table;
+  const SpriteGeometryTable::GeometryId terrain = table.add(32, 19, 100);
+  const SpriteGeometryTable::GeometryId building = table.add(65, 131, 131);
+
+  CHECK(table.get(terrain).clipY == 81);
+  CHECK(table.get(building).clipY == 0);
+
+  for (double zoomLevel : {0.25, 0.5, 1.0, 1.5, 2.0, 3.7})
+  {
+    table.setZoomLevel(zoomLevel);
+    CHECK(table.getZoomLevel() == zoomLevel);
+    CHECK(table.get(terrain).width == static_cast<int>(std::round(32 * zoomLevel)));
+    CHECK(table.get(terrain).height == static_cast<int>(std::round(19 * zoomLevel)));
+    CHECK(table.get(building).width == static_cast<int>(std::round(65 * zoomLevel)));
+    CHECK(table.get(building).height == static_cast<int>(std::round(131 * zoomLevel)));
+  }
+}
+
+TEST_CASE("Geometries that are added later are scaled with the next zoom level", "[engine][render][spritegeometry]")
+{
+  SpriteGeometryTable table;
+  table.add(32, 19, 19);
+  table.setZoomLevel(2.0);
+
+  const SpriteGeometryTable::GeometryId added = table.add(10, 10, 10);
+  CHECK(table.getZoomLevel() != 2.0);
+
+  table.setZoomLevel(2.0);
+  CHECK(table.get(added).width == 20);
+  CHECK(table.get(added).height == 20);
+}
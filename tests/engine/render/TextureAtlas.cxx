@@ -0,0 +1,47 @@
+#include <catch.hpp>
+#include <vector>
+
+#include "../../../src/engine/render/TextureAtlas.hxx"
+
+TEST_CASE("Packed atlas regions stay on their page and don't overlap", "[engine][render][atlas]")
+{
+  const int pageSize = 256;
+  std::vector<SDL_Point> sizes;
+  for (int i = 0; i < 60; ++i)
+  {
+    sizes.push_back({16 + (i * 37) % 90, 8 + (i * 53) % 70});
+  }
+
+  const std::vector<AtlasRegion> regions = TextureAtlas::pack(sizes, pageSize);
+  REQUIRE(regions.size() == sizes.size());
+
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    const AtlasRegion &region = regions[i];
+    REQUIRE(region.isValid());
+    CHECK(region.rect.w == sizes[i].x);
+    CHECK(region.rect.h == sizes[i].y);
+    CHECK(region.rect.x >= 0);
+    CHECK(region.rect.y >= 0);
+    CHECK(region.rect.x + region.rect.w <= pageSize);
+    CHECK(region.rect.y + region.rect.h <= pageSize);
+
+    for (size_t j = i + 1; j < regions.size(); ++j)
+    {
+      if (regions[j].page == region.page)
+      {
+        CHECK_FALSE(SDL_HasIntersection(&region.rect, &regions[j].rect));
+      }
+    }
+  }
+}
+
+TEST_CASE("Rectangles that are too big for a page are not packed", "[engine][render][atlas]")
+{
+  const std::vector<AtlasRegion> regions = TextureAtlas::pack({{64, 64}, {300, 10}, {10, 300}, {0, 10}}, 256);
+
+  CHECK(regions[0].isValid());
+  CHECK_FALSE(regions[1].isValid());
+  CHECK_FALSE(regions[2].isValid());
+  CHECK_FALSE(regions[3].isValid());
+}
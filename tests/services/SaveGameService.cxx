@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../src/services/SaveGameService.hxx"
+#include "../../src/engine/map/BinarySaveGame.hxx"
+
+namespace
+{
+std::vector<uint8_t> readHeights(const std::string &filePath)
+{
+  std::ifstream stream(filePath, std::ios_base::in | std::ios_base::binary);
+  BinarySaveGame::Reader reader(stream);
+  const BinarySaveGame::Header &header = reader.getHeader();
+
+  std::vector<uint8_t> heights;
+  BinarySaveGame::Chunk chunk;
+  for (uint32_t i = 0; i < header.chunkCount; ++i)
+  {
+    reader.readChunk(chunk);
+    heights.insert(heights.end(), chunk.heights.begin(), chunk.heights.end());
+  }
+  return heights;
+}
+
+bool fileExists(const std::string &filePath) { return std::ifstream(filePath).good(); }
+} // namespace
+
+TEST_CASE("Savegames are written from a snapshot on the worker thread", "[engine][savegame]")
+{
+  const std::string filePath = "SaveGameServiceTest.cts";
+  const std::vector<std::string> tileIDs{"", "terrain_grass"};
+
+  MapGrid grid(64, 64);
+  for (int index = 0; index < grid.nodeCount(); ++index)
+  {
+    grid.height(index) = static_cast<uint8_t>(index % 32);
+    grid.tileId(Layer::TERRAIN, index) = 1;
+  }
+  const std::vector<uint8_t> savedHeights = grid.heights();
+
+  SaveGameService service;
+  int completionCount = 0;
+  std::string completionError = "not called";
+  service.save(SaveGameSnapshot(grid, tileIDs), filePath, SaveGameFormat::BINARY,
+               [&](const std::string &error)
+               {
+                 ++completionCount;
+                 completionError = error;
+               });
+
+  // changes after the snapshot has been taken don't end up in the savegame
+  for (int index = 0; index < grid.nodeCount(); ++index)
+  {
+    grid.height(index) = 0;
+  }
+
+  service.waitForSaves();
+  CHECK_FALSE(service.isSaving());
+  CHECK(completionCount == 0);
+
+  service.dispatchCompletions();
+  CHECK(completionCount == 1);
+  CHECK(completionError.empty());
+
+  CHECK(readHeights(filePath) == savedHeights);
+  CHECK_FALSE(fileExists(filePath + ".tmp"));
+
+  std::remove(filePath.c_str());
+}
+
+TEST_CASE("Failed savegames report the error to their callback", "[engine][savegame]")
+{
+  MapGrid grid(8, 8);
+  SaveGameService service;
+  std::string completionError;
+  service.save(SaveGameSnapshot(grid, {""}), "missing_directory/SaveGameServiceTest.cts", SaveGameFormat::BINARY,
+               [&](const std::string &error) { completionError = error; });
+
+  service.waitForSaves();
+  service.dispatchCompletions();
+  CHECK_FALSE(completionError.empty());
+}
@@ -0,0 +1,49 @@
+#include "AllocationCounter.hxx"
+
+#include <cstdlib>
+#include <new>
+
+// the global allocation functions are replaced for the whole test executable, they only count while a counter is active
+namespace
+{
+thread_local bool isCounting = false;
+thread_local std::size_t allocationCount = 0;
+} // namespace
+
+void *operator new(std::size_t size)
+{
+  if (isCounting)
+  {
+    ++allocationCount;
+  }
+
+  if (void *pMemory = std::malloc(size ? size : 1))
+  {
+    return pMemory;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *pMemory) noexcept { std::free(pMemory); }
+
+void operator delete[](void *pMemory) noexcept { std::free(pMemory); }
+
+void operator delete(void *pMemory, std::size_t) noexcept { std::free(pMemory); }
+
+void operator delete[](void *pMemory, std::size_t) noexcept { std::free(pMemory); }
+
+AllocationCounter::AllocationCounter()
+{
+  allocationCount = 0;
+  isCounting = true;
+}
+
+AllocationCounter::~AllocationCounter() { isCounting = false; }
+
+std::size_t AllocationCounter::stop()
+{
+  isCounting = false;
+  return allocationCount;
+}
@@ -0,0 +1,27 @@
+#ifndef ALLOCATION_COUNTER_HXX_
+#define ALLOCATION_COUNTER_HXX_
+
+#include <cstddef>
+
+/**
+  * @brief Counts the heap allocations of the current thread.
+  * Counting starts when the counter is created and ends with stop() or when it is destroyed.
+  * Counters can't be nested.
+  */
+class AllocationCounter
+{
+public:
+  AllocationCounter();
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter &operator=(const AllocationCounter &) = delete;
+
+  /**
+    * @brief Stop counting, so the test assertions themselves are not counted.
+    * @return Number of allocations since the counter has been created.
+    */
+  std::size_t stop();
+};
+
+#endif
@@ -0,0 +1,36 @@
+#include <catch.hpp>
+
+#include "../../src/util/FrameTimeStats.hxx"
+
+TEST_CASE("Frame time percentiles use the nearest rank", "[util]")
+{
+  FrameTimeStats stats;
+  CHECK(stats.percentile(50) == 0);
+
+  for (int i = 100; i >= 1; --i)
+  {
+    stats.add(i);
+  }
+
+  CHECK(stats.size() == 100);
+  CHECK(stats.percentile(50) == 50);
+  CHECK(stats.percentile(99) == 99);
+  CHECK(stats.percentile(100) == 100);
+  CHECK(stats.percentile(0) == 1);
+}
+
+TEST_CASE("Frame time percentiles only use the most recent frames", "[util]")
+{
+  FrameTimeStats stats;
+  for (size_t i = 0; i < FrameTimeStats::sampleCount; ++i)
+  {
+    stats.add(1000);
+  }
+  for (size_t i = 0; i < FrameTimeStats::sampleCount; ++i)
+  {
+    stats.add(1);
+  }
+
+  CHECK(stats.size() == FrameTimeStats::sampleCount);
+  CHECK(stats.percentile(100) == 1);
+}
@@ -0,0 +1,30 @@
+#include <catch.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../../src/util/MappedFile.hxx"
+#include "Exception.hxx"
+
+TEST_CASE("Mapped files have the contents of the file", "[util]")
+{
+  const std::string fileName = "MappedFileTest.bin";
+  std::string contents(100000, '\0');
+  for (size_t i = 0; i < contents.size(); ++i)
+  {
+    contents[i] = static_cast<char>(i % 251);
+  }
+  {
+    std::ofstream stream(fileName, std::ios_base::out | std::ios_base::binary);
+    stream << contents;
+  }
+
+  {
+    MappedFile file(fileName);
+    REQUIRE(file.size() == contents.size());
+    CHECK(std::string(file.data(), file.size()) == contents);
+  }
+
+  std::remove(fileName.c_str());
+  CHECK_THROWS_AS(MappedFile(fileName), ConfigurationError);
+}
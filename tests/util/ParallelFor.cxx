@@ -0,0 +1,38 @@
+#include <catch.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "../../src/util/ParallelFor.hxx"
+
+TEST_CASE("parallelFor processes every index once", "[util]")
+{
+  for (size_t count : {0, 1, 1000, 100000})
+  {
+    std::vector<int> calls(count, 0);
+    parallelFor(0, count, [&calls](size_t index) { ++calls[index]; });
+    CHECK(std::count(calls.begin(), calls.end(), 1) == static_cast<long>(count));
+  }
+}
+
+TEST_CASE("parallelFor splits small ranges of expensive indices", "[util]")
+{
+  std::vector<int> calls(16, 0);
+  parallelFor(0, calls.size(), [&calls](size_t index) { ++calls[index]; }, 1);
+  CHECK(std::count(calls.begin(), calls.end(), 1) == static_cast<long>(calls.size()));
+}
+
+TEST_CASE("parallelFor rethrows exceptions", "[util]")
+{
+  std::vector<int> calls(100000, 0);
+  CHECK_THROWS_AS(parallelFor(0, calls.size(),
+                              [&calls](size_t index)
+                              {
+                                if (index == calls.size() - 1)
+                                {
+                                  throw std::runtime_error("last index");
+                                }
+                                ++calls[index];
+                              }),
+                  std::runtime_error);
+}
@@ -0,0 +1,38 @@
+#include "PeakMemory.hxx"
+
+#include <fstream>
+#include <string>
+
+// the kernel keeps the peak as VmHWM and resets it to the current resident set size when 5 is written to clear_refs
+namespace
+{
+std::size_t readStatusKilobytes(const std::string &field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line))
+  {
+    if (line.compare(0, field.size(), field) == 0)
+    {
+      return std::stoul(line.substr(field.size() + 1)) * 1024;
+    }
+  }
+  return 0;
+}
+} // namespace
+
+PeakMemory::PeakMemory()
+{
+  std::ofstream clearRefs("/proc/self/clear_refs");
+  clearRefs << "5";
+  clearRefs.close();
+
+  m_isSupported = clearRefs.good();
+  m_baseline = readStatusKilobytes("VmHWM");
+}
+
+std::size_t PeakMemory::growth() const
+{
+  const std::size_t peak = readStatusKilobytes("VmHWM");
+  return peak > m_baseline ? peak - m_baseline : 0;
+}
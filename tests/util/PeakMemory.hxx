@@ -0,0 +1,29 @@
+#ifndef PEAK_MEMORY_HXX_
+#define PEAK_MEMORY_HXX_
+
+#include <cstddef>
+
+/**
+  * @brief Measures the peak resident set size of the process.
+  * The peak is reset when the measurement is created. Only supported on Linux, where the peak can be reset.
+  */
+class PeakMemory
+{
+public:
+  PeakMemory();
+
+  /// Check if the peak can be measured on this system
+  bool isSupported() const { return m_isSupported; };
+
+  /**
+    * @brief Get how much the resident set size grew
+    * @return The peak resident set size since the measurement has been created minus the one at creation, in bytes.
+    */
+  std::size_t growth() const;
+
+private:
+  bool m_isSupported = false;
+  std::size_t m_baseline = 0;
+};
+
+#endif